@@ -5,235 +5,112 @@
 
 calendar::calendar()
 {
- second = 0;
- minute = 0;
- hour = 0;
- day = 0;
- season = SPRING;
- year = 0;
+ turn_number = 0;
+ sun_day = -1;
+ sunlight_minute = -1;
 }
 
 calendar::calendar(const calendar &copy)
 {
- second = copy.second;
- minute = copy.minute;
- hour   = copy.hour;
- day    = copy.day;
- season = copy.season;
- year   = copy.year;
+ turn_number = copy.turn_number;
+ sun_day = -1;
+ sunlight_minute = -1;
 }
 
 calendar::calendar(int Minute, int Hour, int Day, season_type Season, int Year)
 {
- second = 0;
- minute = Minute;
- hour = Hour;
- day = Day;
- season = Season;
- year = Year;
+ turn_number = MINUTES(Minute) + HOURS(Hour) + DAYS(Day) +
+               DAYS(int(Season) * DAYS_IN_SEASON) + DAYS(Year * 4 * DAYS_IN_SEASON);
+ sun_day = -1;
+ sunlight_minute = -1;
 }
 
 calendar::calendar(int turn)
 {
- int minutes = int(turn / 10);
- int hours = minutes / 60;
- int days = hours / 24;
- int seasons = days / DAYS_IN_SEASON;
- second = 6 * (turn % 10);
- minute = minutes % 60;
- hour = hours % 24;
- day = 1 + days % DAYS_IN_SEASON;
- season = season_type(seasons % 4);
- year = seasons / 4;
+ turn_number = turn;
+ sun_day = -1;
+ sunlight_minute = -1;
 }
 
-int calendar::get_turn()
+calendar& calendar::operator =(const calendar &rhs)
 {
- int ret = second / 6;
- ret += minute * 10;
- ret += hour * 600;
- ret += day * 14400;
- ret += int(season) * 14400 * DAYS_IN_SEASON;
- ret += year * 14400 * 4 * DAYS_IN_SEASON;
- return ret;
-}
-
-calendar::operator int() const
-{
- int ret = second / 6;
- ret += minute * 10;
- ret += hour * 600;
- ret += day * 14400;
- ret += int(season) * 14400 * DAYS_IN_SEASON;
- ret += year * 14400 * 4 * DAYS_IN_SEASON;
- return ret;
-}
-
-calendar& calendar::operator =(calendar &rhs)
-{
- if (this == &rhs)
-  return *this;
-
- second = rhs.second;
- minute = rhs.minute;
- hour = rhs.hour;
- day = rhs.day;
- season = rhs.season;
- year = rhs.year;
-
+ turn_number = rhs.turn_number;
  return *this;
 }
 
 calendar& calendar::operator =(int rhs)
 {
- int minutes = int(rhs / 10);
- int hours = minutes / 60;
- int days = hours / 24;
- int seasons = days / DAYS_IN_SEASON;
- second = 6 * (rhs % 10);
- minute = minutes % 60;
- hour = hours % 24;
- day = days % DAYS_IN_SEASON;
- season = season_type(seasons % 4);
- year = seasons / 4;
+ turn_number = rhs;
  return *this;
 }
 
-calendar& calendar::operator -=(calendar &rhs)
+calendar& calendar::operator -=(const calendar &rhs)
 {
- calendar tmp(rhs);
- tmp.standardize();
- second -= tmp.second;
- minute -= tmp.minute;
- hour   -= tmp.hour;
- day    -= tmp.day;
- int tmpseason = int(season) - int(tmp.season);
- while (tmpseason < 0) {
-  year--;
-  tmpseason += 4;
- }
- season = season_type(tmpseason);
- year -= tmp.year;
- standardize();
+ turn_number -= rhs.turn_number;
  return *this;
 }
 
 calendar& calendar::operator -=(int rhs)
 {
- calendar tmp(rhs);
- *this -= tmp;
+ turn_number -= rhs;
  return *this;
 }
 
-calendar& calendar::operator +=(calendar &rhs)
+calendar& calendar::operator +=(const calendar &rhs)
 {
- second += rhs.second;
- minute += rhs.minute;
- hour   += rhs.hour;
- day    += rhs.day;
- int tmpseason = int(season) + int(rhs.season);
- while (tmpseason >= 4) {
-  year++;
-  tmpseason -= 4;
- }
- season = season_type(tmpseason);
- year += rhs.year;
- standardize();
+ turn_number += rhs.turn_number;
  return *this;
 }
 
 calendar& calendar::operator +=(int rhs)
 {
- second += rhs * 6;
- standardize();
+ turn_number += rhs;
  return *this;
 }
 
-bool calendar::operator ==(int rhs)
+bool calendar::operator ==(int rhs) const
 {
- return int(*this) == rhs;
-}
-bool calendar::operator ==(calendar &rhs)
-{
- return (second == rhs.second &&
-         minute == rhs.minute &&
-         hour   == rhs.hour &&
-         day    == rhs.day &&
-         season == rhs.season &&
-         year   == rhs.year);
+ return turn_number == rhs;
 }
 
-/*
-calendar& calendar::operator ++()
+bool calendar::operator ==(const calendar &rhs) const
 {
- *this += 1;
- return *this;
+ return turn_number == rhs.turn_number;
 }
-*/
 
-calendar calendar::operator -(calendar &rhs)
+calendar calendar::operator -(const calendar &rhs) const
 {
  return calendar(*this) -= rhs;
 }
 
-calendar calendar::operator -(int rhs)
+calendar calendar::operator -(int rhs) const
 {
  return calendar(*this) -= rhs;
 }
 
-calendar calendar::operator +(calendar &rhs)
+calendar calendar::operator +(const calendar &rhs) const
 {
  return calendar(*this) += rhs;
 }
 
-calendar calendar::operator +(int rhs)
+calendar calendar::operator +(int rhs) const
 {
  return calendar(*this) += rhs;
 }
 
 void calendar::increment()
 {
- second += 6;
- if (second >= 60)
-  standardize();
-}
-
-void calendar::standardize()
-{
- if (second >= 60) {
-  minute += second / 60;
-  second %= 60;
- }
- if (minute >= 60) {
-  hour += minute / 60;
-  minute %= 60;
- }
- if (hour >= 24) {
-  day += hour / 24;
-  hour %= 24;
- }
- int tmpseason = int(season);
- if (day >= DAYS_IN_SEASON) {
-  tmpseason += day / DAYS_IN_SEASON;
-  day %= DAYS_IN_SEASON;
- }
- if (tmpseason >= 4) {
-  year += tmpseason / 4;
-  tmpseason %= 4;
- }
- season = season_type(tmpseason);
+ turn_number++;
 }
 
-int calendar::minutes_past_midnight()
+int calendar::minutes_past_midnight() const
 {
- //debugmsg("minute: %d  hour: %d");
- int ret = minute + hour * 60;
- return ret;
+ return minute() + hour() * 60;
 }
 
-moon_phase calendar::moon()
+moon_phase calendar::moon() const
 {
- int phase = day / (DAYS_IN_SEASON / 4);
+ int phase = day() / (DAYS_IN_SEASON / 4);
  //phase %= 4;   Redundant?
  if (phase == 3)
   return MOON_HALF;
@@ -241,114 +118,102 @@ moon_phase calendar::moon()
   return moon_phase(phase);
 }
 
-calendar calendar::sunrise()
+// Sunrise or sunset, in minutes past midnight, moving from the start_hour to
+//  the end_hour over the course of a season
+static int sun_minutes(int day, int start_hour, int end_hour)
 {
- calendar ret;
- int start_hour = 0, end_hour = 0;
- switch (season) {
-  case SPRING:
-   start_hour = SUNRISE_SOLSTICE;
-   end_hour   = SUNRISE_SUMMER;
-   break;
-  case SUMMER:
-   start_hour = SUNRISE_SUMMER;
-   end_hour   = SUNRISE_SOLSTICE;
-   break;
-  case AUTUMN:
-   start_hour = SUNRISE_SOLSTICE;
-   end_hour   = SUNRISE_WINTER;
-   break;
-  case WINTER:
-   start_hour = SUNRISE_WINTER;
-   end_hour   = SUNRISE_SOLSTICE;
-   break;
- }
  double percent = double(double(day) / DAYS_IN_SEASON);
  double time = double(start_hour) * (1.- percent) + double(end_hour) * percent;
 
- ret.hour = int(time);
+ int hour = int(time);
  time -= int(time);
- ret.minute = int(time * 60);
-
- return ret;
+ return hour * 60 + int(time * 60);
 }
 
-calendar calendar::sunset()
+void calendar::update_sun_times() const
 {
- calendar ret;
- int start_hour = 0, end_hour = 0;
- switch (season) {
+ const int today = turn_number / DAYS(1);
+ if (today == sun_day)
+  return;
+ sun_day = today;
+ switch (season()) {
   case SPRING:
-   start_hour = SUNSET_SOLSTICE;
-   end_hour   = SUNSET_SUMMER;
+   sunrise_mins = sun_minutes(day(), SUNRISE_SOLSTICE, SUNRISE_SUMMER);
+   sunset_mins  = sun_minutes(day(), SUNSET_SOLSTICE,  SUNSET_SUMMER);
    break;
   case SUMMER:
-   start_hour = SUNSET_SUMMER;
-   end_hour   = SUNSET_SOLSTICE;
+   sunrise_mins = sun_minutes(day(), SUNRISE_SUMMER, SUNRISE_SOLSTICE);
+   sunset_mins  = sun_minutes(day(), SUNSET_SUMMER,  SUNSET_SOLSTICE);
    break;
   case AUTUMN:
-   start_hour = SUNSET_SOLSTICE;
-   end_hour   = SUNSET_WINTER;
+   sunrise_mins = sun_minutes(day(), SUNRISE_SOLSTICE, SUNRISE_WINTER);
+   sunset_mins  = sun_minutes(day(), SUNSET_SOLSTICE,  SUNSET_WINTER);
    break;
   case WINTER:
-   start_hour = SUNSET_WINTER;
-   end_hour   = SUNSET_SOLSTICE;
+   sunrise_mins = sun_minutes(day(), SUNRISE_WINTER, SUNRISE_SOLSTICE);
+   sunset_mins  = sun_minutes(day(), SUNSET_WINTER,  SUNSET_SOLSTICE);
    break;
  }
- double percent = double(double(day) / DAYS_IN_SEASON);
- double time = double(start_hour) * (1.- percent) + double(end_hour) * percent;
-
- ret.hour = int(time);
- time -= int(time);
- ret.minute = int(time * 60);
+}
 
- return ret;
+calendar calendar::sunrise() const
+{
+ update_sun_times();
+ return calendar(sunrise_mins % 60, sunrise_mins / 60, 0, SPRING, 0);
 }
 
-bool calendar::is_night()
+calendar calendar::sunset() const
 {
- calendar sunrise_time = sunrise(), sunset_time = sunset();
+ update_sun_times();
+ return calendar(sunset_mins % 60, sunset_mins / 60, 0, SPRING, 0);
+}
 
- int mins         = minutes_past_midnight(),
-     sunrise_mins = sunrise_time.minutes_past_midnight(),
-     sunset_mins  = sunset_time.minutes_past_midnight();
+bool calendar::is_night() const
+{
+ update_sun_times();
+ int mins = minutes_past_midnight();
 
  return (mins > sunset_mins + TWILIGHT_MINUTES || mins < sunrise_mins);
 }
 
-int calendar::sunlight()
+int calendar::sunlight() const
 {
- calendar sunrise_time = sunrise(), sunset_time = sunset();
-
- int mins = 0, sunrise_mins = 0, sunset_mins = 0;
- mins = minutes_past_midnight();
- sunrise_mins = sunrise_time.minutes_past_midnight();
- sunset_mins = sunset_time.minutes_past_midnight();
+ const int this_minute = turn_number / MINUTES(1);
+ if (this_minute == sunlight_minute)
+  return sunlight_level;
+ update_sun_times();
 
+ int mins = minutes_past_midnight();
  int moonlight = 1 + int(moon()) * MOONLIGHT_LEVEL;
+ int ret;
 
  if (mins > sunset_mins + TWILIGHT_MINUTES || mins < sunrise_mins) // Night
-  return moonlight;
+  ret = moonlight;
 
  else if (mins >= sunrise_mins && mins <= sunrise_mins + TWILIGHT_MINUTES) {
 
   double percent = double(mins - sunrise_mins) / TWILIGHT_MINUTES;
-  return int( double(moonlight)      * (1. - percent) +
-              double(DAYLIGHT_LEVEL) * percent         );
+  ret = int( double(moonlight)      * (1. - percent) +
+             double(DAYLIGHT_LEVEL) * percent         );
 
  } else if (mins >= sunset_mins && mins <= sunset_mins + TWILIGHT_MINUTES) {
 
   double percent = double(mins - sunset_mins) / TWILIGHT_MINUTES;
-  return int( double(DAYLIGHT_LEVEL) * (1. - percent) +
-              double(moonlight)      * percent         );
+  ret = int( double(DAYLIGHT_LEVEL) * (1. - percent) +
+             double(moonlight)      * percent         );
 
  } else
-  return DAYLIGHT_LEVEL;
+  ret = DAYLIGHT_LEVEL;
+
+ sunlight_minute = this_minute;
+ sunlight_level = ret;
+ return ret;
 }
 
-std::string calendar::print_time(bool twentyfour)
+std::string calendar::print_time(bool twentyfour) const
 {
  std::stringstream ret;
+ const int hour = this->hour(), minute = this->minute();
  if (twentyfour) {
   ret << hour << ":";
   if (minute < 10)
@@ -383,10 +248,11 @@ std::string calendar::print_time(bool twentyfour)
  return ret.str();
 }
 
-std::string calendar::textify_period()
+std::string calendar::textify_period() const
 {
- standardize();
  std::stringstream ret;
+ const int second = this->second(), minute = this->minute(), hour = this->hour(),
+           day = this->day(), season = this->season(), year = this->year();
  int am;
  std::string tx;
 // Describe the biggest time period, as "<am> <tx>s", am = amount, tx = name
@@ -37,47 +37,56 @@ MOON_FULL
 class calendar
 {
  public:
-// The basic data; note that "second" should always be a multiple of 6
-  int second;
-  int minute;
-  int hour;
-  int day;
-  season_type season;
-  int year;
-// End data
-
   calendar();
   calendar(const calendar &copy);
   calendar(int Minute, int Hour, int Day, season_type Season, int Year);
   calendar(int turn);
-  int get_turn();
-  operator int() const; // Returns get_turn() for backwards compatibility
-  calendar& operator = (calendar &rhs);
+  int get_turn() const { return turn_number; }
+  operator int() const { return turn_number; } // For backwards compatibility
+  calendar& operator = (const calendar &rhs);
   calendar& operator = (int rhs);
-  calendar& operator -=(calendar &rhs);
+  calendar& operator -=(const calendar &rhs);
   calendar& operator -=(int rhs);
-  calendar& operator +=(calendar &rhs);
+  calendar& operator +=(const calendar &rhs);
   calendar& operator +=(int rhs);
-  calendar  operator - (calendar &rhs);
-  calendar  operator - (int rhs);
-  calendar  operator + (calendar &rhs);
-  calendar  operator + (int rhs);
-  bool      operator ==(int rhs);
-  bool      operator ==(calendar &rhs);
+  calendar  operator - (const calendar &rhs) const;
+  calendar  operator - (int rhs) const;
+  calendar  operator + (const calendar &rhs) const;
+  calendar  operator + (int rhs) const;
+  bool      operator ==(int rhs) const;
+  bool      operator ==(const calendar &rhs) const;
 
   void increment();   // Add one turn / 6 seconds
 
-  void standardize(); // Ensure minutes <= 59, hour <= 23, etc.
+// The date and time, worked out from the turn; "second" is a multiple of 6
+  int second() const { return 6 * (turn_number % 10); }
+  int minute() const { return (turn_number / MINUTES(1)) % 60; }
+  int hour() const { return (turn_number / HOURS(1)) % 24; }
+  int day() const { return (turn_number / DAYS(1)) % DAYS_IN_SEASON; }
+  season_type season() const
+   { return season_type((turn_number / DAYS(DAYS_IN_SEASON)) % 4); }
+  int year() const { return turn_number / DAYS(DAYS_IN_SEASON * 4); }
 
 // Sunlight and day/night calcuations
-  int minutes_past_midnight(); // Useful for sunrise/set calculations
-  moon_phase moon();  // Find phase of moon
-  calendar sunrise(); // Current time of sunrise
-  calendar sunset();  // Current time of sunset
-  bool is_night();    // After sunset + TWILIGHT_MINUTES, before sunrise
-  int sunlight();     // Current amount of sun/moonlight; uses preceding funcs
+  int minutes_past_midnight() const; // Useful for sunrise/set calculations
+  moon_phase moon() const;  // Find phase of moon
+  calendar sunrise() const; // Current time of sunrise
+  calendar sunset() const;  // Current time of sunset
+  bool is_night() const;    // After sunset + TWILIGHT_MINUTES, before sunrise
+  int sunlight() const;     // Current amount of sun/moonlight; uses preceding funcs
 
 // Print-friendly stuff
-  std::string print_time(bool twentyfour = false);
-  std::string textify_period(); // "1 second" "2 hours" "two days"
+  std::string print_time(bool twentyfour = false) const;
+  std::string textify_period() const; // "1 second" "2 hours" "two days"
+
+ private:
+  int turn_number;
+
+// Sunrise and sunset only change once a day, and sunlight once a minute
+  void update_sun_times() const;
+  mutable int sun_day;       // The day (turn / DAYS(1)) sun times are for
+  mutable int sunrise_mins;
+  mutable int sunset_mins;
+  mutable int sunlight_minute; // The minute (turn / MINUTES(1)) of sunlight_level
+  mutable int sunlight_level;
 };
@@ -439,6 +439,18 @@ int wrefresh(WINDOW *win)
     return 1;
 };
 
+//DrawWindow only paints touched lines into the back buffer, and getch() puts
+//the buffer on screen, so batching a frame needs nothing more than wrefresh.
+int wnoutrefresh(WINDOW *win)
+{
+    return wrefresh(win);
+};
+
+int doupdate(void)
+{
+    return 1;
+};
+
 //Refreshes window 0 (stdscr), causing it to redraw on top.
 int refresh(void)
 {
@@ -112,6 +112,8 @@ WINDOW *newwin(int nlines, int ncols, int begin_y, int begin_x);
 int delwin(WINDOW *win);
 int wborder(WINDOW *win, chtype ls, chtype rs, chtype ts, chtype bs, chtype tl, chtype tr, chtype bl, chtype br);
 int wrefresh(WINDOW *win);
+int wnoutrefresh(WINDOW *win);
+int doupdate(void);
 int refresh(void);
 int getch(void);
 int mvwprintw(WINDOW *win, int y, int x, const char *fmt, ...);
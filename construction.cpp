@@ -638,7 +638,7 @@ void game::complete_construction()
 // Make the terrain change
  int terx = u.activity.placement.x, tery = u.activity.placement.y;
  if (stage.terrain != t_null)
-  m.ter(terx, tery) = stage.terrain;
+  m.ter_set(terx, tery, stage.terrain);
 
 // Strip off the first stage in our list...
  u.activity.values.erase(u.activity.values.begin());
@@ -809,8 +809,8 @@ void construct::done_furniture(game *g, point p)
   break;
  }
 
- g->m.ter(x, y) = g->m.ter(p.x, p.y);
- g->m.ter(p.x, p.y) = t_floor;
+ g->m.ter_set(x, y, g->m.ter(p.x, p.y));
+ g->m.ter_set(p.x, p.y, t_floor);
 
  //Move all Items within a container
  std::vector <item> vItemMove = g->m.i_at(p.x, p.y);
@@ -832,7 +832,7 @@ void construct::done_tree(game *g, point p)
  std::vector<point> tree = line_to(p.x, p.y, x, y, rng(1, 8));
  for (int i = 0; i < tree.size(); i++) {
   g->m.destroy(g, tree[i].x, tree[i].y, true);
-  g->m.ter(tree[i].x, tree[i].y) = t_log;
+  g->m.ter_set(tree[i].x, tree[i].y, t_log);
  }
 }
 
@@ -861,13 +861,13 @@ void construct::done_tape(game *g, point p)
   switch (g->m.ter(p.x, p.y))
   {
     case t_window_alarm:
-      g->m.ter(p.x, p.y) = t_window_alarm_taped;
+      g->m.ter_set(p.x, p.y, t_window_alarm_taped);
 
     case t_window_domestic:
-      g->m.ter(p.x, p.y) = t_window_domestic_taped;
+      g->m.ter_set(p.x, p.y, t_window_domestic_taped);
 
     case t_window:
-      g->m.ter(p.x, p.y) = t_window_taped;
+      g->m.ter_set(p.x, p.y, t_window_taped);
   }
 
 }
@@ -883,32 +883,32 @@ void construct::done_deconstruct(game *g, point p)
       g->m.add_item(p.x, p.y, g->itypes[itm_2x4], 0, 9);
       g->m.add_item(p.x, p.y, g->itypes[itm_rag], 0, 9);
       g->m.add_item(p.x, p.y, g->itypes[itm_nail], 0, rng(6,8));
-      g->m.ter(p.x, p.y) = t_floor;
+      g->m.ter_set(p.x, p.y, t_floor);
     break;
 
     case t_door_c:
     case t_door_o:
       g->m.add_item(p.x, p.y, g->itypes[itm_2x4], 0, 3);
       g->m.add_item(p.x, p.y, g->itypes[itm_nail], 0, rng(6,12));
-      g->m.ter(p.x, p.y) = t_door_frame;
+      g->m.ter_set(p.x, p.y, t_door_frame);
     break;
     case t_window_domestic:
       g->m.add_item(p.x, p.y, g->itypes[itm_stick], 0);
       g->m.add_item(p.x, p.y, g->itypes[itm_sheet], 0, 1);
       g->m.add_item(p.x, p.y, g->itypes[itm_glass_sheet], 0);
       g->m.add_item(p.x, p.y, g->itypes[itm_nail], 0, 3);
-      g->m.ter(p.x, p.y) = t_window_empty;
+      g->m.ter_set(p.x, p.y, t_window_empty);
     break;
 
     case t_window:
       g->m.add_item(p.x, p.y, g->itypes[itm_glass_sheet], 0);
-      g->m.ter(p.x, p.y) = t_window_empty;
+      g->m.ter_set(p.x, p.y, t_window_empty);
     break;
 
     case t_backboard:
       g->m.add_item(p.x, p.y, g->itypes[itm_2x4], 0, 4);
       g->m.add_item(p.x, p.y, g->itypes[itm_nail], 0, rng(6,10));
-      g->m.ter(p.x, p.y) = t_pavement;
+      g->m.ter_set(p.x, p.y, t_pavement);
     break;
 
     case t_sandbox:
@@ -917,7 +917,7 @@ void construct::done_deconstruct(game *g, point p)
     case t_crate_c:
       g->m.add_item(p.x, p.y, g->itypes[itm_2x4], 0, 4);
       g->m.add_item(p.x, p.y, g->itypes[itm_nail], 0, rng(6,10));
-      g->m.ter(p.x, p.y) = t_floor;
+      g->m.ter_set(p.x, p.y, t_floor);
     break;
 
     case t_chair:
@@ -925,25 +925,25 @@ void construct::done_deconstruct(game *g, point p)
     case t_desk:
       g->m.add_item(p.x, p.y, g->itypes[itm_2x4], 0, 4);
       g->m.add_item(p.x, p.y, g->itypes[itm_nail], 0, rng(6,10));
-      g->m.ter(p.x, p.y) = t_floor;
+      g->m.ter_set(p.x, p.y, t_floor);
     break;
 
     case t_slide:
       g->m.add_item(p.x, p.y, g->itypes[itm_sheet_metal], 3);
       g->m.add_item(p.x, p.y, g->itypes[itm_pipe], 0, rng(4,8));
-      g->m.ter(p.x, p.y) = t_grass;
+      g->m.ter_set(p.x, p.y, t_grass);
     break;
 
     case t_rack:
     case t_monkey_bars:
       g->m.add_item(p.x, p.y, g->itypes[itm_pipe], 0, rng(6,12));
-      g->m.ter(p.x, p.y) = t_grass;
+      g->m.ter_set(p.x, p.y, t_grass);
     break;
 
     case t_fridge:
       g->m.add_item(p.x, p.y, g->itypes[itm_scrap], 0, rng(2,6));
       g->m.add_item(p.x, p.y, g->itypes[itm_steel_chunk], 0, rng(2,3));
-      g->m.ter(p.x, p.y) = t_floor;
+      g->m.ter_set(p.x, p.y, t_floor);
     break;
 
     case t_counter:
@@ -951,20 +951,20 @@ void construct::done_deconstruct(game *g, point p)
     case t_table:
       g->m.add_item(p.x, p.y, g->itypes[itm_2x4], 0, 6);
       g->m.add_item(p.x, p.y, g->itypes[itm_nail], 0, rng(6,8));
-      g->m.ter(p.x, p.y) = t_floor;
+      g->m.ter_set(p.x, p.y, t_floor);
     break;
 
     case t_pool_table:
       g->m.add_item(p.x, p.y, g->itypes[itm_2x4], 0, 4);
       g->m.add_item(p.x, p.y, g->itypes[itm_rag], 0, 4);
       g->m.add_item(p.x, p.y, g->itypes[itm_nail], 0, rng(6,10));
-      g->m.ter(p.x, p.y) = t_floor;
+      g->m.ter_set(p.x, p.y, t_floor);
     break;
 
     case t_bookcase:
       g->m.add_item(p.x, p.y, g->itypes[itm_2x4], 0, 12);
       g->m.add_item(p.x, p.y, g->itypes[itm_nail], 0, rng(12,16));
-      g->m.ter(p.x, p.y) = t_floor;
+      g->m.ter_set(p.x, p.y, t_floor);
     break;
   }
 
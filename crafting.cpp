@@ -1207,7 +1207,242 @@ RECIPE(itm_brazier, CC_MISC, "mechanics", NULL, 1, 2000, false);
   COMP(itm_power_supply, 1, NULL);
 //  COMP(itm_battery, 500, itm_plut_cell, 1, NULL);
 //  COMP(itm_scrap, 30, NULL);
+
+ for (int i = 0; i < recipes.size(); i++)
+  recipes[i]->finalize(itypes);
+ crafting_index.build(recipes);
+ crafting_index.sync(crafting_res); // Still empty; later changes use update()
+}
+
+void recipe::finalize(const std::vector<itype*> &itypes)
+{
+ requirements.clear();
+// Tools: a count of -1 means "have one", otherwise "have that many charges"
+ for (int i = 0; i < 20 && tools[i].size() > 0; i++) {
+  std::vector<craft_requirement> group;
+  for (int j = 0; j < tools[i].size(); j++) {
+   int req = tools[i][j].count;
+   if (req <= 0)
+    group.push_back(craft_requirement(tools[i][j].type, 1, false));
+   else
+    group.push_back(craft_requirement(tools[i][j].type, req, true));
+  }
+  requirements.push_back(group);
+ }
+// Components: counted by charges if the type is, otherwise by quantity
+ for (int i = 0; i < 20 && components[i].size() > 0; i++) {
+  std::vector<craft_requirement> group;
+  for (int j = 0; j < components[i].size(); j++) {
+   itype_id type = components[i][j].type;
+   int count = components[i][j].count;
+   if (itypes[type]->count_by_charges() && count > 0)
+    group.push_back(craft_requirement(type, count, true));
+   else
+    group.push_back(craft_requirement(type, abs(count), false));
+  }
+  requirements.push_back(group);
+ }
+}
+
+crafting_resources::crafting_resources()
+{
+}
+
+void crafting_resources::clear()
+{
+ for (int i = 0; i < listed.size(); i++) {
+  amounts[listed[i]] = 0;
+  charges[listed[i]] = 0;
+  is_listed[listed[i]] = false;
+ }
+ listed.clear();
+}
+
+void crafting_resources::reserve(itype_id type)
+{
+ if (type >= amounts.size()) {
+  amounts.resize(type + 1, 0);
+  charges.resize(type + 1, 0);
+  is_listed.resize(type + 1, false);
+ }
+}
+
+void crafting_resources::add(itype_id type, int amount, int charge)
+{
+ reserve(type);
+ if (!is_listed[type]) {
+  is_listed[type] = true;
+  listed.push_back(type);
+ }
+ amounts[type] += amount;
+ charges[type] += charge;
+}
+
+void crafting_resources::add_item(const item &it)
+{
+ add_item(it, 1);
+}
+
+void crafting_resources::remove_item(const item &it)
+{
+ add_item(it, -1);
+}
+
+// Mirrors inventory::amount_of() and inventory::charges_of(): containers only
+// count as an item when empty, and their direct contents count as well.
+void crafting_resources::add_item(const item &it, int sign)
+{
+ int amount = 1;
+ if (it.type->is_container() && !it.contents.empty())
+  amount = 0;
+ add(itype_id(it.type->id), sign * amount,
+     sign * (it.charges < 0 ? 1 : it.charges));
+ for (int k = 0; k < it.contents.size(); k++) {
+  const item &content = it.contents[k];
+  add(itype_id(content.type->id), sign,
+      sign * (content.charges < 0 ? 1 : content.charges));
+ }
+}
+
+int crafting_resources::amount_of(itype_id type) const
+{
+ return (type < amounts.size() ? amounts[type] : 0);
+}
+
+int crafting_resources::charges_of(itype_id type) const
+{
+ return (type < charges.size() ? charges[type] : 0);
+}
+
+bool crafting_resources::has_amount(itype_id type, int quantity) const
+{
+ return (amount_of(type) >= quantity);
+}
+
+bool crafting_resources::has_charges(itype_id type, int quantity) const
+{
+ return (charges_of(type) >= quantity);
+}
+
+bool crafting_resources::has(const craft_requirement &req) const
+{
+ if (req.by_charges)
+  return has_charges(req.type, req.count);
+ return has_amount(req.type, req.count);
+}
+
+bool crafting_resources::can_make(const recipe *r) const
+{
+ for (int i = 0; i < r->requirements.size(); i++) {
+  const std::vector<craft_requirement> &group = r->requirements[i];
+  bool satisfied = false;
+  for (int j = 0; j < group.size() && !satisfied; j++)
+   satisfied = has(group[j]);
+  if (!satisfied)
+   return false;
+ }
+ return true;
 }
+
+void crafting_resources::changed_types(const crafting_resources &other,
+                                       std::vector<itype_id> &changed) const
+{
+ for (int i = 0; i < listed.size(); i++) {
+  itype_id type = listed[i];
+  if (amount_of(type) != other.amount_of(type) ||
+      charges_of(type) != other.charges_of(type))
+   changed.push_back(type);
+ }
+// Anything we haven't seen is zero here
+ for (int i = 0; i < other.listed.size(); i++) {
+  itype_id type = other.listed[i];
+  if ((type >= is_listed.size() || !is_listed[type]) &&
+      (other.amount_of(type) != 0 || other.charges_of(type) != 0))
+   changed.push_back(type);
+ }
+}
+
+void crafting_resources::swap(crafting_resources &other)
+{
+ amounts.swap(other.amounts);
+ charges.swap(other.charges);
+ listed.swap(other.listed);
+ is_listed.swap(other.is_listed);
+}
+
+void recipe_index::build(const std::vector<recipe*> &all_recipes)
+{
+ recipes = all_recipes;
+ users.clear();
+ group_met.clear();
+ met_count.clear();
+ for (int i = 0; i < recipes.size(); i++) {
+  const recipe *r = recipes[i];
+  group_met.push_back(std::vector<bool>(r->requirements.size(), false));
+  met_count.push_back(0);
+  for (int g = 0; g < r->requirements.size(); g++) {
+   for (int j = 0; j < r->requirements[g].size(); j++) {
+    itype_id type = r->requirements[g][j].type;
+    if (type >= users.size())
+     users.resize(type + 1);
+    std::vector<group_ref> &refs = users[type];
+// The same type may appear twice in a group (e.g. amount and charges)
+    if (refs.empty() || refs.back().recipe_id != i || refs.back().group != g)
+     refs.push_back(group_ref(i, g));
+   }
+  }
+ }
+}
+
+void recipe_index::check_group(const crafting_resources &res, int recipe_id,
+                               int group)
+{
+ const std::vector<craft_requirement> &alts =
+  recipes[recipe_id]->requirements[group];
+ bool met = false;
+ for (int j = 0; j < alts.size() && !met; j++)
+  met = res.has(alts[j]);
+ if (met != group_met[recipe_id][group]) {
+  group_met[recipe_id][group] = met;
+  met_count[recipe_id] += (met ? 1 : -1);
+ }
+}
+
+void recipe_index::sync(const crafting_resources &res)
+{
+ for (int i = 0; i < recipes.size(); i++) {
+  for (int g = 0; g < recipes[i]->requirements.size(); g++)
+   check_group(res, i, g);
+ }
+}
+
+void recipe_index::update(const crafting_resources &res,
+                          const std::vector<itype_id> &changed)
+{
+ for (int i = 0; i < changed.size(); i++) {
+  if (changed[i] >= users.size())
+   continue;
+  const std::vector<group_ref> &refs = users[changed[i]];
+  for (int j = 0; j < refs.size(); j++)
+   check_group(res, refs[j].recipe_id, refs[j].group);
+ }
+}
+
+bool recipe_index::available(int recipe_id) const
+{
+ if (recipe_id < 0 || recipe_id >= recipes.size())
+  return false;
+ return (met_count[recipe_id] == recipes[recipe_id]->requirements.size());
+}
+
+void recipe_index::available_recipes(std::vector<recipe*> &ret) const
+{
+ for (int i = 0; i < recipes.size(); i++) {
+  if (available(i))
+   ret.push_back(recipes[i]);
+ }
+}
+
 void game::recraft()
 {
  if(u.lastrecipe == NULL)
@@ -1216,6 +1451,7 @@ void game::recraft()
  }
  else
  {
+  invalidate_crafting_view(); // As in craft()
   try_and_make(u.lastrecipe);
  }
 }
@@ -1242,68 +1478,8 @@ void game::try_and_make(recipe *making)
 }
 bool game::can_make(recipe *r)
 {
- inventory crafting_inv = crafting_inventory();
- if((r->sk_primary != NULL && u.skillLevel(r->sk_primary) < r->difficulty) || (r->sk_secondary != NULL && u.skillLevel(r->sk_secondary) <= 0))
- {
- }
- // under the assumption that all comp and tool's array contains all the required stuffs at the start of the array
-
- // check all tools
- for(int i = 0 ; i < 20 ; i++)
- {
-  // if current tool is null(size 0), assume that there is no more after it.
-  if(r->tools[i].size()==0)
-  {
-   break;
-  }
-  bool has_tool = false;
-  for(int j = 0 ; j < r->tools[i].size() ; j++)
-  {
-   itype_id type = r->tools[i][j].type;
-   int req = r->tools[i][j].count;
-   if((req<= 0 && crafting_inv.has_amount(type,1)) || (req > 0 && crafting_inv.has_charges(type,req)))
-   {
-    has_tool = true;
-    break;
-   }
-  }
-  if(!has_tool)
-  {
-   return false;
-  }
- }
- // check all components
- for(int i = 0 ; i < 20 ; i++)
- {
-  if(r->components[i].size() == 0)
-  {
-   break;
-  }
-  bool has_comp = false;
-  for(int j = 0 ; j < r->components[i].size() ; j++)
-  {
-   itype_id type = r->components[i][j].type;
-   int req = r->components[i][j].count;
-   if (itypes[type]->count_by_charges() && req > 0)
-   {
-       if (crafting_inv.has_charges(type, req))
-       {
-           has_comp = true;
-           break;
-       }
-   }
-   else if (crafting_inv.has_amount(type, abs(req)))
-   {
-       has_comp = true;
-       break;
-   }
-  }
-  if(!has_comp)
-  {
-   return false;
-  }
- }
- return true;
+ crafting_view();
+ return crafting_index.available(r->id);
 }
 
 void game::craft()
@@ -1324,7 +1500,9 @@ void game::craft()
  bool done = false;
  InputEvent input;
 
- inventory crafting_inv = crafting_inventory();
+// Eating, reloading and using charges don't adjust the view; start from scratch
+ invalidate_crafting_view();
+ const crafting_resources &crafting_inv = crafting_view();
 
  do {
   if (redraw) { // When we switch tabs, redraw the header
@@ -1590,6 +1768,95 @@ void draw_recipe_tabs(WINDOW *w, craft_cat tab)
  wrefresh(w);
 }
 
+// Rebuilt when a turn has passed or the player has moved since the last build,
+// or after invalidate_crafting_view(); in between, crafting_view_adjust() keeps
+// it current as items are picked up, dropped, added or removed.  A rebuild
+// only re-checks the recipes that use a type whose totals changed.
+const crafting_resources& game::crafting_view()
+{
+ if (crafting_view_current())
+  return crafting_res;
+
+ crafting_res_prev.swap(crafting_res);
+ crafting_res.clear();
+ for (int x = u.posx - PICKUP_RANGE; x <= u.posx + PICKUP_RANGE; x++) {
+  for (int y = u.posy - PICKUP_RANGE; y <= u.posy + PICKUP_RANGE; y++) {
+   const std::vector<item> &here = m.i_peek(x, y);
+   for (int i = 0; i < here.size(); i++) {
+    if (!here[i].made_of(LIQUID))
+     crafting_res.add_item(here[i]);
+   }
+// Same kludges as inventory::form_from_map()
+   if (m.field_at(x, y).type == fd_fire)
+    crafting_res.add(itm_fire, 1, 1);
+   ter_id terrain_id = m.ter(x, y);
+   if (terrain_id == t_toilet || terrain_id == t_water_sh ||
+       terrain_id == t_water_dp)
+    crafting_res.add(itm_water, 1, 50);
+  }
+ }
+ for (int i = 0; i < u.inv.size(); i++) {
+  for (int j = 0; j < u.inv.stack_at(i).size(); j++)
+   crafting_res.add_item(u.inv.stack_at(i)[j]);
+ }
+ if (!u.weapon.is_null() && !u.weapon.is_style())
+  crafting_res.add_item(u.weapon);
+ if (u.has_bionic(bio_tools))
+  crafting_res.add(itm_toolset, 1, (u.power_level < 0 ? 1 : u.power_level));
+
+ std::vector<itype_id> changed;
+ crafting_res.changed_types(crafting_res_prev, changed);
+ crafting_index.update(crafting_res, changed);
+
+ crafting_view_valid = true;
+ crafting_view_turn = int(turn);
+ crafting_view_pos = point(u.posx, u.posy);
+ return crafting_res;
+}
+
+bool game::crafting_view_current()
+{
+ return (crafting_view_valid && crafting_view_turn == int(turn) &&
+         crafting_view_pos.x == u.posx && crafting_view_pos.y == u.posy);
+}
+
+void game::invalidate_crafting_view()
+{
+ crafting_view_valid = false;
+}
+
+// sign is 1 when it came within reach (into the inventory, the player's hands
+// or onto a nearby square) and -1 when it left.  A stale view is left alone;
+// its next rebuild picks the change up.
+void game::crafting_view_adjust(const item &it, int sign)
+{
+ if (it.is_null() || it.is_style() || !crafting_view_current())
+  return;
+ if (sign > 0)
+  crafting_res.add_item(it);
+ else
+  crafting_res.remove_item(it);
+ std::vector<itype_id> changed;
+ changed.push_back(itype_id(it.type->id));
+ for (int k = 0; k < it.contents.size(); k++)
+  changed.push_back(itype_id(it.contents[k].type->id));
+ crafting_index.update(crafting_res, changed);
+}
+
+void game::available_recipes(std::vector<recipe*> &ret)
+{
+ crafting_view();
+ for (int i = 0; i < recipes.size(); i++) {
+  if (crafting_index.available(i) &&
+      (recipes[i]->sk_primary == NULL ||
+       u.skillLevel(recipes[i]->sk_primary) >= recipes[i]->difficulty) &&
+      (recipes[i]->sk_secondary == NULL ||
+       u.skillLevel(recipes[i]->sk_secondary) > 0) &&
+      recipes[i]->category != CC_NONCRAFT)
+   ret.push_back(recipes[i]);
+ }
+}
+
 inventory game::crafting_inventory(){
  inventory crafting_inv;
  crafting_inv.form_from_map(this, point(u.posx, u.posy), PICKUP_RANGE);
@@ -1606,9 +1873,7 @@ inventory game::crafting_inventory(){
 void game::pick_recipes(std::vector<recipe*> &current,
                         std::vector<bool> &available, craft_cat tab)
 {
- inventory crafting_inv = crafting_inventory();
-
- bool have_tool[5], have_comp[5];
+ crafting_view();
 
  current.clear();
  available.clear();
@@ -1620,51 +1885,11 @@ void game::pick_recipes(std::vector<recipe*> &current,
       (recipes[i]->sk_secondary == NULL ||
        u.skillLevel(recipes[i]->sk_secondary) > 0))
   {
-    if (recipes[i]->difficulty >= 0)
-      current.push_back(recipes[i]);
-  }
-  available.push_back(false);
- }
- for (int i = 0; i < current.size() && i < 51; i++) {
-//Check if we have the requisite tools and components
-  for (int j = 0; j < 5; j++) {
-   have_tool[j] = false;
-   have_comp[j] = false;
-   if (current[i]->tools[j].size() == 0)
-    have_tool[j] = true;
-   else {
-    for (int k = 0; k < current[i]->tools[j].size(); k++) {
-     itype_id type = current[i]->tools[j][k].type;
-     int req = current[i]->tools[j][k].count;	// -1 => 1
-     if ((req <= 0 && crafting_inv.has_amount (type,   1)) ||
-         (req >  0 && crafting_inv.has_charges(type, req))   ) {
-      have_tool[j] = true;
-      k = current[i]->tools[j].size();
-     }
-    }
-   }
-   if (current[i]->components[j].size() == 0)
-    have_comp[j] = true;
-   else {
-    for (int k = 0; k < current[i]->components[j].size() && !have_comp[j]; k++){
-     itype_id type = current[i]->components[j][k].type;
-     int count = current[i]->components[j][k].count;
-     if (itypes[type]->count_by_charges() && count > 0) {
-      if (crafting_inv.has_charges(type, count)) {
-       have_comp[j] = true;
-       k = current[i]->components[j].size();
-      }
-     } else if (crafting_inv.has_amount(type, abs(count))) {
-      have_comp[j] = true;
-      k = current[i]->components[j].size();
-     }
-    }
+   if (recipes[i]->difficulty >= 0) {
+    current.push_back(recipes[i]);
+    available.push_back(crafting_index.available(recipes[i]->id));
    }
   }
-  if (have_tool[0] && have_tool[1] && have_tool[2] && have_tool[3] &&
-      have_tool[4] && have_comp[0] && have_comp[1] && have_comp[2] &&
-      have_comp[3] && have_comp[4])
-   available[i] = true;
  }
 }
 
@@ -1770,6 +1995,7 @@ void game::complete_craft()
 
 void game::consume_items(std::vector<component> components)
 {
+ invalidate_crafting_view();
 // For each set of components in the recipe, fill you_have with the list of all
 // matching ingredients the player has.
  std::vector<component> player_has;
@@ -1893,6 +2119,7 @@ void game::consume_items(std::vector<component> components)
 
 void game::consume_tools(std::vector<component> tools)
 {
+ invalidate_crafting_view();
  bool found_nocharge = false;
  inventory map_inv;
  map_inv.form_from_map(this, point(u.posx, u.posy), PICKUP_RANGE);
@@ -2064,7 +2291,7 @@ void game::complete_disassemble()
       else
         m.add_item(u.posx, u.posy, ammodrop);
     }
-    u.i_rem(u.activity.values[0]);  // remove the item
+    u.i_rem(u.activity.values[0], this);  // remove the item
 
   // consume tool charges
   for (int j = 0; j < 5; j++)
@@ -9,6 +9,8 @@
 
 #define MAX_DISPLAYED_RECIPES 18
 
+class item;
+
 enum craft_cat {
 CC_NULL = 0,
 CC_WEAPON,
@@ -31,6 +33,58 @@ struct component
  component(itype_id TYPE, int COUNT) : type (TYPE), count (COUNT) {}
 };
 
+// One alternative inside a requirement group, with the tool/component
+// conventions already resolved: either "at least count charges" or "at least
+// count items" of the given type.
+struct craft_requirement
+{
+ itype_id type;
+ int count;
+ bool by_charges;
+ craft_requirement() { type = itm_null; count = 0; by_charges = false; }
+ craft_requirement(itype_id TYPE, int COUNT, bool CHARGES) :
+   type (TYPE), count (COUNT), by_charges (CHARGES) {}
+};
+
+struct recipe;
+
+// Aggregated view of everything usable for crafting (nearby map items, the
+// player's inventory and weapon, bionic tools), reduced to per-type totals.
+// Answers the same questions as inventory::amount_of() and charges_of() on
+// game::crafting_inventory(), without copying or stacking any items.
+class crafting_resources
+{
+ public:
+  crafting_resources();
+
+  void clear();
+  void add_item(const item &it);
+  void remove_item(const item &it);
+  void add(itype_id type, int amount, int charges);
+
+  int amount_of (itype_id type) const;
+  int charges_of(itype_id type) const;
+  bool has_amount (itype_id type, int quantity) const;
+  bool has_charges(itype_id type, int quantity) const;
+
+  bool has(const craft_requirement &req) const;
+  bool can_make(const recipe *r) const;
+
+// Appends every type whose amount or charges differ between *this and other.
+// Only the types either side has seen since its last clear() are compared.
+  void changed_types(const crafting_resources &other,
+                     std::vector<itype_id> &changed) const;
+  void swap(crafting_resources &other);
+
+ private:
+  void reserve(itype_id type);
+  void add_item(const item &it, int sign);
+  std::vector<int> amounts;
+  std::vector<int> charges;
+  std::vector<itype_id> listed; // Types added to since clear()
+  std::vector<bool> is_listed;
+};
+
 struct recipe {
   int id;
   itype_id result;
@@ -44,6 +98,11 @@ struct recipe {
   std::vector<component> tools[20];
   std::vector<component> components[20];
 
+// Every non-empty tool and component group, resolved against the item types.
+// Built once by finalize(); a recipe is craftable when each group has at least
+// one satisfied alternative.
+  std::vector< std::vector<craft_requirement> > requirements;
+
   recipe() {
     id = 0;
     result = itm_null;
@@ -62,7 +121,38 @@ recipe(int pid, itype_id pres, craft_cat cat, const char *p1, const char *p2,
     sk_primary = p1?Skill::skill(p1):NULL;
     sk_secondary = p2?Skill::skill(p2):NULL;
   }
+
+  void finalize(const std::vector<itype*> &itypes);
 };
 
 
+// Reverse index from item types to the recipe requirement groups that mention
+// them, plus a per-recipe count of satisfied groups.  After the initial
+// sync(), update() only re-checks the groups touched by the changed types, so
+// availability follows pickups and drops without rescanning every recipe.
+class recipe_index
+{
+ public:
+  void build(const std::vector<recipe*> &recipes);
+  void sync(const crafting_resources &res);
+  void update(const crafting_resources &res,
+              const std::vector<itype_id> &changed);
+
+  bool available(int recipe_id) const;
+  void available_recipes(std::vector<recipe*> &ret) const;
+
+ private:
+  struct group_ref {
+   int recipe_id;
+   int group;
+   group_ref(int R, int G) : recipe_id (R), group (G) {}
+  };
+  void check_group(const crafting_resources &res, int recipe_id, int group);
+
+  std::vector<recipe*> recipes;
+  std::vector< std::vector<group_ref> > users; // Indexed by itype_id
+  std::vector< std::vector<bool> > group_met;  // [recipe][group]
+  std::vector<int> met_count;                  // Satisfied groups per recipe
+};
+
 #endif
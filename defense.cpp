@@ -168,10 +168,10 @@ void defense_game::init_mtypes(game *g)
  for (int i = 0; i < num_monsters; i++) {
   g->mtypes[i]->difficulty *= 1.5;
   g->mtypes[i]->difficulty += int(g->mtypes[i]->difficulty / 5);
-  g->mtypes[i]->flags.push_back(MF_BASHES);
-  g->mtypes[i]->flags.push_back(MF_SMELLS);
-  g->mtypes[i]->flags.push_back(MF_HEARS);
-  g->mtypes[i]->flags.push_back(MF_SEES);
+  g->mtypes[i]->flags.set(MF_BASHES);
+  g->mtypes[i]->flags.set(MF_SMELLS);
+  g->mtypes[i]->flags.set(MF_HEARS);
+  g->mtypes[i]->flags.set(MF_SEES);
  }
 }
 
@@ -195,7 +195,7 @@ void defense_game::init_map(game *g)
 {
  for (int x = 0; x < OMAPX; x++) {
   for (int y = 0; y < OMAPY; y++) {
-   g->cur_om.ter(x, y, 0) = ot_field;
+   g->cur_om.ter_set(x, y, 0, ot_field);
    g->cur_om.seen(x, y, 0) = true;
   }
  }
@@ -212,29 +212,29 @@ void defense_game::init_map(game *g)
  case DEFLOC_HOSPITAL:
   for (int x = 49; x <= 51; x++) {
    for (int y = 49; y <= 51; y++)
-    g->cur_om.ter(x, y, 0) = ot_hospital;
+    g->cur_om.ter_set(x, y, 0, ot_hospital);
   }
-  g->cur_om.ter(50, 49, 0) = ot_hospital_entrance;
+  g->cur_om.ter_set(50, 49, 0, ot_hospital_entrance);
   break;
 
  case DEFLOC_MALL:
   for (int x = 49; x <= 51; x++) {
    for (int y = 49; y <= 51; y++)
-    g->cur_om.ter(x, y, 0) = ot_megastore;
+    g->cur_om.ter_set(x, y, 0, ot_megastore);
   }
-  g->cur_om.ter(50, 49, 0) = ot_megastore_entrance;
+  g->cur_om.ter_set(50, 49, 0, ot_megastore_entrance);
   break;
 
  case DEFLOC_BAR:
-  g->cur_om.ter(50, 50, 0) = ot_bar_north;
+  g->cur_om.ter_set(50, 50, 0, ot_bar_north);
   break;
 
  case DEFLOC_MANSION:
   for (int x = 49; x <= 51; x++) {
    for (int y = 49; y <= 51; y++)
-    g->cur_om.ter(x, y, 0) = ot_mansion;
+    g->cur_om.ter_set(x, y, 0, ot_mansion);
   }
-  g->cur_om.ter(50, 49, 0) = ot_mansion_entrance;
+  g->cur_om.ter_set(50, 49, 0, ot_mansion_entrance);
   break;
  }
 // Init the map
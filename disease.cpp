@@ -890,7 +890,7 @@ void dis_effect(game *g, player &p, disease &dis)
   }
   if (dis.duration > 3600) { // 12 teles
    if (one_in(4000 - int(.25 * (dis.duration - 3600)))) {
-    mon_id type = MonsterGroupManager::GetMonsterFromGroup("GROUP_NETHER", &g->mtypes);
+    mon_id type = MonsterGroupManager::GetMonsterFromGroup("GROUP_NETHER");
     monster beast(g->mtypes[type]);
     int x, y, tries = 0;
     do {
@@ -901,7 +901,7 @@ void dis_effect(game *g, player &p, disease &dis)
              tries < 10);
     if (tries < 10) {
      if (g->m.move_cost(x, y) == 0)
-      g->m.ter(x, y) = t_rubble;
+      g->m.ter_set(x, y, t_rubble);
      beast.spawn(x, y);
      g->z.push_back(beast);
      if (g->u_see(x, y, junk)) {
@@ -952,7 +952,7 @@ void dis_effect(game *g, player &p, disease &dis)
  case DI_ATTENTION:
   if (one_in( 100000 / dis.duration ) && one_in( 100000 / dis.duration ) &&
       one_in(250)) {
-   mon_id type = MonsterGroupManager::GetMonsterFromGroup("GROUP_NETHER", &g->mtypes);
+   mon_id type = MonsterGroupManager::GetMonsterFromGroup("GROUP_NETHER");
    monster beast(g->mtypes[type]);
    int x, y, tries = 0, junk;
    do {
@@ -963,7 +963,7 @@ void dis_effect(game *g, player &p, disease &dis)
             tries < 10);
    if (tries < 10) {
     if (g->m.move_cost(x, y) == 0)
-     g->m.ter(x, y) = t_rubble;
+     g->m.ter_set(x, y, t_rubble);
     beast.spawn(x, y);
     g->z.push_back(beast);
     if (g->u_see(x, y, junk)) {
@@ -3,6 +3,7 @@
 #include "game.h"
 #include "rng.h"
 #include "options.h"
+#include <algorithm>
 
 void event::actualize(game *g)
 {
@@ -113,7 +114,7 @@ void event::actualize(game *g)
    for (int x = 0; x < SEEX * MAPSIZE; x++) {
     for (int y = 0; y < SEEY * MAPSIZE; y++) {
      if (g->m.ter(x, y) == t_root_wall && one_in(3))
-      g->m.ter(x, y) = t_underbrush;
+      g->m.ter_set(x, y, t_underbrush);
     }
    }
    break;
@@ -123,7 +124,7 @@ void event::actualize(game *g)
    for (int x = 0; x < SEEX * MAPSIZE; x++) {
     for (int y = 0; y < SEEY * MAPSIZE; y++) {
      if (g->m.ter(x, y) == t_grate) {
-      g->m.ter(x, y) = t_stairs_down;
+      g->m.ter_set(x, y, t_stairs_down);
       int j;
       if (!saw_grate && g->u_see(x, y, j))
        saw_grate = true;
@@ -185,7 +186,7 @@ void event::actualize(game *g)
 // flood_buf is filled with correct tiles; now copy them back to g->m
    for (int x = 0; x < SEEX * MAPSIZE; x++) {
     for (int y = 0; y < SEEY * MAPSIZE; y++)
-     g->m.ter(x, y) = flood_buf[x][y];
+     g->m.ter_set(x, y, flood_buf[x][y]);
    }
    g->add_event(EVENT_TEMPLE_FLOOD, int(g->turn) + rng(2, 3));
   } break;
@@ -258,3 +259,176 @@ void event::per_turn(game *g)
    break; // Nothing happens for other events
  }
 }
+
+bool event::ticks() const
+{
+ switch (type) {
+  case EVENT_WANTED:
+  case EVENT_SPAWN_WYRMS:
+  case EVENT_AMIGARA:
+  case EVENT_TEMPLE_OPEN:
+   return true;
+  default:
+   return false;
+ }
+}
+
+event_queue::event_queue()
+{
+ clear();
+}
+
+void event_queue::add(const event &ev)
+{
+ if (ev.ticks())
+  ticking.push_back(entry(next_seq, ev));
+ else
+  timed.insert(std::make_pair(ev.turn, entry(next_seq, ev)));
+ next_seq++;
+ count[ev.type]++;
+}
+
+// Walks the ticking events and the timed ones going off together, by seq.
+// actualize() may add more events, so take each one out before running it;
+//  any it adds that are due already are handled on this pass too.
+void event_queue::process(game *g, int turn)
+{
+ std::vector<entry> due; // Timed events going off, by seq
+ int last = -1;          // The seq of the last event handled
+ while (true) {
+  bool more = false;
+  while (!timed.empty() && timed.begin()->first <= turn) {
+   due.push_back(timed.begin()->second);
+   timed.erase(timed.begin());
+   more = true;
+  }
+  if (more)
+   std::sort(due.begin(), due.end(), added_before);
+  int t = 0;
+  while (t < ticking.size() && ticking[t].seq <= last)
+   t++;
+  if (t < ticking.size() && (due.empty() || ticking[t].seq < due[0].seq)) {
+   last = ticking[t].seq;
+   ticking[t].ev.per_turn(g);
+   if (ticking[t].ev.turn <= turn) {
+    event ev = ticking[t].ev;
+    ticking.erase(ticking.begin() + t);
+    count[ev.type]--;
+    ev.actualize(g);
+   }
+  } else if (!due.empty()) {
+   event ev = due[0].ev;
+   last = due[0].seq;
+   due.erase(due.begin());
+   count[ev.type]--;
+   ev.actualize(g);
+  } else
+   break;
+ }
+}
+
+const event *event_queue::find(event_type type) const
+{
+ if (count[type] == 0)
+  return NULL;
+ const entry *first = NULL;
+ for (int i = 0; i < ticking.size() && first == NULL; i++) {
+  if (ticking[i].ev.type == type)
+   first = &(ticking[i]);
+ }
+ for (std::multimap<int, entry>::const_iterator it = timed.begin();
+      it != timed.end(); ++it) {
+  if (it->second.ev.type == type && (first == NULL || it->second.seq < first->seq))
+   first = &(it->second);
+ }
+ return (first == NULL ? NULL : &(first->ev));
+}
+
+int event_queue::size() const
+{
+ return ticking.size() + timed.size();
+}
+
+void event_queue::clear()
+{
+ ticking.clear();
+ timed.clear();
+ next_seq = 0;
+ for (int i = 0; i < NUM_EVENT_TYPES; i++)
+  count[i] = 0;
+}
+
+turn_scheduler::turn_scheduler()
+{
+ last_turn = 0;
+ aligned = false;
+}
+
+void turn_scheduler::every(int task, int per)
+{
+ if (task >= period.size()) {
+  period.resize(task + 1, 0);
+  next.resize(task + 1, -1);
+ }
+ period[task] = per;
+ next[task] = -1;
+ aligned = false; // Scheduled on the next call to due()
+}
+
+void turn_scheduler::at(int task, int turn)
+{
+ if (task >= period.size()) {
+  period.resize(task + 1, 0);
+  next.resize(task + 1, -1);
+ }
+ period[task] = 0;
+ push(task, turn);
+}
+
+void turn_scheduler::push(int task, int turn)
+{
+ next[task] = turn;
+ entry tmp;
+ tmp.turn = turn;
+ tmp.task = task;
+ heap.push_back(tmp);
+ std::push_heap(heap.begin(), heap.end());
+}
+
+// Puts every recurring task on its next multiple, starting with this turn
+void turn_scheduler::align(int turn)
+{
+ for (int i = 0; i < period.size(); i++) {
+  if (period[i] > 0)
+   push(i, ((turn + period[i] - 1) / period[i]) * period[i]);
+ }
+ aligned = true;
+}
+
+unsigned turn_scheduler::due(int turn)
+{
+// The clock only jumps when a game is started or loaded
+ if (!aligned || turn < last_turn)
+  align(turn);
+ last_turn = turn;
+
+ unsigned ret = 0;
+ while (!heap.empty() && heap.front().turn <= turn) {
+  entry top = heap.front();
+  std::pop_heap(heap.begin(), heap.end());
+  heap.pop_back();
+  if (next[top.task] != top.turn)
+   continue; // Rescheduled since this was pushed
+  if (period[top.task] == 0) {
+   ret |= mfb(top.task);
+   next[top.task] = -1;
+  } else {
+// Recurring tasks only run on their exact turn, so skipping ahead doesn't
+//  run them early
+   if (top.turn == turn)
+    ret |= mfb(top.task);
+   push(top.task, (turn / period[top.task] + 1) * period[top.task]);
+  }
+ }
+ return ret;
+}
@@ -3,6 +3,8 @@
 
 #include "faction.h"
 #include "line.h"
+#include <vector>
+#include <map>
 
 class game;
 
@@ -46,6 +48,64 @@ struct event {
 
  void actualize(game *g); // When the time runs out
  void per_turn(game *g);  // Every turn
+ bool ticks() const;      // True if per_turn() does anything for this type
+};
+
+// Pending events.  Only events that do something every turn are looked at
+//  every turn; the rest are ordered by when they go off and wait their turn.
+//  Each turn, the ticking events and the ones going off are still handled in
+//  the order they were added, as if they were all in one list.
+class event_queue
+{
+ public:
+  event_queue();
+
+  void add(const event &ev);
+  void process(game *g, int turn); // per_turn() and actualize() what is due
+  bool queued(event_type type) const { return count[type] > 0; }
+  const event *find(event_type type) const; // The first added, or NULL
+  int size() const;
+  void clear();
+
+ private:
+  struct entry {
+   int seq; // Order added
+   event ev;
+   entry(int S, const event &E) : seq (S), ev (E) {}
+  };
+  static bool added_before(const entry &a, const entry &b) { return a.seq < b.seq; }
+
+  std::vector<entry> ticking; // In the order added
+  std::multimap<int, entry> timed; // Keyed by event::turn
+  int count[NUM_EVENT_TYPES];
+  int next_seq;
+};
+
+// Work that recurs every so many turns, or happens once on a given turn.
+//  Tasks are small ints, chosen by the user; due() hands back the ones due on
+//  this turn as a bit field.
+class turn_scheduler
+{
+ public:
+  turn_scheduler();
+
+  void every(int task, int period); // On every turn divisible by period
+  void at(int task, int turn);      // Once, on the first turn >= turn
+  unsigned due(int turn);
+
+ private:
+  struct entry {
+   int turn, task;
+   bool operator<(const entry &other) const { return turn > other.turn; }
+  };
+  void push(int task, int turn);
+  void align(int turn);
+
+  std::vector<entry> heap; // Soonest on top; stale entries are skipped
+  std::vector<int> period; // 0 for one-off tasks
+  std::vector<int> next;   // When each task is due, or -1
+  int last_turn;
+  bool aligned;
 };
 
 #endif
@@ -24,9 +24,13 @@ bool map::process_fields_in_submap(game *g, int gridn)
  bool found_field = false;
  field *cur;
  field_id curtype;
- for (int locx = 0; locx < SEEX; locx++) {
-  for (int locy = 0; locy < SEEY; locy++) {
-   cur = &(grid[gridn]->fld[locx][locy]);
+// Only squares with a field entry can have a field.  Spreading may add
+//  entries as we go; like the squares of the old array, those after this one
+//  are visited in this pass and those before it are not.
+ std::map<int, field> &fields = grid[gridn]->fld;
+ for (std::map<int, field>::iterator it = fields.begin(); it != fields.end(); it++) {
+   cur = &(it->second);
+   const int locx = it->first / SEEY, locy = it->first % SEEY;
    int x = locx + SEEX * (gridn % my_MAPSIZE),
        y = locy + SEEY * int(gridn / my_MAPSIZE);
 
@@ -183,7 +187,7 @@ bool map::process_fields_in_submap(game *g, int gridn)
     if(tr_brazier != tr_at(x, y)) {
      // Consume the terrain we're on
      if (has_flag(explodes, x, y)) {
-      ter(x, y) = ter_id(int(ter(x, y)) + 1);
+      ter_set(x, y, ter_id(int(ter(x, y)) + 1));
       cur->age = 0;
       cur->density = 3;
       g->explosion(x, y, 40, 0, true);
@@ -198,7 +202,7 @@ bool map::process_fields_in_submap(game *g, int gridn)
       cur->age -= cur->density * cur->density * 40;
       smoke += 15;
       if (cur->density == 3)
-       ter(x, y) = t_ash;
+       ter_set(x, y, t_ash);
 
      } else if (has_flag(l_flammable, x, y) && one_in(62 - cur->density * 10)) {
       cur->age -= cur->density * cur->density * 30;
@@ -248,7 +252,7 @@ bool map::process_fields_in_submap(game *g, int gridn)
         spread_chance = 50 + spread_chance / 2;
        if (has_flag(explodes, fx, fy) && one_in(8 - cur->density) &&
 	   tr_brazier != tr_at(x, y)) {
-        ter(fx, fy) = ter_id(int(ter(fx, fy)) + 1);
+        ter_set(fx, fy, ter_id(int(ter(fx, fy)) + 1));
         g->explosion(fx, fy, 40, 0, true);
        } else if ((i != 0 || j != 0) && rng(1, 100) < spread_chance &&
                   tr_brazier != tr_at(x, y) &&
@@ -653,10 +657,9 @@ bool map::process_fields_in_submap(game *g, int gridn)
     }
     if (cur->density <= 0) { // Totally dissapated.
      grid[gridn]->field_count--;
-     grid[gridn]->fld[locx][locy] = field();
+     *cur = field();
     }
    }
-  }
  }
  return found_field;
 }
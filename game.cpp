@@ -18,6 +18,8 @@
 #include <map>
 #include <algorithm>
 #include <string>
+#include <cstring>
+#include <cstdio>
 #include <fstream>
 #include <sstream>
 #include <math.h>
@@ -49,7 +51,10 @@ game::game() :
  om_hori(NULL),
  om_vert(NULL),
  om_diag(NULL),
- gamemode(NULL)
+ gamemode(NULL),
+ crafting_view_valid(false),
+ drawing_frame(false),
+ lightmap_valid(false)
 {
  dout() << "Game initialized.";
 // Gee, it sure is init-y around here!
@@ -66,6 +71,8 @@ game::game() :
  init_vehicles();     // Set up vehicles                  (SEE veh_typedef.cpp)
  init_autosave();     // Set up autosave
  load_keyboard_settings();
+ monster_rng.seed(rng_world_seed(), 1);
+ field_rng.seed(rng_world_seed(), 2);
 
 
  gamemode = new special_game;	// Nothing, basically.
@@ -184,6 +191,14 @@ void game::setup()
 
  weather = WEATHER_CLEAR; // Start with some nice weather...
  nextweather = MINUTES(STARTING_MINUTES + 30); // Weather shift in 30
+ turn_tasks = turn_scheduler();
+ turn_tasks.every(TASK_METABOLISM, 50);
+ turn_tasks.every(TASK_HALF_HOUR, 300);
+ turn_tasks.every(TASK_MORALE, 10);
+ turn_tasks.every(TASK_MIDNIGHT, DAYS(1));
+ turn_tasks.every(TASK_HORDES, 30);
+ turn_tasks.every(TASK_SUBMAPS, 10);
+ turn_tasks.at(TASK_WEATHER, nextweather);
  turnssincelastmon = 0; //Auto safe mode init
  autosafemode = OPTIONS[OPT_AUTOSAFEMODE];
 
@@ -197,7 +212,9 @@ void game::setup()
  messages.clear();
  events.clear();
 
- turn.season = SUMMER;    // ... with winter conveniently a long ways off
+ // ... with winter conveniently a long ways off
+ turn = calendar(turn.minute(), turn.hour(), turn.day(), SUMMER, turn.year()) +
+        turn.second() / 6;
 
  for (int i = 0; i < num_monsters; i++)	// Reset kill counts to 0
   kills[i] = 0;
@@ -317,10 +334,18 @@ bool game::do_turn()
 // Actual stuff
  gamemode->per_turn(this);
  turn.increment();
+ const unsigned tasks = turn_tasks.due(int(turn));
  process_events();
  process_missions();
- if (turn.hour == 0 && turn.minute == 0 && turn.second == 0) // Midnight!
+ if (tasks & mfb(TASK_MIDNIGHT))
   cur_om.process_mongroups();
+ if (tasks & mfb(TASK_HORDES)) {
+// Hordes within a few submaps catch wind of the player
+  cur_om.signal_hordes(levx + int(MAPSIZE / 2), levy + int(MAPSIZE / 2), levz, 4);
+  cur_om.move_hordes();
+ }
+ if (tasks & mfb(TASK_SUBMAPS))
+  MAPBUFFER.evict_old_submaps(m);
 
 // Check if we've overdosed... in any deadly way.
  if (u.stim > 250) {
@@ -331,7 +356,7 @@ bool game::do_turn()
   u.hp_cur[hp_torso] = 0;
  }
 
- if (turn % 50 == 0) {	// Hunger, thirst, & fatigue up every 5 minutes
+ if (tasks & mfb(TASK_METABOLISM)) {	// Hunger, thirst, & fatigue up every 5 minutes
   if ((!u.has_trait(PF_LIGHTEATER) || !one_in(3)) &&
       (!u.has_bionic(bio_recycler) || turn % 300 == 0))
    u.hunger++;
@@ -357,7 +382,7 @@ bool game::do_turn()
   if (u.has_bionic(bio_solar) && is_in_sunlight(u.posx, u.posy))
    u.charge_power(1);
  }
- if (turn % 300 == 0) {	// Pain up/down every 30 minutes
+ if (tasks & mfb(TASK_HALF_HOUR)) {	// Pain up/down every 30 minutes
   if (u.pain > 0)
    u.pain -= 1 + int(u.pain / 10);
   else if (u.pain < 0)
@@ -380,7 +405,7 @@ bool game::do_turn()
     autosave();
  }
 // Update the weather, if it's time.
- if (turn >= nextweather)
+ if (tasks & mfb(TASK_WEATHER))
   update_weather();
 
 // The following happens when we stay still; 10/40 minutes overdue for spawn
@@ -407,11 +432,17 @@ bool game::do_turn()
  }
  update_scent();
  m.vehmove(this);
- m.process_fields(this);
+ {
+  rng_stream_scope field_scope(field_rng);
+  m.process_fields(this);
+ }
  m.process_active_items(this);
  m.step_in_field(u.posx, u.posy, this);
 
- monmove();
+ {
+  rng_stream_scope monster_scope(monster_rng);
+  monmove();
+ }
  update_stair_monsters();
  u.reset(this);
  u.process_active_items(this);
@@ -422,7 +453,7 @@ bool game::do_turn()
   (weffect.*(weather_data[weather].effect))(this);
  }
 
- if (u.has_disease(DI_SLEEP) && int(turn) % 300 == 0) {
+ if (u.has_disease(DI_SLEEP) && (tasks & mfb(TASK_HALF_HOUR))) {
   draw();
   refresh();
  }
@@ -430,8 +461,13 @@ bool game::do_turn()
  u.update_bodytemp(this);
 
  rustCheck();
- if (turn % 10 == 0)
+ if (tasks & mfb(TASK_MORALE))
   u.update_morale();
+#ifdef ITEM_COPY_STATS
+ dbg(D_INFO) << "game:do_turn: " << item_copy_counter::copies <<
+                " item copies on turn " << int(turn);
+ item_copy_counter::copies = 0;
+#endif
  return false;
 }
 
@@ -466,14 +502,7 @@ void game::rustCheck() {
 
 void game::process_events()
 {
- for (int i = 0; i < events.size(); i++) {
-  events[i].per_turn(this);
-  if (events[i].turn <= int(turn)) {
-   events[i].actualize(this);
-   events.erase(events.begin() + i);
-   i--;
-  }
- }
+ events.process(this, int(turn));
 }
 
 void game::process_activity()
@@ -498,7 +527,7 @@ void game::process_activity()
      for(int j = -1; j <= 1; j++)
       if(m.ter(u.posx + i, u.posy + j) == t_gas_pump) {
        add_msg("With a clang and a shudder, the gas pump goes silent.");
-       m.ter(u.posx + i, u.posy + j) = t_gas_pump_empty;
+       m.ter_set(u.posx + i, u.posy + j, t_gas_pump_empty);
        u.activity.moves_left = 0;
        // Found it, break out of the loop.
        i = 2;
@@ -708,7 +737,7 @@ void game::cancel_activity_query(const char* message, ...)
 
 void game::update_weather()
 {
- season_type season = turn.season;
+ season_type season = turn.season();
 // Pick a new weather type (most likely the same one)
  int chances[NUM_WEATHER_TYPES];
  int total = 0;
@@ -741,6 +770,7 @@ void game::update_weather()
  int minutes = rng(weather_data[new_weather].mintime,
                    weather_data[new_weather].maxtime);
  nextweather = turn + MINUTES(minutes);
+ turn_tasks.at(TASK_WEATHER, nextweather);
  weather = new_weather;
  if (weather == WEATHER_SUNNY && turn.is_night())
   weather = WEATHER_CLEAR;
@@ -884,14 +914,21 @@ bool game::mission_complete(int id, int npc_id)
    return (u.has_mission_item(miss->uid) &&
            (miss->npc_id == -1 || miss->npc_id == npc_id));
 
-  case MGOAL_FIND_MONSTER:
+  case MGOAL_FIND_MONSTER: {
    if (miss->npc_id != -1 && miss->npc_id != npc_id)
     return false;
+   int index = z.index_of(miss->monster);
+   if (index != -1 && z[index].mission_id == miss->uid)
+    return true;
+// Loaded with the game, or never spawned; look for it once
    for (int i = 0; i < z.size(); i++) {
-    if (z[i].mission_id == miss->uid)
+    if (z[i].mission_id == miss->uid) {
+     miss->monster = z.handle_at(i);
      return true;
+    }
    }
    return false;
+  }
 
   case MGOAL_FIND_NPC:
    return (miss->npc_id == npc_id);
@@ -1492,7 +1529,8 @@ bool game::handle_action()
   case ACTION_QUIT:
    if (query_yn("Commit suicide?")) {
     u.moves = 0;
-    std::vector<item> tmp = u.inv_dump();
+    std::vector<item> tmp;
+    u.inv_dump(tmp);
     item your_body;
     your_body.make_corpse(itypes[itm_corpse], mtypes[mon_null], turn);
     your_body.name = u.name;
@@ -1582,7 +1620,7 @@ void game::update_scent()
  for (int x = u.posx - SCENT_RADIUS; x <= u.posx + SCENT_RADIUS; x++) {
   for (int y = u.posy - SCENT_RADIUS; y <= u.posy + SCENT_RADIUS; y++) {
    move_cost = m.move_cost(x, y);
-   field_at = m.field_at(x, y);
+   field_at = m.field_peek(x, y);
    newscent[x][y] = 0;
    if (move_cost != 0 || m.has_flag(bashable, x, y)) {
     int squares_used = 0;
@@ -1630,7 +1668,8 @@ bool game::is_game_over()
   return true;
  for (int i = 0; i <= hp_torso; i++) {
   if (u.hp_cur[i] < 1) {
-   std::vector<item> tmp = u.inv_dump();
+   std::vector<item> tmp;
+   u.inv_dump(tmp);
    item your_body;
    your_body.make_corpse(itypes[itm_corpse], mtypes[mon_null], turn);
    your_body.name = u.name;
@@ -1743,6 +1782,14 @@ bool game::load_master()
    fin.get(junk); // Chomp that pesky endline
  }
 
+// Last, the world seed; older saves don't have one and keep the current seed
+ uint32_t seed;
+ if (fin >> seed) {
+  rng_set_world_seed(seed);
+  monster_rng.seed(seed, 1);
+  field_rng.seed(seed, 2);
+ }
+
  fin.close();
  return true;
 }
@@ -1771,6 +1818,7 @@ void game::load(std::string name)
  turn = tmpturn;
  nextspawn = tmpspawn;
  nextweather = tmpnextweather;
+ turn_tasks.at(TASK_WEATHER, nextweather);
 
  cur_om = overmap(this, comx, comy);
  m.load(this, levx, levy, levz);
@@ -1779,7 +1827,6 @@ void game::load(std::string name)
  if (OPTIONS[OPT_SAFEMODE] && run_mode == 0)
   run_mode = 1;
  autosafemode = OPTIONS[OPT_AUTOSAFEMODE];
- last_target = tmptar;
  weather = weather_type(tmpweather);
  temperature = tmptemp;
 // Next, the scent map.
@@ -1802,6 +1849,7 @@ void game::load(std::string name)
   montmp.load_info(data, &mtypes);
   z.push_back(montmp);
  }
+ last_target = z.handle_at(tmptar); // Saved as an index
 // And the kill counts;
  if (fin.peek() == '\n')
   fin.get(junk); // Chomp that pesky endline
@@ -1853,7 +1901,7 @@ void game::save()
  masterfile << "save/master.gsav";
  fout.open(playerfile.str().c_str());
 // First, write out basic game state information.
- fout << int(turn) << " " << int(last_target) << " " << int(run_mode) << " " <<
+ fout << int(turn) << " " << z.index_of(last_target) << " " << int(run_mode) << " " <<
          mostseen << " " << nextinv << " " << next_npc_id << " " <<
          next_faction_id << " " << next_mission_id << " " << int(nextspawn) <<
          " " << int(nextweather) << " " << weather << " " << int(temperature) <<
@@ -1894,19 +1942,26 @@ void game::save()
   fout << active_npc[i].save_info() << std::endl;
  }
 
+ fout << rng_world_seed() << std::endl;
  fout.close();
 
 // Finally, save artifacts.
+ save_artifacts();
+// aaaand the overmap, and the local map.
+ cur_om.save();
+ m.save(&cur_om, turn, levx, levy, levz);
+ MAPBUFFER.save();
+}
+
+void game::save_artifacts()
+{
  if (itypes.size() > num_all_items) {
+  std::ofstream fout;
   fout.open("save/artifacts.gsav");
   for (int i = num_all_items; i < itypes.size(); i++)
    fout << itypes[i]->save_data() << "\n";
   fout.close();
  }
-// aaaand the overmap, and the local map.
- cur_om.save();
- m.save(&cur_om, turn, levx, levy, levz);
- MAPBUFFER.save();
 }
 
 void game::delete_save()
@@ -1959,23 +2014,54 @@ void game::decrease_nextinv()
   nextinv--;
 }
 
-void game::vadd_msg(const char* msg, va_list ap)
+message_log::message_log()
 {
- char buff[1024];
- vsprintf(buff, msg, ap);
- std::string s(buff);
- if (s.length() == 0)
-  return;
- if (!messages.empty() && int(messages.back().turn) + 3 >= int(turn) &&
-     s == messages.back().message) {
-  messages.back().count++;
-  messages.back().turn = turn;
+ clear();
+}
+
+void message_log::clear()
+{
+ first = 0;
+ count = 0;
+}
+
+const game_message& message_log::operator[](int i) const
+{
+ return slots[(first + i) % (MESSAGE_LOG_SIZE + 1)];
+}
+
+// A message identical to the last one, within 3 turns of it, bumps its count
+void message_log::add(const calendar &turn, const char *msg, va_list ap)
+{
+ game_message &next = slots[(first + count) % (MESSAGE_LOG_SIZE + 1)];
+ int len = vsnprintf(next.message, MESSAGE_MAX_LEN, msg, ap);
+ if (len <= 0)
   return;
+ if (len >= MESSAGE_MAX_LEN)
+  len = MESSAGE_MAX_LEN - 1;
+
+ if (count > 0) {
+  game_message &last = slots[(first + count - 1) % (MESSAGE_LOG_SIZE + 1)];
+  if (int(last.turn) + 3 >= int(turn) && last.length == len &&
+      memcmp(last.message, next.message, len) == 0) {
+   last.count++;
+   last.turn = turn;
+   return;
+  }
  }
 
- if (messages.size() == 256)
-  messages.erase(messages.begin());
- messages.push_back( game_message(turn, s) );
+ next.turn = turn;
+ next.count = 1;
+ next.length = len;
+ if (count == MESSAGE_LOG_SIZE)
+  first = (first + 1) % (MESSAGE_LOG_SIZE + 1);
+ else
+  count++;
+}
+
+void game::vadd_msg(const char* msg, va_list ap)
+{
+ messages.add(turn, msg, ap);
 }
 
 void game::add_msg(const char* msg, ...)
@@ -1999,17 +2085,12 @@ void game::add_msg_if_player(player *p, const char* msg, ...)
 
 void game::add_event(event_type type, int on_turn, int faction_id, int x, int y)
 {
- event tmp(type, on_turn, faction_id, x, y);
- events.push_back(tmp);
+ events.add(event(type, on_turn, faction_id, x, y));
 }
 
 bool game::event_queued(event_type type)
 {
- for (int i = 0; i < events.size(); i++) {
-  if (events[i].type == type)
-   return true;
-  }
-  return false;
+ return events.queued(type);
 }
 
 void game::debug()
@@ -2517,8 +2598,12 @@ void game::list_missions()
  refresh_all();
 }
 
+// Every window drawn here is only copied into curses' virtual screen; the
+//  single doupdate() at the end sends the cells that differ from the last
+//  frame to the terminal in one write.
 void game::draw()
 {
+ drawing_frame = true;
  // Draw map
  werase(w_terrain);
  draw_ter();
@@ -2558,10 +2643,10 @@ void game::draw()
   wprintz(w_location, col_temp, " %dC", int((temperature - 32) / 1.8));
  else
   wprintz(w_location, col_temp, " %dF", temperature);
- wrefresh(w_location);
+ refresh_window(w_location);
 
  mvwprintz(w_status, 0, 41, c_white, "%s, day %d",
-           season_name[turn.season].c_str(), turn.day + 1);
+           season_name[turn.season()].c_str(), turn.day() + 1);
  if (run_mode != 0 || autosafemode != 0) {
   int iPercent = ((turnssincelastmon*100)/OPTIONS[OPT_AUTOSAFEMODETURNS]);
   mvwprintz(w_status, 2, 51, (run_mode == 0) ? ((iPercent >= 25) ? c_green : c_red): c_green, "S");
@@ -2569,9 +2654,19 @@ void game::draw()
   wprintz(w_status, (run_mode == 0) ? ((iPercent >= 75) ? c_green : c_red): c_green, "F");
   wprintz(w_status, (run_mode == 0) ? ((iPercent == 100) ? c_green : c_red): c_green, "E");
  }
- wrefresh(w_status);
+ refresh_window(w_status);
  // Draw messages
  write_msg();
+ drawing_frame = false;
+ doupdate();
+}
+
+void game::refresh_window(WINDOW *w)
+{
+ if (drawing_frame)
+  wnoutrefresh(w);
+ else
+  wrefresh(w);
 }
 
 bool game::isBetween(int test, int down, int up)
@@ -2589,7 +2684,22 @@ void game::draw_ter(int posx, int posy)
  if (posy == -999)
   posy = u.posy + u.view_offset_y;
  int t = 0;
- lm.generate(this, posx, posy, natural_light_level(), u.active_light());
+// The light map only depends on the map, which changes when the player acts or
+//  a turn passes, and on the light levels; redraws in between reuse it.
+ const float natural = natural_light_level(), luminance = u.active_light();
+ if (!lightmap_valid || lightmap_turn != int(turn) || lightmap_moves != u.moves ||
+     lightmap_pos.x != posx || lightmap_pos.y != posy ||
+     lightmap_lev.x != levx || lightmap_lev.y != levy || lightmap_lev.z != levz ||
+     lightmap_natural != natural || lightmap_luminance != luminance) {
+  lm.generate(this, posx, posy, natural, luminance);
+  lightmap_valid = true;
+  lightmap_turn = int(turn);
+  lightmap_moves = u.moves;
+  lightmap_pos = point(posx, posy);
+  lightmap_lev = tripoint(levx, levy, levz);
+  lightmap_natural = natural;
+  lightmap_luminance = luminance;
+ }
  m.draw(this, w_terrain, point(posx, posy));
 
  // Draw monsters
@@ -2630,7 +2740,7 @@ void game::draw_ter(int posx, int posy)
    }
   }
  }
- wrefresh(w_terrain);
+ refresh_window(w_terrain);
  if (u.has_disease(DI_VISUALS) || (u.has_disease(DI_HOT_HEAD) && u.disease_intensity(DI_HOT_HEAD) != 1))
    hallucinate(posx, posy);
 }
@@ -2638,6 +2748,7 @@ void game::draw_ter(int posx, int posy)
 void game::refresh_all()
 {
  m.reset_vehicle_cache();
+ invalidate_lightmap();
  draw();
  draw_minimap();
  draw_HP();
@@ -2648,6 +2759,17 @@ void game::refresh_all()
  refresh();
 }
 
+// Animations only slow things down without a screen, e.g. cataclysm-pregen
+bool game::animations_enabled()
+{
+ return w_terrain != NULL && !OPTIONS[OPT_NO_ANIMATIONS];
+}
+
+void game::invalidate_lightmap()
+{
+ lightmap_valid = false;
+}
+
 void game::draw_HP()
 {
     werase(w_HP);
@@ -2711,7 +2833,7 @@ void game::draw_HP()
             mvwprintz(w_HP, 13, 0, color, "  %d    ", u.power_level);
         }
     }
-    wrefresh(w_HP);
+    refresh_window(w_HP);
 }
 
 void game::draw_minimap()
@@ -2835,19 +2957,32 @@ void game::hallucinate(const int x, const int y)
    }
   }
  }
- wrefresh(w_terrain);
+ refresh_window(w_terrain);
 }
 
-float game::natural_light_level()
+const environment_snapshot &game::environment()
 {
- float ret = 0;
+ if (env.turn == int(turn) && env.levz == levz && env.weather == weather)
+  return env;
 
+ env.turn = int(turn);
+ env.levz = levz;
+ env.weather = weather;
  if (levz >= 0) {
-  ret = turn.sunlight();
-  ret += weather_data[weather].light_modifier;
+  const int sunlight = turn.sunlight();
+  env.natural_light = std::max(0.0f,
+                               float(sunlight + weather_data[weather].light_modifier));
+  env.ambient_light = sunlight - weather_data[weather].sight_penalty;
+ } else {	// Underground!
+  env.natural_light = 0;
+  env.ambient_light = 1;
  }
+ return env;
+}
 
- return std::max(0.0f, ret);
+float game::natural_light_level()
+{
+ return environment().natural_light;
 }
 
 unsigned char game::light_level()
@@ -2856,24 +2991,16 @@ unsigned char game::light_level()
  if(turn == latest_lightlevel_turn)
   return latest_lightlevel;
 
- int ret;
- if (levz < 0)	// Underground!
-  ret = 1;
- else {
-  ret = turn.sunlight();
-  ret -= weather_data[weather].sight_penalty;
- }
- for (int i = 0; i < events.size(); i++) {
-  // The EVENT_DIM event slowly dims the sky, then relights it
-  // EVENT_DIM has an occurance date of turn + 50, so the first 25 dim it
-  if (events[i].type == EVENT_DIM) {
-   int turns_left = events[i].turn - int(turn);
-   i = events.size();
-   if (turns_left > 25)
-    ret = (ret * (turns_left - 25)) / 25;
-   else
-    ret = (ret * (25 - turns_left)) / 25;
-  }
+ int ret = environment().ambient_light;
+ // The EVENT_DIM event slowly dims the sky, then relights it
+ // EVENT_DIM has an occurance date of turn + 50, so the first 25 dim it
+ const event *dim = events.find(EVENT_DIM);
+ if (dim != NULL) {
+  int turns_left = dim->turn - int(turn);
+  if (turns_left > 25)
+   ret = (ret * (turns_left - 25)) / 25;
+  else
+   ret = (ret * (25 - turns_left)) / 25;
  }
  int flashlight = u.active_item_charges(itm_flashlight_on);
  if (ret < 10 && flashlight > 0) {
@@ -3314,21 +3441,17 @@ void game::mon_info()
   }
  }
 
- wrefresh(w_moninfo);
- refresh();
+ refresh_window(w_moninfo);
+ refresh_window(stdscr);
 }
 
 void game::cleanup_dead()
 {
  for (int i = 0; i < z.size(); i++) {
   if (z[i].dead || z[i].hp <= 0) {
-   z.erase(z.begin() + i);
+   z.remove(i);
    i--;
   }
-  if (last_target == i)
-   last_target = -1;
-  else if (last_target > i)
-    last_target--;
  }
 
  for (int i = 0; i < active_npc.size(); i++) {
@@ -3342,6 +3465,25 @@ void game::cleanup_dead()
 void game::monmove()
 {
  cleanup_dead();
+// Monsters with nothing in reach to notice for a few turns go dormant and
+//  only act every MONSTER_DORMANT_RATE turns; anything that stimulates them
+//  (see monster::unstimulated()) wakes them straight away.
+ int perception = light_level();
+ if (lm.at(0, 0) >= LL_LOW)
+  perception = DAYLIGHT_LEVEL; // Same as sees_u()
+ if (perception < SEEX)
+  perception = SEEX; // Keep everything close by awake, e.g. for bio_alarm
+ std::vector<point> targets;
+ targets.push_back(point(u.posx, u.posy));
+ for (int i = 0; i < active_npc.size(); i++) {
+  if (!active_npc[i].dead)
+   targets.push_back(point(active_npc[i].posx, active_npc[i].posy));
+ }
+ for (int i = 0; i < z.size(); i++) {
+  if (z[i].friendly != 0 && !z[i].dead)
+   targets.push_back(point(z[i].posx, z[i].posy));
+ }
+
  for (int i = 0; i < z.size(); i++) {
   if (i < 0 || i > z.size())
   {
@@ -3377,6 +3519,14 @@ void game::monmove()
     z[i].dead = true;
   }
 
+  if (z[i].unstimulated(this, targets, perception))
+   z[i].idle_turns++;
+  else
+   z[i].idle_turns = 0;
+  if (!z[i].dead && z[i].idle_turns > MONSTER_IDLE_TURNS &&
+      (int(turn) + z.handle_at(i)) % MONSTER_DORMANT_RATE != 0)
+   continue;
+
   if (!z[i].dead) {
    z[i].process_effects(this);
    if (z[i].hurt(0))
@@ -3420,7 +3570,7 @@ void game::monmove()
      if (cur_om.zg[group].population / pow(cur_om.zg[group].radius, 2.0) > 5 &&
          !cur_om.zg[group].diffuse )
       cur_om.zg[group].radius++;
-    } else if (MonsterGroupManager::Monster2Group((mon_id)(z[i].type->id)) != "GROUP_NULL") {
+    } else if (MonsterGroupManager::Monster2Group((mon_id)(z[i].type->id)) != 0) {
      cur_om.zg.push_back(mongroup(MonsterGroupManager::Monster2Group((mon_id)(z[i].type->id)),
                                   levx, levy, levz, 1, 1));
     }
@@ -3433,6 +3583,7 @@ void game::monmove()
  cleanup_dead();
 
 // Now, do active NPCs.
+ npc_snapshot.clear();
  for (int i = 0; i < active_npc.size(); i++) {
   int turns = 0;
   if(active_npc[i].hp_cur[hp_head] <= 0 || active_npc[i].hp_cur[hp_torso] <= 0)
@@ -3466,7 +3617,10 @@ void game::sound(int x, int y, int vol, std::string description)
    z[i].process_trigger(MTRIG_SOUND, volume);
   }
  }
-// Loud sounds make the next spawn sooner!
+// Loud sounds draw in hordes from the overmap...
+ if (vol >= SEEX * 2)
+  cur_om.signal_hordes(levx + x / SEEX, levy + y / SEEY, levz, vol / SEEX);
+// ...and make the next spawn sooner!
  int spawn_range = int(MAPSIZE / 2) * SEEX;
  if (vol >= spawn_range) {
   int max = (vol - spawn_range);
@@ -3569,10 +3723,93 @@ void game::draw_footsteps()
                       VIEWX + footsteps[i].x - u.posx - u.view_offset_x, c_yellow, '?');
  }
  footsteps.clear();
- wrefresh(w_terrain);
+ refresh_window(w_terrain);
  return;
 }
 
+// A square within an explosion's radius, with its distance from the centre
+struct blast_square
+{
+ int dx, dy, dist;
+ blast_square(int DX, int DY, int DIST) : dx (DX), dy (DY), dist (DIST) {};
+};
+
+#define BLAST_TEMPLATE_MAX 20 // Bigger blasts are rare; build them as needed
+
+// The squares an explosion of a given radius covers, in the order they're hit.
+// Radii up to BLAST_TEMPLATE_MAX are built once and kept, bigger ones are built
+//  into scratch each time.
+static const std::vector<blast_square>& blast_template(int radius,
+                                         std::vector<blast_square> &scratch)
+{
+ static std::vector<blast_square> templates[BLAST_TEMPLATE_MAX + 1];
+ std::vector<blast_square> &squares =
+  (radius <= BLAST_TEMPLATE_MAX ? templates[radius] : scratch);
+ if (!squares.empty())
+  return squares;
+ for (int i = -radius; i <= radius; i++) {
+  for (int j = -radius; j <= radius; j++)
+   squares.push_back(blast_square(i, j, rl_dist(0, 0, i, j)));
+ }
+ return squares;
+}
+
+// Who stood in reach of an explosion when it went off, by square, so the
+//  blast and its shrapnel don't scan every monster and NPC per square.
+creature_area::creature_area(game *g, int X, int Y, int R) : x (X), y (Y),
+ reach (R), side (2 * R + 1), mon (side * side, -1), npc (side * side, -1),
+ mon_pushes (g->z.push_count()), npc_count (g->active_npc.size())
+{
+ for (int i = 0; i < g->z.size(); i++) {
+  int c = cell(g->z[i].posx, g->z[i].posy);
+  if (c != -1 && mon[c] == -1)
+   mon[c] = i;
+ }
+ for (int i = 0; i < g->active_npc.size(); i++) {
+  int c = cell(g->active_npc[i].posx, g->active_npc[i].posy);
+  if (c != -1 && npc[c] == -1 && !g->active_npc[i].dead)
+   npc[c] = i;
+ }
+}
+
+int creature_area::cell(int X, int Y) const
+{
+ if (abs(X - x) > reach || abs(Y - y) > reach)
+  return -1;
+ return (Y - y + reach) * side + X - x + reach;
+}
+
+// Same as game::mon_at(); deaths can reorder g->z, so check before trusting.
+// Monsters may also spawn mid-burst (a blob splitting), anywhere.
+int creature_area::mon_at(game *g, int X, int Y) const
+{
+ int c = cell(X, Y);
+ if (c == -1)
+  return g->mon_at(X, Y);
+ int i = mon[c];
+ if (i == -1)
+  return (g->z.push_count() == mon_pushes ? -1 : g->mon_at(X, Y));
+ if (i < g->z.size() && g->z[i].posx == X && g->z[i].posy == Y)
+  return (g->z[i].dead ? -1 : i);
+ return g->mon_at(X, Y);
+}
+
+int creature_area::npc_at(game *g, int X, int Y) const
+{
+ int c = cell(X, Y);
+ if (c == -1)
+  return g->npc_at(X, Y);
+ int i = npc[c];
+ if (i == -1)
+  return (g->active_npc.size() == npc_count ? -1 : g->npc_at(X, Y));
+ if (i < g->active_npc.size() && g->active_npc[i].posx == X &&
+     g->active_npc[i].posy == Y)
+  return (g->active_npc[i].dead ? -1 : i);
+ return g->npc_at(X, Y);
+}
+
+// Each square of the blast template is bashed, then whoever stands on it is
+//  hurt, then it's set alight, one square at a time.
 void game::explosion(int x, int y, int power, int shrapnel, bool fire)
 {
  timespec ts;	// Timespec for the animation of the explosion
@@ -3587,64 +3824,64 @@ void game::explosion(int x, int y, int power, int shrapnel, bool fire)
   sound(x, y, noise, "a huge explosion!");
  else
   sound(x, y, noise, "an explosion!");
- for (int i = x - radius; i <= x + radius; i++) {
-  for (int j = y - radius; j <= y + radius; j++) {
-   if (i == x && j == y)
-    dam = 3 * power;
-   else
-    dam = 3 * power / (rl_dist(x, y, i, j));
-   if (m.has_flag(bashable, i, j))
-    m.bash(i, j, dam, junk);
-   if (m.has_flag(bashable, i, j))	// Double up for tough doors, etc.
-    m.bash(i, j, dam, junk);
-   if (m.is_destructable(i, j) && rng(25, 100) < dam)
-    m.destroy(this, i, j, false);
-
-   int mon_hit = mon_at(i, j), npc_hit = npc_at(i, j);
-   if (mon_hit != -1 && !z[mon_hit].dead &&
-       z[mon_hit].hurt(rng(dam / 2, dam * 1.5))) {
-    if (z[mon_hit].hp < 0 - 1.5 * z[mon_hit].type->hp)
-     explode_mon(mon_hit); // Explode them if it was big overkill
-    else
-     kill_mon(mon_hit); // TODO: player's fault?
 
-    int vpart;
-    vehicle *veh = m.veh_at(i, j, vpart);
-    if (veh)
-     veh->damage (vpart, dam, false);
-   }
+ std::vector<blast_square> scratch;
+ const std::vector<blast_square> &blast = blast_template(radius, scratch);
+ const creature_area area(this, x, y, 2 * radius); // Shrapnel flies twice as far
+ for (int n = 0; n < blast.size(); n++) {
+  const int i = x + blast[n].dx, j = y + blast[n].dy;
+  dam = 3 * power / (blast[n].dist == 0 ? 1 : blast[n].dist);
+  if (m.has_flag(bashable, i, j))
+   m.bash(i, j, dam, junk);
+  if (m.has_flag(bashable, i, j))	// Double up for tough doors, etc.
+   m.bash(i, j, dam, junk);
+  if (m.is_destructable(i, j) && rng(25, 100) < dam)
+   m.destroy(this, i, j, false);
+
+  int mon_hit = area.mon_at(this, i, j), npc_hit = area.npc_at(this, i, j);
+  if (mon_hit != -1 && z[mon_hit].hurt(rng(dam / 2, dam * 1.5))) {
+   if (z[mon_hit].hp < 0 - 1.5 * z[mon_hit].type->hp)
+    explode_mon(mon_hit); // Explode them if it was big overkill
+   else
+    kill_mon(mon_hit); // TODO: player's fault?
 
-   if (npc_hit != -1) {
-    active_npc[npc_hit].hit(this, bp_torso, 0, rng(dam / 2, dam * 1.5), 0);
-    active_npc[npc_hit].hit(this, bp_head,  0, rng(dam / 3, dam),       0);
-    active_npc[npc_hit].hit(this, bp_legs,  0, rng(dam / 3, dam),       0);
-    active_npc[npc_hit].hit(this, bp_legs,  1, rng(dam / 3, dam),       0);
-    active_npc[npc_hit].hit(this, bp_arms,  0, rng(dam / 3, dam),       0);
-    active_npc[npc_hit].hit(this, bp_arms,  1, rng(dam / 3, dam),       0);
-    if (active_npc[npc_hit].hp_cur[hp_head]  <= 0 ||
-        active_npc[npc_hit].hp_cur[hp_torso] <= 0   ) {
-     active_npc[npc_hit].die(this, true);
-     //active_npc.erase(active_npc.begin() + npc_hit);
-    }
-   }
-   if (u.posx == i && u.posy == j) {
-    add_msg("You're caught in the explosion!");
-    u.hit(this, bp_torso, 0, rng(dam / 2, dam * 1.5), 0);
-    u.hit(this, bp_head,  0, rng(dam / 3, dam),       0);
-    u.hit(this, bp_legs,  0, rng(dam / 3, dam),       0);
-    u.hit(this, bp_legs,  1, rng(dam / 3, dam),       0);
-    u.hit(this, bp_arms,  0, rng(dam / 3, dam),       0);
-    u.hit(this, bp_arms,  1, rng(dam / 3, dam),       0);
-   }
-   if (fire) {
-    if (m.field_at(i, j).type == fd_smoke)
-     m.field_at(i, j) = field(fd_fire, 1, 0);
-    m.add_field(this, i, j, fd_fire, dam / 10);
+   int vpart;
+   vehicle *veh = m.veh_at(i, j, vpart);
+   if (veh)
+    veh->damage (vpart, dam, false);
+  }
+
+  if (npc_hit != -1) {
+   active_npc[npc_hit].hit(this, bp_torso, 0, rng(dam / 2, dam * 1.5), 0);
+   active_npc[npc_hit].hit(this, bp_head,  0, rng(dam / 3, dam),       0);
+   active_npc[npc_hit].hit(this, bp_legs,  0, rng(dam / 3, dam),       0);
+   active_npc[npc_hit].hit(this, bp_legs,  1, rng(dam / 3, dam),       0);
+   active_npc[npc_hit].hit(this, bp_arms,  0, rng(dam / 3, dam),       0);
+   active_npc[npc_hit].hit(this, bp_arms,  1, rng(dam / 3, dam),       0);
+   if (active_npc[npc_hit].hp_cur[hp_head]  <= 0 ||
+       active_npc[npc_hit].hp_cur[hp_torso] <= 0   ) {
+    active_npc[npc_hit].die(this, true);
+    //active_npc.erase(active_npc.begin() + npc_hit);
    }
   }
+  if (u.posx == i && u.posy == j) {
+   add_msg("You're caught in the explosion!");
+   u.hit(this, bp_torso, 0, rng(dam / 2, dam * 1.5), 0);
+   u.hit(this, bp_head,  0, rng(dam / 3, dam),       0);
+   u.hit(this, bp_legs,  0, rng(dam / 3, dam),       0);
+   u.hit(this, bp_legs,  1, rng(dam / 3, dam),       0);
+   u.hit(this, bp_arms,  0, rng(dam / 3, dam),       0);
+   u.hit(this, bp_arms,  1, rng(dam / 3, dam),       0);
+  }
+  if (fire) {
+   if (m.field_at(i, j).type == fd_smoke)
+    m.field_at(i, j) = field(fd_fire, 1, 0);
+   m.add_field(this, i, j, fd_fire, dam / 10);
+  }
  }
 // Draw the explosion
- for (int i = 1; i <= radius; i++) {
+ const bool animate = animations_enabled();
+ for (int i = 1; animate && i <= radius; i++) {
   mvwputch(w_terrain, y - i + VIEWY - u.posy - u.view_offset_y,
                       x - i + VIEWX - u.posx - u.view_offset_x, c_red, '/');
   mvwputch(w_terrain, y - i + VIEWY - u.posy - u.view_offset_y,
@@ -3678,14 +3915,14 @@ void game::explosion(int x, int y, int power, int shrapnel, bool fire)
   sx = rng(x - 2 * radius, x + 2 * radius);
   sy = rng(y - 2 * radius, y + 2 * radius);
   if (m.sees(x, y, sx, sy, 50, t))
-   traj = line_to(x, y, sx, sy, t);
+   line_to(x, y, sx, sy, t, traj);
   else
-   traj = line_to(x, y, sx, sy, 0);
+   line_to(x, y, sx, sy, 0, traj);
   dam = rng(20, 60);
   for (int j = 0; j < traj.size(); j++) {
-   if (j > 0 && u_see(traj[j - 1].x, traj[j - 1].y, ijunk))
+   if (animate && j > 0 && u_see(traj[j - 1].x, traj[j - 1].y, ijunk))
     m.drawsq(w_terrain, u, traj[j - 1].x, traj[j - 1].y, false, true);
-   if (u_see(traj[j].x, traj[j].y, ijunk)) {
+   if (animate && u_see(traj[j].x, traj[j].y, ijunk)) {
     mvwputch(w_terrain, traj[j].y + VIEWY - u.posy - u.view_offset_y,
                         traj[j].x + VIEWX - u.posx - u.view_offset_x, c_red, '`');
     wrefresh(w_terrain);
@@ -3693,17 +3930,17 @@ void game::explosion(int x, int y, int power, int shrapnel, bool fire)
    }
    tx = traj[j].x;
    ty = traj[j].y;
-   if (mon_at(tx, ty) != -1) {
-    dam -= z[mon_at(tx, ty)].armor_cut();
-    if (z[mon_at(tx, ty)].hurt(dam))
-     kill_mon(mon_at(tx, ty));
-   } else if (npc_at(tx, ty) != -1) {
+   int mondex = area.mon_at(this, tx, ty), npcdex = -1;
+   if (mondex != -1) {
+    dam -= z[mondex].armor_cut();
+    if (z[mondex].hurt(dam))
+     kill_mon(mondex);
+   } else if ((npcdex = area.npc_at(this, tx, ty)) != -1) {
     body_part hit = random_body_part();
     if (hit == bp_eyes || hit == bp_mouth || hit == bp_head)
      dam = rng(2 * dam, 5 * dam);
     else if (hit == bp_torso)
      dam = rng(1.5 * dam, 3 * dam);
-    int npcdex = npc_at(tx, ty);
     active_npc[npcdex].hit(this, hit, rng(0, 1), 0, dam);
     if (active_npc[npcdex].hp_cur[hp_head] <= 0 ||
         active_npc[npcdex].hp_cur[hp_torso] <= 0) {
@@ -3818,7 +4055,7 @@ void game::resonance_cascade(int x, int y)
    case 13:
    case 14:
    case 15:
-    spawn = MonsterGroupManager::GetMonsterFromGroup("GROUP_NETHER", &mtypes);
+    spawn = MonsterGroupManager::GetMonsterFromGroup("GROUP_NETHER");
     invader = monster(mtypes[spawn], i, j);
     z.push_back(invader);
     break;
@@ -3849,7 +4086,7 @@ void game::emp_blast(int x, int y)
  int rn;
  if (m.has_flag(console, x, y)) {
   add_msg("The %s is rendered non-functional!", m.tername(x, y).c_str());
-  m.ter(x, y) = t_console_broken;
+  m.ter_set(x, y, t_console_broken);
   return;
  }
 // TODO: More terrain effects.
@@ -3859,14 +4096,14 @@ void game::emp_blast(int x, int y)
   rn = rng(1, 100);
   if (rn > 92 || rn < 40) {
    add_msg("The card reader is rendered non-functional.");
-   m.ter(x, y) = t_card_reader_broken;
+   m.ter_set(x, y, t_card_reader_broken);
   }
   if (rn > 80) {
    add_msg("The nearby doors slide open!");
    for (int i = -3; i <= 3; i++) {
     for (int j = -3; j <= 3; j++) {
      if (m.ter(x + i, y + j) == t_door_metal_locked)
-      m.ter(x + i, y + j) = t_floor;
+      m.ter_set(x + i, y + j, t_floor);
     }
    }
   }
@@ -4007,9 +4244,10 @@ void game::explode_mon(int index)
    }
 
    int posx = z[index].posx, posy = z[index].posy;
+   std::vector<point> traj;
    for (int i = 0; i < num_chunks; i++) {
     int tarx = posx + rng(-3, 3), tary = posy + rng(-3, 3);
-    std::vector<point> traj = line_to(posx, posy, tarx, tary, 0);
+    line_to(posx, posy, tarx, tary, 0, traj);
 
     bool done = false;
     for (int j = 0; j < traj.size() && !done; j++) {
@@ -4045,11 +4283,7 @@ void game::explode_mon(int index)
   }
  }
 
- z.erase(z.begin()+index);
- if (last_target == index)
-  last_target = -1;
- else if (last_target > index)
-   last_target--;
+ z.remove(index);
 }
 
 void game::open()
@@ -4124,7 +4358,7 @@ void game::close()
    veh->parts[vpart].open = 0;
    veh->insides_dirty = true;
    didit = true;
-  } else if (m.i_at(closex, closey).size() > 0)
+  } else if (!m.i_peek(closex, closey).empty())
    add_msg("There's %s in the way!", m.i_at(closex, closey).size() == 1 ?
            m.i_at(closex, closey)[0].tname(this).c_str() : "some stuff");
   else if (closex == u.posx && closey == u.posy)
@@ -4458,7 +4692,7 @@ void game::open_gate( game *g, const int examx, const int examy, const enum ter_
      if (g->m.ter(examx-1, examy+y_offst) == floor_type) x_incr = -1;
      int cur_x = examx+x_incr;
      while (g->m.ter(cur_x, examy+y_offst)== floor_type) {
-       g->m.ter(cur_x, examy+y_offst) = door_type;
+       g->m.ter_set(cur_x, examy+y_offst, door_type);
        cur_x = cur_x+x_incr;
      }
      //vertical orientation of the gate
@@ -4471,7 +4705,7 @@ void game::open_gate( game *g, const int examx, const int examy, const enum ter_
      if (g->m.ter(examx+x_offst, examy+1)== floor_type) y_incr = 1;
      int cur_y = examy+y_incr;
      while (g->m.ter(examx+x_offst, cur_y)==floor_type) {
-       g->m.ter(examx+x_offst, cur_y) = door_type;
+       g->m.ter_set(examx+x_offst, cur_y, door_type);
        cur_y = cur_y+y_incr;
      }
    }
@@ -4493,7 +4727,7 @@ void game::open_gate( game *g, const int examx, const int examy, const enum ter_
      if (g->m.ter(examx-1, examy+y_offst) == floor_type) x_incr = -1;
      int cur_x = examx+x_incr;
      while (g->m.ter(cur_x, examy+y_offst)== floor_type) {
-       g->m.ter(cur_x, examy+y_offst) = door_type;
+       g->m.ter_set(cur_x, examy+y_offst, door_type);
        cur_x = cur_x+x_incr;
      }
  //vertical orientation of the gate
@@ -4506,7 +4740,7 @@ void game::open_gate( game *g, const int examx, const int examy, const enum ter_
      if (g->m.ter(examx+x_offst, examy+1)== floor_type) y_incr = 1;
      int cur_y = examy+y_incr;
      while (g->m.ter(examx+x_offst, cur_y)==floor_type) {
-       g->m.ter(examx+x_offst, cur_y) = door_type;
+       g->m.ter_set(examx+x_offst, cur_y, door_type);
        cur_y = cur_y+y_incr;
      }
    }
@@ -4526,7 +4760,7 @@ void game::open_gate( game *g, const int examx, const int examy, const enum ter_
      if (g->m.ter(examx-1, examy+y_offst) == door_type) x_incr = -1;
      int cur_x = examx+x_incr;
      while (g->m.ter(cur_x, examy+y_offst)==door_type) {
-       g->m.ter(cur_x, examy+y_offst) = floor_type;
+       g->m.ter_set(cur_x, examy+y_offst, floor_type);
        cur_x = cur_x+x_incr;
      }
      //vertical orientation of the gate
@@ -4539,7 +4773,7 @@ void game::open_gate( game *g, const int examx, const int examy, const enum ter_
      if (g->m.ter(examx+x_offst, examy+1)== door_type) y_incr = 1;
      int cur_y = examy+y_incr;
      while (g->m.ter(examx+x_offst, cur_y)==door_type) {
-       g->m.ter(examx+x_offst, cur_y) = floor_type;
+       g->m.ter_set(examx+x_offst, cur_y, floor_type);
        cur_y = cur_y+y_incr;
      }
    }
@@ -4615,7 +4849,7 @@ void game::examine()
  %s is firmly sealed.", m.tername(examx, examy).c_str());
   }
  } else {
-  if (m.i_at(examx, examy).size() == 0 && m.has_flag(container, examx, examy) &&
+  if (m.i_peek(examx, examy).empty() && m.has_flag(container, examx, examy) &&
       !(m.has_flag(swimmable, examx, examy) || m.ter(examx, examy) == t_toilet))
    add_msg("It is empty.");
   else
@@ -4698,7 +4932,7 @@ point game::look_around()
     mvwprintw(w_look, 1, 1, "%s; Movement cost %d", m.tername(lx, ly).c_str(),
                                                     m.move_cost(lx, ly) * 50);
    mvwprintw(w_look, 2, 1, "%s", m.features(lx, ly).c_str());
-   field tmpfield = m.field_at(lx, ly);
+   field tmpfield = m.field_peek(lx, ly);
    if (tmpfield.type != fd_null)
     mvwprintz(w_look, 4, 1, fieldlist[tmpfield.type].color[tmpfield.density-1],
               "%s", fieldlist[tmpfield.type].name[tmpfield.density-1].c_str());
@@ -4728,7 +4962,7 @@ point game::look_around()
      mvwprintw(w_look, 3, 1, "There is a %s there. Parts:", veh->name.c_str());
      veh->print_part_desc(w_look, 4, 48, veh_part);
      m.drawsq(w_terrain, u, lx, ly, true, true, lx, ly);
-   } else if (!m.has_flag(container, lx, ly) && m.i_at(lx, ly).size() > 0) {
+   } else if (!m.has_flag(container, lx, ly) && !m.i_peek(lx, ly).empty()) {
     mvwprintw(w_look, 3, 1, "There is a %s there.",
               m.i_at(lx, ly)[0].tname(this).c_str());
     if (m.i_at(lx, ly).size() > 1)
@@ -5067,7 +5301,7 @@ void game::pickup(int posx, int posy, int min)
              query_yn("Get items from %s?", veh->part_info(veh_part).name);
  }
 // Picking up water?
- if ((!from_veh) && m.i_at(posx, posy).size() == 0) {
+ if ((!from_veh) && m.i_peek(posx, posy).empty()) {
   if (m.has_flag(swimmable, posx, posy) || m.ter(posx, posy) == t_toilet || m.ter(posx, posy) == t_water_sh) {
    item water = m.water_from(posx, posy);
     // Try to handle first (bottling) drink after.
@@ -5114,15 +5348,19 @@ void game::pickup(int posx, int posy, int min)
       if(u.wear_item(this, &newit)){
        if (from_veh)
         veh->remove_item (veh_part, 0);
-       else
+       else {
         m.i_clear(posx, posy);
+        crafting_view_adjust(newit, -1);
+       }
       }
      } else if (query_yn("Drop your %s and pick up %s?",
                 u.weapon.tname(this).c_str(), newit.tname(this).c_str())) {
       if (from_veh)
        veh->remove_item (veh_part, 0);
-      else
+      else {
        m.i_clear(posx, posy);
+       crafting_view_adjust(newit, -1);
+      }
       m.add_item(posx, posy, u.remove_weapon());
       u.i_add(newit, this);
       u.wield(this, u.inv.size() - 1);
@@ -5140,8 +5378,10 @@ void game::pickup(int posx, int posy, int min)
     u.wield(this, u.inv.size() - 1);
     if (from_veh)
      veh->remove_item (veh_part, 0);
-    else
+    else {
      m.i_clear(posx, posy);
+     crafting_view_adjust(newit, -1);
+    }
     u.moves -= 100;
     add_msg("Wielding %c - %s", newit.invlet, newit.tname(this).c_str());
    }
@@ -5149,18 +5389,23 @@ void game::pickup(int posx, int posy, int min)
              (u.volume_carried() + newit.volume() > u.volume_capacity() - 2 ||
               newit.is_weap() || newit.is_gun())) {
    u.weapon = newit;
+   crafting_view_adjust(newit, 1);
    if (from_veh)
     veh->remove_item (veh_part, 0);
-   else
+   else {
     m.i_clear(posx, posy);
+    crafting_view_adjust(newit, -1);
+   }
    u.moves -= 100;
    add_msg("Wielding %c - %s", newit.invlet, newit.tname(this).c_str());
   } else {
    u.i_add(newit, this);
    if (from_veh)
     veh->remove_item (veh_part, 0);
-   else
+   else {
     m.i_clear(posx, posy);
+    crafting_view_adjust(newit, -1);
+   }
    u.moves -= 100;
    add_msg("%c - %s", newit.invlet, newit.tname(this).c_str());
   }
@@ -5317,16 +5562,20 @@ void game::pickup(int posx, int posy, int min)
        {
         if (from_veh)
          veh->remove_item (veh_part, curmit);
-        else
+        else {
          m.i_rem(posx, posy, curmit);
+         crafting_view_adjust(here[i], -1);
+        }
         curmit--;
        }
       } else if (query_yn("Drop your %s and pick up %s?",
                 u.weapon.tname(this).c_str(), here[i].tname(this).c_str())) {
        if (from_veh)
         veh->remove_item (veh_part, curmit);
-       else
+       else {
         m.i_rem(posx, posy, curmit);
+        crafting_view_adjust(here[i], -1);
+       }
        m.add_item(posx, posy, u.remove_weapon());
        u.i_add(here[i], this);
        u.wield(this, u.inv.size() - 1);
@@ -5345,8 +5594,10 @@ void game::pickup(int posx, int posy, int min)
      u.wield(this, u.inv.size() - 1);
      if (from_veh)
       veh->remove_item (veh_part, curmit);
-     else
+     else {
       m.i_rem(posx, posy, curmit);
+      crafting_view_adjust(here[i], -1);
+     }
      curmit--;
      u.moves -= 100;
     }
@@ -5354,18 +5605,23 @@ void game::pickup(int posx, int posy, int min)
             (u.volume_carried() + here[i].volume() > u.volume_capacity() - 2 ||
               here[i].is_weap() || here[i].is_gun())) {
     u.weapon = here[i];
+    crafting_view_adjust(here[i], 1);
     if (from_veh)
      veh->remove_item (veh_part, curmit);
-    else
+    else {
      m.i_rem(posx, posy, curmit);
+     crafting_view_adjust(here[i], -1);
+    }
     u.moves -= 100;
     curmit--;
    } else {
     u.i_add(here[i], this);
     if (from_veh)
      veh->remove_item (veh_part, curmit);
-    else
+    else {
      m.i_rem(posx, posy, curmit);
+     crafting_view_adjust(here[i], -1);
+    }
     u.moves -= 100;
     curmit--;
    }
@@ -5636,9 +5892,10 @@ void game::drop(char chInput)
   int index = u.inv.index_by_letter(chInput);
 
   if (index == -1) {
-   dropped.push_back(u.i_rem(chInput));
+   dropped.push_back(u.i_rem(chInput, this));
   } else {
    dropped.push_back(u.inv.remove_item(index));
+   crafting_view_adjust(dropped.back(), -1);
   }
  }
 
@@ -5693,6 +5950,7 @@ void game::drop(char chInput)
  if (!to_veh || vh_overflow)
   for (i = 0; i < dropped.size(); i++) {
     m.add_item(u.posx, u.posy, dropped[i]);
+    crafting_view_adjust(dropped[i], 1);
  }
 }
 
@@ -5764,14 +6022,18 @@ void game::drop_in_direction()
   bool vh_overflow = false;
   for (int i = 0; i < dropped.size(); i++) {
    vh_overflow = vh_overflow || !veh->add_item (veh_part, dropped[i]);
-   if (vh_overflow)
+   if (vh_overflow) {
     m.add_item(dirx, diry, dropped[i]);
+    crafting_view_adjust(dropped[i], 1);
+   }
   }
   if (vh_overflow)
    add_msg ("Trunk is full, so some items fall on the ground.");
  } else {
-  for (int i = 0; i < dropped.size(); i++)
+  for (int i = 0; i < dropped.size(); i++) {
    m.add_item(dirx, diry, dropped[i]);
+   crafting_view_adjust(dropped[i], 1);
+  }
  }
 }
 
@@ -5858,7 +6120,7 @@ void game::plthrow(char chInput)
                               z[i].posy >= y0 && z[i].posy <= y1) {
    mon_targets.push_back(z[i]);
    targetindices.push_back(i);
-   if (i == last_target)
+   if (z.handle_at(i) == last_target)
     passtarget = mon_targets.size() - 1;
    z[i].draw(w_terrain, u.posx, u.posy, true);
   }
@@ -5870,9 +6132,9 @@ void game::plthrow(char chInput)
  if (trajectory.size() == 0)
   return;
  if (passtarget != -1)
-  last_target = targetindices[passtarget];
+  last_target = z.handle_at(targetindices[passtarget]);
 
- u.i_rem(ch);
+ u.i_rem(ch, this);
  u.moves -= 125;
  u.practice("throw", 10);
 
@@ -5965,7 +6227,7 @@ void game::plfire(bool burst)
       z[i].friendly == 0 && u_see(&(z[i]), junk)) {
    mon_targets.push_back(z[i]);
    targetindices.push_back(i);
-   if (i == last_target)
+   if (z.handle_at(i) == last_target)
     passtarget = mon_targets.size() - 1;
    z[i].draw(w_terrain, u.posx, u.posy, true);
   }
@@ -5981,7 +6243,7 @@ void game::plfire(bool burst)
   return;
  }
  if (passtarget != -1) { // We picked a real live target
-  last_target = targetindices[passtarget]; // Make it our default for next time
+  last_target = z.handle_at(targetindices[passtarget]); // Make it our default for next time
   z[targetindices[passtarget]].add_effect(ME_HIT_BY_PLAYER, 100);
  }
 
@@ -6189,13 +6451,13 @@ void game::forage()
     add_msg("You found some wild veggies!");
     u.practice("survival", 10);
     m.add_item(u.activity.placement.x, u.activity.placement.y, this->itypes[itm_veggy_wild],0);
-    m.ter(u.activity.placement.x, u.activity.placement.y) = t_dirt;
+    m.ter_set(u.activity.placement.x, u.activity.placement.y, t_dirt);
   }
   else
   {
     add_msg("You didn't find anything.");
     if (!one_in(u.skillLevel("survival")))
-    m.ter(u.activity.placement.x, u.activity.placement.y) = t_dirt;
+    m.ter_set(u.activity.placement.x, u.activity.placement.y, t_dirt);
   }
 }
 
@@ -6206,7 +6468,7 @@ void game::eat(char chInput)
      query_yn("Eat underbrush?")) {
   u.moves -= 400;
   u.hunger -= 10;
-  m.ter(u.posx, u.posy) = t_grass;
+  m.ter_set(u.posx, u.posy, t_grass);
   add_msg("You eat the underbrush.");
   return;
  }
@@ -6736,8 +6998,8 @@ void game::plmove(int x, int y)
    return;
   }
 
-  if (m.field_at(x, y).is_dangerous() &&
-      !query_yn("Really step into that %s?", m.field_at(x, y).name().c_str()))
+  if (m.field_peek(x, y).is_dangerous() &&
+      !query_yn("Really step into that %s?", m.field_peek(x, y).name().c_str()))
    return;
 
 // no need to query if stepping into 'benign' traps
@@ -6813,9 +7075,9 @@ void game::plmove(int x, int y)
 // TODO: Make there a flag, instead of hard-coded to mon_turret
     if (z[mondex].type->id == mon_turret) {
      if (query_yn("Deactivate the turret?")) {
-      z.erase(z.begin() + mondex);
-      u.moves -= 100;
       m.add_item(z[mondex].posx, z[mondex].posy, itypes[itm_bot_turret], turn);
+      z.remove(mondex);
+      u.moves -= 100;
      }
      return;
     } else {
@@ -7209,11 +7471,11 @@ void game::vertical_move(int movez, bool force)
  u.posx = stairx;
  u.posy = stairy;
  if (rope_ladder)
-  m.ter(u.posx, u.posy) = t_rope_up;
+  m.ter_set(u.posx, u.posy, t_rope_up);
  if (m.ter(stairx, stairy) == t_manhole_cover) {
   m.add_item(stairx + rng(-1, 1), stairy + rng(-1, 1),
              itypes[itm_manhole_cover], 0);
-  m.ter(stairx, stairy) = t_manhole;
+  m.ter_set(stairx, stairy, t_manhole);
  }
 
  if (replace_monsters)
@@ -7407,6 +7669,36 @@ void game::set_adjacent_overmaps(bool from_scratch)
  }
 }
 
+// Spends sight points on each overmap square along a line, until they run out
+struct overmap_sight {
+ overmap *cur, *hori, *vert, *diag;
+ int z;
+ int sight_points;
+ bool operator()(int lx, int ly)
+ {
+  int cost = 0;
+  if (lx >= 0 && lx < OMAPX && ly >= 0 && ly < OMAPY)
+   cost = oterlist[cur->ter(lx, ly, z)].see_cost;
+  else if ((lx < 0 || lx >= OMAPX) && (ly < 0 || ly >= OMAPY)) {
+   if (lx < 0) lx += OMAPX;
+   else        lx -= OMAPX;
+   if (ly < 0) ly += OMAPY;
+   else        ly -= OMAPY;
+   cost = oterlist[diag->ter(lx, ly, z)].see_cost;
+  } else if (lx < 0 || lx >= OMAPX) {
+   if (lx < 0) lx += OMAPX;
+   else        lx -= OMAPX;
+   cost = oterlist[hori->ter(lx, ly, z)].see_cost;
+  } else if (ly < 0 || ly >= OMAPY) {
+   if (ly < 0) ly += OMAPY;
+   else        ly -= OMAPY;
+   cost = oterlist[vert->ter(lx, ly, z)].see_cost;
+  }
+  sight_points -= cost;
+  return sight_points >= 0;
+ }
+};
+
 void game::update_overmap_seen()
 {
  int omx = (levx + int(MAPSIZE / 2)) / 2, omy = (levy + int(MAPSIZE / 2)) / 2;
@@ -7417,30 +7709,15 @@ void game::update_overmap_seen()
  bool altered_om_vert = false, altered_om_diag = false, altered_om_hori = false;
  for (int x = omx - dist; x <= omx + dist; x++) {
   for (int y = omy - dist; y <= omy + dist; y++) {
-   std::vector<point> line = line_to(omx, omy, x, y, 0);
-   int sight_points = dist;
-   int cost = 0;
-   for (int i = 0; i < line.size() && sight_points >= 0; i++) {
-    int lx = line[i].x, ly = line[i].y;
-    if (lx >= 0 && lx < OMAPX && ly >= 0 && ly < OMAPY)
-     cost = oterlist[cur_om.ter(lx, ly, levz)].see_cost;
-    else if ((lx < 0 || lx >= OMAPX) && (ly < 0 || ly >= OMAPY)) {
-     if (lx < 0) lx += OMAPX;
-     else        lx -= OMAPX;
-     if (ly < 0) ly += OMAPY;
-     else        ly -= OMAPY;
-     cost = oterlist[om_diag->ter(lx, ly, levz)].see_cost;
-    } else if (lx < 0 || lx >= OMAPX) {
-     if (lx < 0) lx += OMAPX;
-     else        lx -= OMAPX;
-     cost = oterlist[om_hori->ter(lx, ly, levz)].see_cost;
-    } else if (ly < 0 || ly >= OMAPY) {
-     if (ly < 0) ly += OMAPY;
-     else        ly -= OMAPY;
-     cost = oterlist[om_vert->ter(lx, ly, levz)].see_cost;
-    }
-    sight_points -= cost;
-   }
+   overmap_sight sight;
+   sight.cur = &cur_om;
+   sight.hori = om_hori;
+   sight.vert = om_vert;
+   sight.diag = om_diag;
+   sight.z = levz;
+   sight.sight_points = dist;
+   walk_line(omx, omy, x, y, 0, sight);
+   int sight_points = sight.sight_points;
    if (sight_points >= 0) {
     int tmpx = x, tmpy = y;
     if (tmpx >= 0 && tmpx < OMAPX && tmpy >= 0 && tmpy < OMAPY)
@@ -7538,6 +7815,8 @@ void game::update_stair_monsters()
 
 void game::despawn_monsters(const bool stairs, const int shiftx, const int shifty)
 {
+// Spawn points to add, by the submap (levx/levy coordinates) they go in
+ std::map<tripoint, std::vector<spawn_point>, pointcomp> despawned;
  for (unsigned int i = 0; i < z.size(); i++) {
   // If either shift argument is non-zero, we're shifting.
   if(shiftx != 0 || shifty != 0) {
@@ -7556,16 +7835,11 @@ void game::despawn_monsters(const bool stairs, const int shiftx, const int shift
    // Static spawn, create a new spawn here.
    z[i].spawnmapx = levx + z[i].posx / SEEX;
    z[i].spawnmapy = levy + z[i].posy / SEEY;
-   tinymap tmp(&itypes, &mapitems, &traps);
-   tmp.load(this, z[i].spawnmapx, z[i].spawnmapy, levz, false);
-   tmp.add_spawn(&(z[i]));
-   tmp.save(&cur_om, turn, z[i].spawnmapx, z[i].spawnmapy, levz);
+   despawned[tripoint(z[i].spawnmapx, z[i].spawnmapy, levz)].push_back(
+    map::spawn_point_of(&(z[i])));
   } else if ((stairs || shiftx != 0 || shifty != 0) && z[i].friendly < 0) {
    // Friendly, make it into a static spawn.
-   tinymap tmp(&itypes, &mapitems, &traps);
-   tmp.load(this, levx, levy, levz, false);
-   tmp.add_spawn(&(z[i]));
-   tmp.save(&cur_om, turn, levx, levy, levz);
+   despawned[tripoint(levx, levy, levz)].push_back(map::spawn_point_of(&(z[i])));
   } else {
    	// No spawn site, so absorb them back into a group.
    int group = valid_group((mon_id)(z[i].type->id), levx + shiftx, levy + shifty, levz);
@@ -7578,10 +7852,28 @@ void game::despawn_monsters(const bool stairs, const int shiftx, const int shift
   }
   // Shifting needs some cleanup for despawned monsters since they won't be cleared afterwards.
   if(shiftx != 0 || shifty != 0) {
-    z.erase(z.begin()+i);
+    z.remove(i);
     i--;
   }
  }
+
+// Submaps the monsters just left are in the mapbuffer; only one that was
+//  never generated needs a map loaded to create it.
+ for (std::map<tripoint, std::vector<spawn_point>, pointcomp>::iterator it =
+       despawned.begin(); it != despawned.end(); it++) {
+  const tripoint &p = it->first;
+  const int absx = cur_om.pos().x * OMAPX * 2 + p.x,
+            absy = cur_om.pos().y * OMAPY * 2 + p.y;
+  submap *sm = MAPBUFFER.lookup_submap(absx, absy, p.z);
+  if (sm == NULL) {
+   tinymap tmp(&itypes, &mapitems, &traps);
+   tmp.load(this, p.x, p.y, p.z, false);
+   tmp.save(&cur_om, turn, p.x, p.y, p.z);
+   sm = MAPBUFFER.lookup_submap(absx, absy, p.z);
+  }
+  if (sm != NULL)
+   sm->spawns.insert(sm->spawns.end(), it->second.begin(), it->second.end());
+ }
 }
 
 void game::spawn_mon(int shiftx, int shifty)
@@ -7613,75 +7905,72 @@ void game::spawn_mon(int shiftx, int shifty)
   active_npc.push_back(tmp);
  }
 
-// Now, spawn monsters (perhaps)
+// Now, spawn monsters (perhaps) from the groups reaching the new bubble.
+// Go backwards, so erasing a spent group doesn't move the ones still to do.
  monster zom;
- for (int i = 0; i < cur_om.zg.size(); i++) { // For each valid group...
- 	if (cur_om.zg[i].posz != levz) { continue; } // skip other levels - hack
+ std::vector<int> groups, dists;
+ cur_om.mongroups_overlapping(nlevx, nlevy, nlevx + MAPSIZE - 1,
+                              nlevy + MAPSIZE - 1, levz, groups, dists);
+ for (int g = groups.size() - 1; g >= 0; g--) {
+  const int i = groups[g];
   group = 0;
-  if(cur_om.zg[i].diffuse)
-   dist = rl_dist(nlevx, nlevy, cur_om.zg[i].posx, cur_om.zg[i].posy);
-  else
-   dist = trig_dist(nlevx, nlevy, cur_om.zg[i].posx, cur_om.zg[i].posy);
+  dist = dists[g];
   pop = cur_om.zg[i].population;
   rad = cur_om.zg[i].radius;
-  if (dist <= rad) {
 // (The area of the group's territory) in (population/square at this range)
 // chance of adding one monster; cap at the population OR 16
-   while ( (cur_om.zg[i].diffuse ?
-            long( pop) :
-            long((1.0 - double(dist / rad)) * pop) )
+  while ( (cur_om.zg[i].diffuse ?
+           long( pop) :
+           long((1.0 - double(dist / rad)) * pop) )
 	  > rng(0, pow(rad, 2.0)) &&
-          rng(0, MAPSIZE * 4) > group && group < pop && group < MAPSIZE * 3)
-    group++;
-
-   cur_om.zg[i].population -= group;
-   // Reduce group radius proportionally to remaining
-   // population to maintain a minimal population density.
-   if (cur_om.zg[i].population / pow(cur_om.zg[i].radius, 2.0) < 1.0 &&
-       !cur_om.zg[i].diffuse)
-     cur_om.zg[i].radius--;
-
-   if (group > 0) // If we spawned some zombies, advance the timer
-    nextspawn += rng(group * 4 + z.size() * 4, group * 10 + z.size() * 10);
-
-   for (int j = 0; j < group; j++) {	// For each monster in the group...
-     mon_id type = MonsterGroupManager::GetMonsterFromGroup(cur_om.zg[i].type, &mtypes, (int)turn);
-     zom = monster(mtypes[type]);
-     iter = 0;
-     do {
-      monx = rng(0, SEEX * MAPSIZE - 1);
-      mony = rng(0, SEEY * MAPSIZE - 1);
-      if (shiftx == 0 && shifty == 0) {
-       if (one_in(2))
-        shiftx = 1 - 2 * rng(0, 1);
-       else
-        shifty = 1 - 2 * rng(0, 1);
-      }
-      if (shiftx == -1)
-       monx = (SEEX * MAPSIZE) / 6;
-      else if (shiftx == 1)
-       monx = (SEEX * MAPSIZE * 5) / 6;
-      if (shifty == -1)
-       mony = (SEEY * MAPSIZE) / 6;
-      if (shifty == 1)
-       mony = (SEEY * MAPSIZE * 5) / 6;
-      monx += rng(-5, 5);
-      mony += rng(-5, 5);
-      iter++;
-
-     } while ((!zom.can_move_to(m, monx, mony) || !is_empty(monx, mony) ||
-                m.sees(u.posx, u.posy, monx, mony, SEEX, t) ||
-                rl_dist(u.posx, u.posy, monx, mony) < 8) && iter < 50);
-     if (iter < 50) {
-      zom.spawn(monx, mony);
-      z.push_back(zom);
+         rng(0, MAPSIZE * 4) > group && group < pop && group < MAPSIZE * 3)
+   group++;
+
+  cur_om.zg[i].population -= group;
+  // Reduce group radius proportionally to remaining
+  // population to maintain a minimal population density.
+  if (cur_om.zg[i].population / pow(cur_om.zg[i].radius, 2.0) < 1.0 &&
+      !cur_om.zg[i].diffuse)
+    cur_om.zg[i].radius--;
+
+  if (group > 0) // If we spawned some zombies, advance the timer
+   nextspawn += rng(group * 4 + z.size() * 4, group * 10 + z.size() * 10);
+
+  for (int j = 0; j < group; j++) {	// For each monster in the group...
+    mon_id type = MonsterGroupManager::GetMonsterFromGroup(cur_om.zg[i].type, (int)turn);
+    zom = monster(mtypes[type]);
+    iter = 0;
+    do {
+     monx = rng(0, SEEX * MAPSIZE - 1);
+     mony = rng(0, SEEY * MAPSIZE - 1);
+     if (shiftx == 0 && shifty == 0) {
+      if (one_in(2))
+       shiftx = 1 - 2 * rng(0, 1);
+      else
+       shifty = 1 - 2 * rng(0, 1);
      }
-   }	// Placing monsters of this group is done!
-   if (cur_om.zg[i].population <= 0) { // Last monster in the group spawned...
-    cur_om.zg.erase(cur_om.zg.begin() + i); // ...so remove that group
-    i--;	// And don't increment i.
-   }
-  }
+     if (shiftx == -1)
+      monx = (SEEX * MAPSIZE) / 6;
+     else if (shiftx == 1)
+      monx = (SEEX * MAPSIZE * 5) / 6;
+     if (shifty == -1)
+      mony = (SEEY * MAPSIZE) / 6;
+     if (shifty == 1)
+      mony = (SEEY * MAPSIZE * 5) / 6;
+     monx += rng(-5, 5);
+     mony += rng(-5, 5);
+     iter++;
+
+    } while ((rl_dist(u.posx, u.posy, monx, mony) < 8 ||
+              !zom.can_move_to(m, monx, mony) || !is_empty(monx, mony) ||
+              m.sees(u.posx, u.posy, monx, mony, SEEX, t)) && iter < 50);
+    if (iter < 50) {
+     zom.spawn(monx, mony);
+     z.push_back(zom);
+    }
+  }	// Placing monsters of this group is done!
+  if (cur_om.zg[i].population <= 0) // Last monster in the group spawned...
+   cur_om.zg.erase(cur_om.zg.begin() + i); // ...so remove that group
  }
 }
 
@@ -7758,10 +8047,11 @@ void game::write_msg()
  int maxlength = 80 - (SEEX * 2 + 10);	// Matches size of w_messages
  int line = 7;
  for (int i = messages.size() - 1; i >= 0 && line < 8; i--) {
-  std::string mes = messages[i].message;
-  if (messages[i].count > 1) {
+  const game_message &msg = messages[i];
+  std::string mes(msg.message, msg.length);
+  if (msg.count > 1) {
    std::stringstream mesSS;
-   mesSS << mes << " x " << messages[i].count;
+   mesSS << mes << " x " << msg.count;
    mes = mesSS.str();
   }
 // Split the message into many if we must!
@@ -7771,9 +8061,9 @@ void game::write_msg()
    if (split > maxlength)
     split = maxlength;
    nc_color col = c_dkgray;
-   if (int(messages[i].turn) >= curmes)
+   if (int(msg.turn) >= curmes)
     col = c_ltred;
-   else if (int(messages[i].turn) + 5 >= curmes)
+   else if (int(msg.turn) + 5 >= curmes)
     col = c_ltgray;
    //mvwprintz(w_messages, line, 0, col, mes.substr(0, split).c_str());
    mvwprintz(w_messages, line, 0, col, mes.substr(split + 1).c_str());
@@ -7783,16 +8073,16 @@ void game::write_msg()
   }
   if (line >= 0) {
    nc_color col = c_dkgray;
-   if (int(messages[i].turn) >= curmes)
+   if (int(msg.turn) >= curmes)
     col = c_ltred;
-   else if (int(messages[i].turn) + 5 >= curmes)
+   else if (int(msg.turn) + 5 >= curmes)
     col = c_ltgray;
    mvwprintz(w_messages, line, 0, col, mes.c_str());
    line--;
   }
  }
  curmes = int(turn);
- wrefresh(w_messages);
+ refresh_window(w_messages);
 }
 
 void game::msg_buffer()
@@ -7811,7 +8101,7 @@ void game::msg_buffer()
   int lasttime = -1;
   int i;
   for (i = 1; i <= 20 && line <= 23 && offset + i <= messages.size(); i++) {
-   game_message *mtmp = &(messages[ messages.size() - (offset + i) ]);
+   const game_message *mtmp = &(messages[ messages.size() - (offset + i) ]);
    calendar timepassed = turn - mtmp->turn;
 
    int tp = int(timepassed);
@@ -7919,14 +8209,14 @@ void game::nuke(int x, int y)
  for (int i = 0; i < SEEX * 2; i++) {
   for (int j = 0; j < SEEY * 2; j++) {
    if (!one_in(10))
-    tmpmap.ter(i, j) = t_rubble;
+    tmpmap.ter_set(i, j, t_rubble);
    if (one_in(3))
     tmpmap.add_field(NULL, i, j, fd_nuke_gas, 3);
    tmpmap.radiation(i, j) += rng(20, 80);
   }
  }
  tmpmap.save(&cur_om, turn, mapx, mapy, 0);
- cur_om.ter(x, y, 0) = ot_crater;
+ cur_om.ter_set(x, y, 0, ot_crater);
 }
 
 std::vector<faction *> game::factions_at(int x, int y)
@@ -69,6 +69,32 @@ enum quit_status {
  QUIT_DELETE_WORLD  // Quit and delete world
 };
 
+// Scheduled work in do_turn(), see game::turn_tasks
+enum turn_task {
+ TASK_METABOLISM, // Hunger, thirst and fatigue, every 5 minutes
+ TASK_HALF_HOUR,  // Pain, healing, sickness and autosave
+ TASK_MORALE,     // Every minute
+ TASK_MIDNIGHT,   // Overmap monster groups die out
+ TASK_WEATHER,    // Once, on nextweather
+ TASK_HORDES,     // Overmap hordes drift, every 3 minutes
+ TASK_SUBMAPS,    // Old submaps are evicted from memory, every minute
+ NUM_TURN_TASKS
+};
+
+// Light levels that only change with the turn, z-level and weather, worked
+//  out once and shared by everything that asks; see game::environment()
+struct environment_snapshot
+{
+ int turn;
+ int levz;
+ weather_type weather;
+ float natural_light; // natural_light_level()
+ int ambient_light;   // light_level() before events and carried lights
+
+ environment_snapshot() : turn(-1), levz(0), weather(WEATHER_NULL),
+                          natural_light(0), ambient_light(0) {};
+};
+
 struct monster_and_count
 {
  monster mon;
@@ -76,13 +102,35 @@ struct monster_and_count
  monster_and_count(monster M, int C) : mon (M), count (C) {};
 };
 
+#define MESSAGE_LOG_SIZE 256 // Messages kept for msg_buffer()
+#define MESSAGE_MAX_LEN 1024 // Longer messages are cut off
+
 struct game_message
 {
  calendar turn;
  int count;
- std::string message;
- game_message() { turn = 0; count = 1; message = ""; };
- game_message(calendar T, std::string M) : turn (T), message (M) { count = 1; };
+ int length;
+ char message[MESSAGE_MAX_LEN];
+ game_message() { turn = 0; count = 1; length = 0; message[0] = '\0'; };
+};
+
+// Fixed ring of the last MESSAGE_LOG_SIZE messages.  Messages are formatted
+//  straight into a spare slot, so adding one never allocates or shifts.
+class message_log
+{
+ public:
+  message_log();
+  void add(const calendar &turn, const char *msg, va_list ap);
+  void clear();
+  int size() const { return count; }
+  bool empty() const { return count == 0; }
+  const game_message& operator[](int i) const; // 0 is the oldest
+  const game_message& back() const { return (*this)[count - 1]; }
+
+ private:
+  game_message slots[MESSAGE_LOG_SIZE + 1]; // One spare to format into
+  int first;
+  int count;
 };
  
 struct mtype;
@@ -102,6 +150,7 @@ class game
   bool game_quit(); // True if we actually quit the game - used in main.cpp
   quit_status uquit;    // used in main.cpp to determine what type of quit
   void save();
+  void save_artifacts(); // Item types created since init_itypes()
   void delete_save();
   void cleanup_at_end();
   bool do_turn();
@@ -180,6 +229,7 @@ class game
   void nuke(int x, int y);
   std::vector<faction *> factions_at(int x, int y);
   int& scent(int x, int y);
+  const environment_snapshot &environment();
   float natural_light_level();
   unsigned char light_level();
   void reset_light_level();
@@ -191,6 +241,8 @@ class game
   bool u_see (monster *mon, int &t);
   bool pl_sees(player *p, monster *mon, int &t);
   void refresh_all();
+  void invalidate_lightmap(); // Forces the next draw_ter() to rebuild lm
+  bool animations_enabled(); // False without a screen or with no_animations
   void update_map(int &x, int &y);  // Called by plmove when the map updates
   void update_overmap_seen(); // Update which overmap tiles we can see
   point om_location(); // levx and levy converted to overmap coordinates
@@ -216,6 +268,11 @@ class game
   void remove_item(item *it);
 
   inventory crafting_inventory();  // inv_from_map, inv, & 'weapon'
+  const crafting_resources& crafting_view(); // Same, as per-type totals
+  bool crafting_view_current(); // Built this turn, here
+  void invalidate_crafting_view(); // Items changed behind its back
+  void crafting_view_adjust(const item &it, int sign); // it came or went
+  void available_recipes(std::vector<recipe*> &ret); // Craftable right now
   void consume_items(std::vector<component> components);
   void consume_tools(std::vector<component> tools);
 
@@ -244,10 +301,11 @@ class game
   light_map lm;
   int levx, levy, levz;	// Placement inside the overmap
   player u;
-  std::vector<monster> z;
+  monster_list z;
   std::vector<monster_and_count> coming_to_stairs;
   int monstairx, monstairy, monstairz;
   std::vector<npc> active_npc;
+  npc_turn_snapshot npc_snapshot; // Cleared each turn before NPCs move
   std::vector<faction> factions;
   std::vector<mission> active_missions; // Missions which may be assigned
 // NEW: Dragging a piece of furniture, with a list of items contained
@@ -399,6 +457,7 @@ class game
   void msg_buffer();       // Opens a window with old messages in it
   void draw_minimap();     // Draw the 5x5 minimap
   void draw_HP();          // Draws the player's HP and Power level
+  void refresh_window(WINDOW *w); // wnoutrefresh() while draw() batches
   int autosave_timeout();  // If autosave enabled, how long we should wait for user inaction before saving.
   void autosave();         // Saves map
 
@@ -418,7 +477,7 @@ class game
 
 // ########################## DATA ################################
 
-  signed char last_target;// The last monster targeted
+  int last_target;	// Handle of the last monster targeted, -1 for none
   char run_mode; // 0 - Normal run always; 1 - Running allowed, but if a new
 		 //  monsters spawns, go to 2 - No movement allowed
   int mostseen;	 // # of mons seen last turn; if this increases, run_mode++
@@ -429,12 +488,13 @@ class game
   calendar nextspawn; // The turn on which monsters will spawn next.
   calendar nextweather; // The turn on which weather will shift next.
   int next_npc_id, next_faction_id, next_mission_id; // Keep track of UIDs
-  std::vector <game_message> messages;   // Messages to be printed
+  message_log messages;   // Messages to be printed
   int curmes;	  // The last-seen message.
   int grscent[SEEX * MAPSIZE][SEEY * MAPSIZE];	// The scent map
   //int monmap[SEEX * MAPSIZE][SEEY * MAPSIZE]; // Temp monster map, for mon_at()
   int nulscent;				// Returned for OOB scent checks
-  std::vector<event> events;	        // Game events to be processed
+  event_queue events;	        // Game events to be processed
+  turn_scheduler turn_tasks;	// Periodic work, by turn_task
   int kills[num_monsters];	        // Player's kill count
   std::string last_action;		// The keypresses of last turn
 
@@ -442,8 +502,44 @@ class game
   int item_exchanges_since_save;
   unsigned char latest_lightlevel;
   calendar latest_lightlevel_turn;
+  environment_snapshot env;
 
   special_game *gamemode;
+
+  rng_stream monster_rng; // Random stream for monmove()
+  rng_stream field_rng;   // Random stream for map::process_fields()
+
+  crafting_resources crafting_res; // Cached by crafting_view()
+  crafting_resources crafting_res_prev; // The previous build, for diffing
+  recipe_index crafting_index; // Which recipes crafting_res satisfies
+  bool crafting_view_valid;
+  int crafting_view_turn;
+  point crafting_view_pos;
+
+  bool drawing_frame; // draw() is running; its windows go out in one doupdate()
+  bool lightmap_valid;
+  int lightmap_turn;
+  int lightmap_moves;
+  point lightmap_pos;
+  tripoint lightmap_lev;
+  float lightmap_natural;
+  float lightmap_luminance;
+};
+
+// Monsters and NPCs bucketed by square within reach of (x, y), for code that
+//  asks mon_at() and npc_at() about many squares in one go.  Squares out of
+//  reach, or whose creature has since moved or been reordered, fall back to
+//  the game's own lookups, as do empty squares once anyone has been added.
+struct creature_area
+{
+ int x, y, reach, side;
+ std::vector<int> mon, npc;
+ int mon_pushes, npc_count; // When we were built
+
+ creature_area(game *g, int X, int Y, int R);
+ int cell(int X, int Y) const;
+ int mon_at(game *g, int X, int Y) const;
+ int npc_at(game *g, int X, int Y) const;
 };
 
 #endif
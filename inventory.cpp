@@ -25,7 +25,7 @@ std::vector<item>& inventory::stack_at(int i)
  return items[i];
 }
 
-std::vector<item> inventory::const_stack(int i) const
+const std::vector<item>& inventory::const_stack(int i) const
 {
  if (i < 0 || i > items.size()) {
   debugmsg("Attempted to access stack %d in an inventory (size %d)",
@@ -35,14 +35,11 @@ std::vector<item> inventory::const_stack(int i) const
  return items[i];
 }
 
-std::vector<item> inventory::as_vector()
+void inventory::as_vector(std::vector<item> &ret) const
 {
- std::vector<item> ret;
- for (int i = 0; i < size(); i++) {
-  for (int j = 0; j < stack_at(i).size(); j++)
-   ret.push_back(items[i][j]);
- }
- return ret;
+ ret.reserve(ret.size() + num_items());
+ for (int i = 0; i < items.size(); i++)
+  ret.insert(ret.end(), items[i].begin(), items[i].end());
 }
 
 int inventory::size() const
@@ -121,46 +118,54 @@ void inventory::clear()
  items.clear();
 }
 
-void inventory::add_stack(const std::vector<item> newits)
+void inventory::add_stack(const std::vector<item> &newits)
 {
  for (int i = 0; i < newits.size(); i++)
   add_item(newits[i], true);
 }
 
-void inventory::push_back(std::vector<item> newits)
+void inventory::push_back(const std::vector<item> &newits)
 {
  add_stack(newits);
 }
 
-void inventory::add_item(item newit, bool keep_invlet)
+// newit is copied exactly once, into its final slot; any invlet fix-ups are
+// applied to that copy rather than to a temporary.
+void inventory::add_item(const item &newit, bool keep_invlet)
 {
- if (keep_invlet && !newit.invlet_is_okay())
-  assign_empty_invlet(newit); // Keep invlet is true, but invlet is invalid!
-
  if (newit.is_style())
   return; // Styles never belong in our inventory.
+
+ char invlet = newit.invlet;
+ if (keep_invlet && !newit.invlet_is_okay()) {
+  // Keep invlet is true, but invlet is invalid!
+  item tmp;
+  assign_empty_invlet(tmp);
+  invlet = tmp.invlet;
+ }
  for (int i = 0; i < items.size(); i++) {
   if (items[i][0].stacks_with(newit)) {
-    newit.invlet = items[i][0].invlet;
    items[i].push_back(newit);
+   items[i].back().invlet = items[i][0].invlet;
    return;
-  } else if (keep_invlet && items[i][0].invlet == newit.invlet)
+  } else if (keep_invlet && items[i][0].invlet == invlet)
    assign_empty_invlet(items[i][0]);
  }
- if (!newit.invlet_is_okay() || index_by_letter(newit.invlet) != -1)
-  assign_empty_invlet(newit);
 
- std::vector<item> newstack;
- newstack.push_back(newit);
- items.push_back(newstack);
+ items.push_back(std::vector<item>());
+ items.back().push_back(newit);
+ item &added = items.back().back();
+ added.invlet = invlet;
+ if (!added.invlet_is_okay() || index_by_letter(added.invlet) != items.size() - 1)
+  assign_empty_invlet(added);
 }
 
-void inventory::add_item_keep_invlet(item newit)
+void inventory::add_item_keep_invlet(const item &newit)
 {
  add_item(newit, true);
 }
 
-void inventory::push_back(item newit)
+void inventory::push_back(const item &newit)
 {
  add_item(newit);
 }
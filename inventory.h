@@ -13,8 +13,8 @@ class inventory
  public:
   item& operator[] (int i);
   std::vector<item>& stack_at(int i);
-  std::vector<item> const_stack(int i) const;
-  std::vector<item> as_vector();
+  const std::vector<item>& const_stack(int i) const;
+  void as_vector(std::vector<item> &ret) const;
   item& front();
   item& back();
   int size() const;
@@ -30,11 +30,11 @@ class inventory
   inventory  operator+  (const std::vector<item> &rhs);
 
   void clear();
-  void add_stack(std::vector<item> newits);
-  void push_back(std::vector<item> newits);
-  void add_item (item newit, bool keep_invlet = false);
-  void add_item_keep_invlet(item newit);
-  void push_back(item newit);
+  void add_stack(const std::vector<item> &newits);
+  void push_back(const std::vector<item> &newits);
+  void add_item (const item &newit, bool keep_invlet = false);
+  void add_item_keep_invlet(const item &newit);
+  void push_back(const item &newit);
 
 /* Check all items for proper stacking, rearranging as needed
  * game pointer is not necessary, but if supplied, will ensure no overlap with
@@ -477,8 +477,11 @@ std::vector<item> game::multidrop()
   current_stack++;
  }
 
+// Everything so far came out of the inventory; i_rem() reports the rest
+ for (int i = 0; i < ret.size(); i++)
+  crafting_view_adjust(ret[i], -1);
  for (int i = 0; i < weapon_and_armor.size(); i++)
-  ret.push_back(u.i_rem(weapon_and_armor[i]));
+  ret.push_back(u.i_rem(weapon_and_armor[i], this));
 
  return ret;
 }
@@ -144,6 +144,10 @@ void item::make_corpse(itype* it, mtype* mt, unsigned int turn)
 }
 
 itype * item::nullitem_m = new itype();
+
+#ifdef ITEM_COPY_STATS
+int item_copy_counter::copies = 0;
+#endif
 itype * item::nullitem()
 {
     return nullitem_m;
@@ -167,7 +171,7 @@ void item::make(itype* it)
  contents.clear();
 }
 
-bool item::is_null()
+bool item::is_null() const
 {
  return (type == NULL || type->id == 0);
 }
@@ -202,12 +206,12 @@ item item::in_its_container(std::vector<itype*> *itypes)
 
 }
 
-bool item::invlet_is_okay()
+bool item::invlet_is_okay() const
 {
  return ((invlet >= 'a' && invlet <= 'z') || (invlet >= 'A' && invlet <= 'Z'));
 }
 
-bool item::stacks_with(item rhs)
+bool item::stacks_with(const item &rhs)
 {
 
  bool stacks = (type   == rhs.type   && damage  == rhs.damage  &&
@@ -236,7 +240,7 @@ bool item::stacks_with(item rhs)
  return stacks;
 }
 
-void item::put_in(item payload)
+void item::put_in(const item &payload)
 {
  contents.push_back(payload);
 }
@@ -636,7 +640,7 @@ std::string item::info(bool showtext, std::vector<iteminfo> *dump)
  return temp1.str();
 }
 
-char item::symbol()
+char item::symbol() const
 {
  if( is_null() )
   return ' ';
@@ -809,7 +813,7 @@ std::string item::tname(game *g)
  return ret.str();
 }
 
-nc_color item::color()
+nc_color item::color() const
 {
  if (typeId() == itm_corpse)
   return corpse->color;
@@ -1129,7 +1133,7 @@ bool item::is_two_handed(player *u)
   return (weight() > u->str_cur * 4);
 }
 
-bool item::made_of(material mat)
+bool item::made_of(material mat) const
 {
  if( is_null() )
   return false;
@@ -1205,7 +1209,7 @@ bool item::is_bionic()
  return type->is_bionic();
 }
 
-bool item::is_ammo()
+bool item::is_ammo() const
 {
  if( is_null() )
   return false;
@@ -1347,7 +1351,7 @@ bool item::is_macguffin()
  return type->is_macguffin();
 }
 
-bool item::is_style()
+bool item::is_style() const
 {
  if( is_null() )
   return false;
@@ -1893,7 +1897,7 @@ std::ostream & operator<<(std::ostream & out, const item & it)
 }
 
 
-int item::typeId()
+int item::typeId() const
 {
     if (!type)
         return itm_null;
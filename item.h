@@ -10,6 +10,19 @@
 class player;
 class npc;
 
+#ifdef ITEM_COPY_STATS
+// Counts every item copy-construction and copy-assignment; reset and logged
+// once per turn by game::do_turn().
+struct item_copy_counter
+{
+ static int copies;
+ item_copy_counter() {}
+ item_copy_counter(const item_copy_counter &) { copies++; }
+ item_copy_counter& operator= (const item_copy_counter &)
+ { copies++; return *this; }
+};
+#endif
+
 struct iteminfo{
  public:
   std::string sType; //Itemtype
@@ -70,13 +83,13 @@ public:
  //std::string info(bool showtext = false);	// Formatted for human viewing
  std::string info(bool showtext = false);
  std::string info(bool showtext, std::vector<iteminfo> *dump);
- char symbol();
- nc_color color();
+ char symbol() const;
+ nc_color color() const;
  int price();
 
- bool invlet_is_okay();
- bool stacks_with(item rhs);
- void put_in(item payload);
+ bool invlet_is_okay() const;
+ bool stacks_with(const item &rhs);
+ void put_in(const item &payload);
 
  int weight();
  int volume();
@@ -102,11 +115,11 @@ public:
 // Returns the data associated with tech, if we are an it_style
  style_move style_data(technique_id tech);
  bool is_two_handed(player *u);
- bool made_of(material mat);
+ bool made_of(material mat) const;
  bool conductive(); // Electricity
  bool destroyed_at_zero_charges();
 // Most of the is_whatever() functions call the same function in our itype
- bool is_null(); // True if type is NULL, or points to the null item (id == 0)
+ bool is_null() const; // True if type is NULL, or points to the null item (id == 0)
  bool is_food(player *u);// Some non-food items are food to certain players
  bool is_food_container(player *u);  // Ditto
  bool is_food();                // Ignoring the ability to eat batteries, etc.
@@ -120,19 +133,19 @@ public:
  bool is_silent();
  bool is_gunmod();
  bool is_bionic();
- bool is_ammo();
+ bool is_ammo() const;
  bool is_armor();
  bool is_book();
  bool is_container();
  bool is_tool();
  bool is_software();
  bool is_macguffin();
- bool is_style();
+ bool is_style() const;
  bool is_other(); // Doesn't belong in other categories
  bool is_var_veh_part();
  bool is_artifact();
 
- int typeId();
+ int typeId() const;
 
  itype*   type;
  mtype*   corpse;
@@ -159,6 +172,10 @@ public:
 
  static itype * nullitem();
 
+#ifdef ITEM_COPY_STATS
+ item_copy_counter copy_counter;
+#endif
+
 private:
  static itype * nullitem_m;
 };
@@ -828,7 +828,7 @@ void iuse::sew(game *g, player *p, item *it, bool t)
    fix->damage++;
    if (fix->damage >= 5) {
     g->add_msg_if_player(p,"You destroy it!");
-    p->i_rem(ch);
+    p->i_rem(ch, g);
    }
   } else if (rn <= 6) {
    g->add_msg_if_player(p,"You don't repair your %s, but you waste lots of thread.",
@@ -882,13 +882,13 @@ void iuse::scissors(game *g, player *p, item *it, bool t)
  if (count <= 0) {
   g->add_msg_if_player(p,"You clumsily cut the %s into useless ribbons.",
              cut->tname().c_str());
-  p->i_rem(ch);
+  p->i_rem(ch, g);
   return;
  }
  g->add_msg_if_player(p,"You slice the %s into %d rag%s.", cut->tname().c_str(), count,
             (count == 1 ? "" : "s"));
  item rag(g->itypes[itm_rag], int(g->turn), g->nextinv);
- p->i_rem(ch);
+ p->i_rem(ch, g);
  bool drop = false;
  for (int i = 0; i < count; i++) {
   int iter = 0;
@@ -919,13 +919,13 @@ void iuse::scissors(game *g, player *p, item *it, bool t)
  if (count <= 0) {
   g->add_msg_if_player(p,"You clumsily cut the %s into useless scraps.",
              cut->tname().c_str());
-  p->i_rem(ch);
+  p->i_rem(ch, g);
   return;
  }
  g->add_msg_if_player(p,"You slice the %s into %d piece%s of leather.", cut->tname().c_str(), count,
             (count == 1 ? "" : "s"));
  item rag(g->itypes[itm_leather], int(g->turn), g->nextinv);
- p->i_rem(ch);
+ p->i_rem(ch, g);
  bool drop = false;
  for (int i = 0; i < count; i++) {
   int iter = 0;
@@ -1031,7 +1031,7 @@ void iuse::hammer(game *g, player *p, item *it, bool t)
  p->moves -= 500;
  g->m.add_item(p->posx, p->posy, g->itypes[itm_nail], 0, nails);
  g->m.add_item(p->posx, p->posy, g->itypes[itm_2x4], 0, boards);
- g->m.ter(dirx, diry) = newter;
+ g->m.ter_set(dirx, diry, newter);
 }
 
 void iuse::light_off(game *g, player *p, item *it, bool t)
@@ -1293,7 +1293,7 @@ void iuse::picklock(game *g, player *p, item *it, bool t)
  if (dice(4, 6) < dice(2, p->skillLevel("mechanics")) + dice(2, p->dex_cur) - it->damage / 2) {
   p->practice("mechanics", 1);
   g->add_msg_if_player(p,"With a satisfying click, the lock on the %s opens.", door_name);
-  g->m.ter(dirx, diry) = new_type;
+  g->m.ter_set(dirx, diry, new_type);
  } else if (dice(4, 4) < dice(2, p->skillLevel("mechanics")) +
                          dice(2, p->dex_cur) - it->damage / 2 && it->damage < 100) {
   it->damage++;
@@ -1392,7 +1392,7 @@ if (dirx == 0 && diry == 0) {
   p->moves -= 500;
   g->m.add_item(p->posx, p->posy, g->itypes[itm_nail], 0, nails);
   g->m.add_item(p->posx, p->posy, g->itypes[itm_2x4], 0, boards);
-  g->m.ter(dirx, diry) = newter;
+  g->m.ter_set(dirx, diry, newter);
   return;
  }
 
@@ -1401,7 +1401,7 @@ if (dirx == 0 && diry == 0) {
  if (dice(4, difficulty) < dice(2, p->skillLevel("mechanics")) + dice(2, p->str_cur)) {
   p->practice("mechanics", 1);
   g->add_msg_if_player(p,"You %s the %s.", action_name, door_name);
-  g->m.ter(dirx, diry) = new_type;
+  g->m.ter_set(dirx, diry, new_type);
   if (noisy)
    g->sound(dirx, diry, 8, "crunch!");
   if ( type == t_door_locked_alarm ) {
@@ -1420,7 +1420,7 @@ void iuse::makemound(game *g, player *p, item *it, bool t)
  if (g->m.has_flag(diggable, p->posx, p->posy)) {
   g->add_msg_if_player(p,"You churn up the earth here.");
   p->moves = -300;
-  g->m.ter(p->posx, p->posy) = t_dirtmound;
+  g->m.ter_set(p->posx, p->posy, t_dirtmound);
  } else
   g->add_msg_if_player(p,"You can't churn up this ground.");
 }
@@ -1763,7 +1763,7 @@ That trap needs a 3x3 space to be clear, centered two tiles from you.");
 void iuse::geiger(game *g, player *p, item *it, bool t)
 {
  if (t) { // Every-turn use when it's on
-  int rads = g->m.radiation(p->posx, p->posy);
+  int rads = g->m.radiation_peek(p->posx, p->posy);
   if (rads == 0)
    return;
   g->sound(p->posx, p->posy, 6, "");
@@ -1799,7 +1799,7 @@ void iuse::geiger(game *g, player *p, item *it, bool t)
  switch (ch) {
   case 1: g->add_msg_if_player(p,"Your radiation level: %d", p->radiation); break;
   case 2: g->add_msg_if_player(p,"The ground's radiation level: %d",
-                     g->m.radiation(p->posx, p->posy));		break;
+                     g->m.radiation_peek(p->posx, p->posy));		break;
   case 3:
    g->add_msg_if_player(p,"The geiger counter's scan LED flicks on.");
    it->make(g->itypes[itm_geiger_on]);
@@ -2641,13 +2641,13 @@ if (cut->made_of(COTTON)) {
  if (count <= 0) {
   g->add_msg("You clumsily cut the %s into useless ribbons.",
              cut->tname().c_str());
-  p->i_rem(ch);
+  p->i_rem(ch, g);
   return;
  }
  g->add_msg("You slice the %s into %d rag%s.", cut->tname().c_str(), count,
             (count == 1 ? "" : "s"));
  item rag(g->itypes[itm_rag], int(g->turn), g->nextinv);
- p->i_rem(ch);
+ p->i_rem(ch, g);
  bool drop = false;
  for (int i = 0; i < count; i++) {
   int iter = 0;
@@ -2678,13 +2678,13 @@ if (cut->made_of(COTTON)) {
  if (count <= 0) {
   g->add_msg_if_player(p,"You clumsily cut the %s into useless scraps.",
              cut->tname().c_str());
-  p->i_rem(ch);
+  p->i_rem(ch, g);
   return;
  }
  g->add_msg_if_player(p,"You slice the %s into %d piece%s of leather.", cut->tname().c_str(), count,
             (count == 1 ? "" : "s"));
  item rag(g->itypes[itm_leather], int(g->turn), g->nextinv);
- p->i_rem(ch);
+ p->i_rem(ch, g);
  bool drop = false;
  for (int i = 0; i < count; i++) {
   int iter = 0;
@@ -2717,7 +2717,7 @@ char ch = g->inv("Chop up what?");
  int count = 8;
  g->m.add_item(p->posx, p->posy, g->itypes[itm_splinter], 0);
  item skewer(g->itypes[itm_skewer], int(g->turn), g->nextinv);
- p->i_rem(ch);
+ p->i_rem(ch, g);
  bool drop = false;
  for (int i = 0; i < count; i++) {
   int iter = 0;
@@ -2753,7 +2753,7 @@ void iuse::lumber(game *g, player *p, item *it, bool t)
   g->add_msg("You cut the log into planks.");
   item plank(g->itypes[itm_2x4], int(g->turn), g->nextinv);
   item scrap(g->itypes[itm_splinter], int(g->turn), g->nextinv);
-  p->i_rem(ch);
+  p->i_rem(ch, g);
   bool drop = false;
   int planks = (rng(1, 3) + (p->skillLevel("carpentry") * 2));
   int scraps = 12 - planks;
@@ -2814,24 +2814,24 @@ if (dirx == 0 && diry == 0) {
  diry += p->posy;
  if (g->m.ter(dirx, diry) == t_chainfence_v || g->m.ter(dirx, diry) == t_chainfence_h) {
   p->moves -= 500;
-  g->m.ter(dirx, diry) = t_pavement;
+  g->m.ter_set(dirx, diry, t_pavement);
   g->sound(dirx, diry, 15,"grnd grnd grnd");
   g->m.add_item(dirx, diry, g->itypes[itm_pipe], 0, 6);
   g->m.add_item(dirx, diry, g->itypes[itm_wire], 0, 20);
  } else if (g->m.ter(dirx, diry) == t_rack) {
   p->moves -= 500;
-  g->m.ter(dirx, diry) = t_floor;
+  g->m.ter_set(dirx, diry, t_floor);
   g->sound(dirx, diry, 15,"grnd grnd grnd");
   g->m.add_item(p->posx, p->posy, g->itypes[itm_pipe], 0, rng(1, 3));
   g->m.add_item(p->posx, p->posy, g->itypes[itm_steel_chunk], 0);
  } else if (g->m.ter(dirx, diry) == t_bars && g->m.ter(dirx + 1, diry) == t_sewage ||
                                               g->m.ter(dirx, diry + 1) == t_sewage) {
-  g->m.ter(dirx, diry) = t_sewage;
+  g->m.ter_set(dirx, diry, t_sewage);
   p->moves -= 1000;
   g->sound(dirx, diry, 15,"grnd grnd grnd");
   g->m.add_item(p->posx, p->posy, g->itypes[itm_pipe], 0, 3);
  } else if (g->m.ter(dirx, diry) == t_bars && g->m.ter(p->posx, p->posy)) {
-  g->m.ter(dirx, diry) = t_floor;
+  g->m.ter_set(dirx, diry, t_floor);
   p->moves -= 500;
   g->sound(dirx, diry, 15,"grnd grnd grnd");
   g->m.add_item(p->posx, p->posy, g->itypes[itm_pipe], 0, 3);
@@ -2862,9 +2862,9 @@ void iuse::tent(game *g, player *p, item *it, bool t)
    }
  for (int i = -1; i <= 1; i++)
   for (int j = -1; j <= 1; j++)
-    g->m.ter(posx + i, posy + j) = t_canvas_wall;
- g->m.ter(posx, posy) = t_groundsheet;
- g->m.ter(posx - dirx, posy - diry) = t_canvas_door;
+    g->m.ter_set(posx + i, posy + j, t_canvas_wall);
+ g->m.ter_set(posx, posy, t_groundsheet);
+ g->m.ter_set(posx - dirx, posy - diry, t_canvas_door);
  it->invlet = 0;
 }
 
@@ -2890,9 +2890,9 @@ void iuse::shelter(game *g, player *p, item *it, bool t)
    }
  for (int i = -1; i <= 1; i++)
   for (int j = -1; j <= 1; j++)
-    g->m.ter(posx + i, posy + j) = t_skin_wall;
- g->m.ter(posx, posy) = t_skin_groundsheet;
- g->m.ter(posx - dirx, posy - diry) = t_skin_door;
+    g->m.ter_set(posx + i, posy + j, t_skin_wall);
+ g->m.ter_set(posx, posy, t_skin_groundsheet);
+ g->m.ter_set(posx - dirx, posy - diry, t_skin_door);
  it->invlet = 0;
 }
 
@@ -3151,7 +3151,7 @@ void iuse::bullet_puller(game *g, player *p, item *it, bool t)
  }
  pull->charges = pull->charges - multiply;
  if (pull->charges == 0)
- p->i_rem(ch);
+ p->i_rem(ch, g);
  g->add_msg("You take apart the ammunition.");
  p->moves -= 500;
  if (casing.type->id != itm_null){
@@ -3221,12 +3221,12 @@ if (dirx == 0 && diry == 0) {
 
  if (g->m.ter(dirx, diry) == t_chaingate_l) {
   p->moves -= 100;
-  g->m.ter(dirx, diry) = t_chaingate_c;
+  g->m.ter_set(dirx, diry, t_chaingate_c);
   g->sound(dirx, diry, 5, "Gachunk!");
   g->m.add_item(p->posx, p->posy, g->itypes[itm_scrap], 0, 3);
  } else if (g->m.ter(dirx, diry) == t_chainfence_v || g->m.ter(dirx, diry) == t_chainfence_h) {
   p->moves -= 500;
-  g->m.ter(dirx, diry) = t_chainfence_posts;
+  g->m.ter_set(dirx, diry, t_chainfence_posts);
   g->sound(dirx, diry, 5,"Snick, snick, gachunk!");
   g->m.add_item(dirx, diry, g->itypes[itm_wire], 0, 20);
  } else {
@@ -3477,7 +3477,7 @@ void iuse::artifact(game *g, player *p, item *it, bool t)
      g->m.bash(x, y, 40, junk);  // Multibash effect, so that doors &c will fall
      g->m.bash(x, y, 40, junk);
      if (g->m.is_destructable(x, y) && rng(1, 10) >= 3)
-      g->m.ter(x, y) = t_rubble;
+      g->m.ter_set(x, y, t_rubble);
     }
    }
    break;
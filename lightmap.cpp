@@ -44,8 +44,8 @@ void light_map::generate(game* g, int x, int y, float natural_light, float lumin
  for(int sx = x - LIGHTMAP_RANGE_X; sx <= x + LIGHTMAP_RANGE_X; ++sx) {
   for(int sy = y - LIGHTMAP_RANGE_Y; sy <= y + LIGHTMAP_RANGE_Y; ++sy) {
    const ter_id terrain = g->m.ter(sx, sy);
-   const std::vector<item> items = g->m.i_at(sx, sy);
-   const field current_field = g->m.field_at(sx, sy);
+   const std::vector<item> &items = g->m.i_peek(sx, sy);
+   const field &current_field = g->m.field_peek(sx, sy);
    // When underground natural_light is 0, if this changes we need to revisit
    if (natural_light > LIGHT_AMBIENT_LOW) {
     if (!is_outside(sx - x, sy - y)) {
@@ -114,14 +114,15 @@ void light_map::generate(game* g, int x, int y, float natural_light, float lumin
     }
    }
 
-   if (c[sx - x + LIGHTMAP_RANGE_X][sy - y + LIGHTMAP_RANGE_Y].mon >= 0) {
-    if (g->z[c[sx - x + LIGHTMAP_RANGE_X][sy - y + LIGHTMAP_RANGE_Y].mon].has_effect(ME_ONFIRE))
+   const int mondex = g->z.index_of(c[sx - x + LIGHTMAP_RANGE_X][sy - y + LIGHTMAP_RANGE_Y].mon);
+   if (mondex != -1) {
+    if (g->z[mondex].has_effect(ME_ONFIRE))
      apply_light_source(sx, sy, x, y, 3);
 
     // TODO: [lightmap] Attach natural light brightness to creatures
     // TODO: [lightmap] Allow creatures to have light attacks (ie: eyebot)
     // TODO: [lightmap] Allow creatures to have facing and arc lights
-    switch(g->z[c[sx - x + LIGHTMAP_RANGE_X][sy - y + LIGHTMAP_RANGE_Y].mon].type->id) {
+    switch(g->z[mondex].type->id) {
      case mon_zombie_electric:
       apply_light_source(sx, sy, x, y, 1);
       break;
@@ -381,27 +382,13 @@ void light_map::apply_light_ray(bool lit[LIGHTMAP_X][LIGHTMAP_Y], int sx, int sy
 
 void light_map::build_outside_cache(map *m, const int x, const int y, const int sx, const int sy)
 {
- const ter_id terrain = m->ter(sx, sy);
-
- if( terrain == t_floor || terrain == t_rock_floor || terrain == t_floor_wax ||
-     terrain == t_fema_groundsheet || terrain == t_dirtfloor) {
-  for( int dx = -1; dx <= 1; dx++ ) {
-   for( int dy = -1; dy <= 1; dy++ ) {
-    outside_cache[x + dx][y + dy] = false;
-   }
-  }
- } else if(terrain == t_bed || terrain == t_groundsheet || terrain == t_makeshift_bed) {
-  outside_cache[x][y] = false;
- }
+ outside_cache[x][y] = m->is_outside_ter_only(sx, sy);
 }
 
 // We only do this once now so we don't make 100k calls to is_outside for each
 // generation. As well as close to that for the veh_at function.
 void light_map::build_light_cache(game* g, int cx, int cy)
 {
- // Clear cache
- memset(outside_cache, true, sizeof(outside_cache));
-
  for(int x = 0; x < LIGHTMAP_CACHE_X; x++) {
   for(int y = 0; y < LIGHTMAP_CACHE_Y; y++) {
    int sx = x + g->u.posx - LIGHTMAP_RANGE_X;
@@ -419,7 +406,7 @@ void light_map::build_light_cache(game* g, int cx, int cy)
  // Check for critters and cache
  for (int i = 0; i < g->z.size(); ++i)
   if (INBOUNDS(g->z[i].posx - cx, g->z[i].posy - cy))
-   c[g->z[i].posx - cx + LIGHTMAP_RANGE_X][g->z[i].posy - cy + LIGHTMAP_RANGE_Y].mon = i;
+   c[g->z[i].posx - cx + LIGHTMAP_RANGE_X][g->z[i].posy - cy + LIGHTMAP_RANGE_Y].mon = g->z.handle_at(i);
 
  // Check for vehicles and cache
  VehicleList vehs = g->m.get_vehicles(cx - LIGHTMAP_RANGE_X, cy - LIGHTMAP_RANGE_Y, cx + LIGHTMAP_RANGE_X, cy + LIGHTMAP_RANGE_Y);
@@ -467,7 +454,7 @@ void light_map::build_light_cache(game* g, int cx, int cy)
     continue;
    }
 
-   field& f = g->m.field_at(sx, sy);
+   const field &f = g->m.field_peek(sx, sy);
    if(f.type > 0) {
     if(!fieldlist[f.type].transparent[f.density - 1]) {
      // Fields are either transparent or not, however we want some to be translucent
@@ -37,7 +37,7 @@ struct light_map_cache {
  vehicle* veh;
  int veh_part;
  int veh_light;
- int mon;
+ int mon; // Handle in g->z, -1 for none
 };
 
 class light_map
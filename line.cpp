@@ -1,64 +1,32 @@
 #include "line.h"
 #include <stdlib.h>
 
-#define SGN(a) (((a)<0) ? -1 : 1)
+// Collects the points walk_line() visits
+struct line_collector {
+ std::vector<point> &points;
+ line_collector(std::vector<point> &P) : points (P) {}
+ bool operator()(int x, int y)
+ {
+  points.push_back(point(x, y));
+  return true;
+ }
+};
 
 std::vector <point> line_to(int x1, int y1, int x2, int y2, int t)
 {
  std::vector<point> ret;
- int dx = x2 - x1;
- int dy = y2 - y1;
- int ax = abs(dx)<<1;
- int ay = abs(dy)<<1;
- int sx = SGN(dx);
- int sy = SGN(dy);
- if (dy == 0) sy = 0;
- if (dx == 0) sx = 0;
- point cur;
- cur.x = x1;
- cur.y = y1;
-
- int xmin = (x1 < x2 ? x1 : x2), ymin = (y1 < y2 ? y1 : y2),
-     xmax = (x1 > x2 ? x1 : x2), ymax = (y1 > y2 ? y1 : y2);
-
- xmin -= abs(dx);
- ymin -= abs(dy);
- xmax += abs(dx);
- ymax += abs(dy);
-
- if (ax == ay) {
-  do {
-   cur.y += sy;
-   cur.x += sx;
-   ret.push_back(cur);
-  } while ((cur.x != x2 || cur.y != y2) &&
-           (cur.x >= xmin && cur.x <= xmax && cur.y >= ymin && cur.y <= ymax));
- } else if (ax > ay) {
-  do {
-   if (t > 0) {
-    cur.y += sy;
-    t -= ax;
-   }
-   cur.x += sx;
-   t += ay;
-   ret.push_back(cur);
-  } while ((cur.x != x2 || cur.y != y2) &&
-           (cur.x >= xmin && cur.x <= xmax && cur.y >= ymin && cur.y <= ymax));
- } else {
-  do {
-   if (t > 0) {
-    cur.x += sx;
-    t -= ay;
-   }
-   cur.y += sy;
-   t += ax;
-   ret.push_back(cur);
-  } while ((cur.x != x2 || cur.y != y2) &&
-           (cur.x >= xmin && cur.x <= xmax && cur.y >= ymin && cur.y <= ymax));
- }
+ line_to(x1, y1, x2, y2, t, ret);
  return ret;
 }
 
+void line_to(int x1, int y1, int x2, int y2, int t, std::vector<point> &ret)
+{
+ ret.clear();
+ ret.reserve(abs(x2 - x1) > abs(y2 - y1) ? abs(x2 - x1) : abs(y2 - y1));
+ line_collector line(ret);
+ walk_line(x1, y1, x2, y2, t, line);
+}
+
 int trig_dist(int x1, int y1, int x2, int y2)
 {
  return int(sqrt(double(pow(x1 - x2, 2.0) + pow(y1 - y2, 2.0))));
@@ -80,7 +48,7 @@ int rl_dist(point a, point b)
  return dy;
 }
 
-double slope_of(std::vector<point> line)
+double slope_of(const std::vector<point> &line)
 {
  double dX = line.back().x - line.front().x, dY = line.back().y - line.front().y;
  if (dX == 0)
@@ -88,12 +56,20 @@ double slope_of(std::vector<point> line)
  return (dY / dX);
 }
 
-std::vector<point> continue_line(std::vector<point> line, int distance)
+std::vector<point> continue_line(const std::vector<point> &line, int distance)
+{
+ point end = continue_line_end(line.front(), line.back(), distance);
+ return line_to(line.back().x, line.back().y, end.x, end.y, 0);
+}
+
+point continue_line_end(point from, point to, int distance)
 {
- point start = line.back(), end = line.back();
- double slope = slope_of(line);
- int sX = (line.front().x < line.back().x ? 1 : -1),
-     sY = (line.front().y < line.back().y ? 1 : -1);
+ point end = to;
+ double slope = SLOPE_VERTICAL;
+ if (to.x != from.x)
+  slope = double(to.y - from.y) / double(to.x - from.x);
+ int sX = (from.x < to.x ? 1 : -1),
+     sY = (from.y < to.y ? 1 : -1);
  if (abs(slope) == 1) {
   end.x += distance * sX;
   end.y += distance * sY;
@@ -105,7 +81,7 @@ std::vector<point> continue_line(std::vector<point> line, int distance)
   if (slope != SLOPE_VERTICAL)
    end.x += int(distance / abs(slope)) * sX;
  }
- return line_to(start.x, start.y, end.x, end.y, 0);
+ return end;
 }
 
 direction direction_from(int x1, int y1, int x2, int y2)
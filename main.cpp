@@ -11,6 +11,7 @@
 #include "options.h"
 #include "mapbuffer.h"
 #include "debug.h"
+#include "rng.h"
 #include <sys/stat.h>
 #include <cstdlib>
 #include <signal.h>
@@ -49,6 +50,7 @@ int main(int argc, char *argv[])
  set_escdelay(10); // Make escape actually responsive
 
  std::srand(seed);
+ rng_set_world_seed(seed);
 
  bool quit_game = false;
  bool delete_world = false;
@@ -11,7 +11,6 @@
 #include <fstream>
 #include "debug.h"
 
-#define SGN(a) (((a)<0) ? -1 : 1)
 #define INBOUNDS(x, y) \
  (x >= 0 && x < SEEX * my_MAPSIZE && y >= 0 && y < SEEY * my_MAPSIZE)
 #define dbg(x) dout((DebugLevel)(x),D_MAP) << __FILE__ << ":" << __LINE__ << ": "
@@ -32,6 +31,8 @@ map::map()
   my_MAPSIZE = MAPSIZE;
  dbg(D_INFO) << "map::map(): my_MAPSIZE: " << my_MAPSIZE;
  veh_in_active_range = true;
+ sight_change_count = 0;
+ invalidate_outside_masks();
 }
 
 map::map(std::vector<itype*> *itptr, std::vector<itype_id> (*miptr)[num_itloc],
@@ -51,6 +52,8 @@ map::map(std::vector<itype*> *itptr, std::vector<itype_id> (*miptr)[num_itloc],
  dbg(D_INFO) << "map::map( itptr["<<itptr<<"], miptr["<<miptr<<"], trptr["<<trptr<<"] ): my_MAPSIZE: " << my_MAPSIZE;
  veh_in_active_range = true;
  memset(veh_exists_at, 0, sizeof(veh_exists_at));
+ sight_change_count = 0;
+ invalidate_outside_masks();
 }
 
 map::~map()
@@ -509,9 +512,9 @@ bool map::vehproceed(game* g){
          const int p = veh->external_parts[ep];
          const int px = x + veh->parts[p].precalc_dx[0];
          const int py = y + veh->parts[p].precalc_dy[0];
-         ter_id &pter = ter(px, py);
+         const ter_id pter = ter(px, py);
          if (pter == t_dirt || pter == t_grass)
-            pter = t_dirtmound;
+            ter_set(px, py, t_dirtmound);
       }
    }
 
@@ -787,6 +790,21 @@ ter_id& map::ter(const int x, const int y)
  return grid[nonant]->ter[lx][ly];
 }
 
+void map::ter_set(const int x, const int y, const ter_id new_terrain)
+{
+ if (!INBOUNDS(x, y))
+  return;
+ ter(x, y) = new_terrain;
+ sight_change_count++;
+// Whether a square is outside depends on its neighbors too
+ for (int i = -1; i <= 1; i += 2) {
+  for (int j = -1; j <= 1; j += 2) {
+   if (INBOUNDS(x + i, y + j))
+    outside_mask_valid[int((x + i) / SEEX) + int((y + j) / SEEY) * my_MAPSIZE] = false;
+  }
+ }
+}
+
 bool map::is_indoor(const int x, const int y)
 {
  if (!INBOUNDS(x, y))
@@ -871,7 +889,7 @@ bool map::trans(const int x, const int y, char * trans_buf)
   tertr = terlist[ter(x, y)].flags & mfb(transparent);
  if( tertr ){
   // Fields may obscure the view, too
-  field & f(field_at(x, y));
+  const field &f = field_peek(x, y);
   if(f.type == 0 || fieldlist[f.type].transparent[f.density - 1]){
    if(trans_buf) trans_buf[x + (y * my_MAPSIZE * SEEX)] = 1;
    return true;
@@ -913,29 +931,81 @@ bool map::is_destructable_ter_only(const int x, const int y)
          (move_cost_ter_only(x, y) == 0 && !has_flag(liquid, x, y)));
 }
 
+// Terrain that roofs over itself and the squares around it
+static bool roofs_over(const ter_id terrain)
+{
+ return (terrain == t_floor || terrain == t_rock_floor || terrain == t_floor_wax ||
+         terrain == t_fema_groundsheet || terrain == t_dirtfloor ||
+         terrain == t_skin_groundsheet);
+}
+
+// Terrain that is only covered itself
+static bool roofed(const ter_id terrain)
+{
+ return (terrain == t_bed || terrain == t_groundsheet || terrain == t_makeshift_bed);
+}
+
 bool map::is_outside(const int x, const int y)
 {
- bool out = (ter(x, y) != t_bed && ter(x, y) != t_groundsheet && ter(x, y) != t_makeshift_bed);
+ if (!is_outside_ter_only(x, y))
+  return false;
+ int vpart;
+ vehicle *veh = veh_at(x, y, vpart);
+ return !(veh && veh->is_inside(vpart));
+}
 
- for(int i = -1; out && i <= 1; i++)
-  for(int j = -1; out && j <= 1; j++) {
-   const ter_id terrain = ter( x + i, y + j );
-   out = (terrain != t_floor && terrain != t_rock_floor && terrain != t_floor_wax &&
-          terrain != t_fema_groundsheet && terrain != t_dirtfloor && terrain != t_skin_groundsheet);
+bool map::is_outside_ter_only(const int x, const int y)
+{
+ if (!INBOUNDS(x, y)) {
+  bool out = !roofed(ter(x, y));
+  for (int i = -1; out && i <= 1; i++) {
+   for (int j = -1; out && j <= 1; j++)
+    out = !roofs_over(ter(x + i, y + j));
   }
- if (out) {
-  int vpart;
-  vehicle *veh = veh_at (x, y, vpart);
-  if (veh && veh->is_inside(vpart))
-   out = false;
+  return out;
+ }
+ const int nonant = int(x / SEEX) + int(y / SEEY) * my_MAPSIZE;
+ if (!outside_mask_valid[nonant])
+  build_outside_mask(nonant);
+ return (outside_mask[nonant][x % SEEX] >> (y % SEEY)) & 1;
+}
+
+void map::build_outside_mask(const int nonant)
+{
+ const int sx = (nonant % my_MAPSIZE) * SEEX, sy = (nonant / my_MAPSIZE) * SEEY;
+// Roofs over this submap and a one-square border around it
+ bool roof[SEEX + 2][SEEY + 2];
+ for (int x = 0; x < SEEX + 2; x++) {
+  for (int y = 0; y < SEEY + 2; y++)
+   roof[x][y] = roofs_over(ter(sx + x - 1, sy + y - 1));
+ }
+ for (int x = 0; x < SEEX; x++) {
+  unsigned short column = 0;
+  for (int y = 0; y < SEEY; y++) {
+   bool out = !roofed(ter(sx + x, sy + y));
+   for (int i = 0; out && i <= 2; i++) {
+    for (int j = 0; out && j <= 2; j++)
+     out = !roof[x + i][y + j];
+   }
+   if (out)
+    column |= 1 << y;
+  }
+  outside_mask[nonant][x] = column;
  }
- return out;
+ outside_mask_valid[nonant] = true;
+}
+
+void map::invalidate_outside_masks()
+{
+ sight_change_count++;
+ memset(outside_mask_valid, 0, sizeof(outside_mask_valid));
 }
 
 bool map::flammable_items_at(const int x, const int y)
 {
- for (int i = 0; i < i_at(x, y).size(); i++) {
-  item *it = &(i_at(x, y)[i]);
+ const std::vector<item> &items_here = i_peek(x, y);
+ for (int i = 0; i < items_here.size(); i++) {
+  const item *it = &(items_here[i]);
   if (it->made_of(PAPER) || it->made_of(WOOD) || it->made_of(COTTON) ||
       it->made_of(POWDER) || it->made_of(VEGGY) || it->is_ammo() ||
       it->type->id == itm_whiskey || it->type->id == itm_vodka ||
@@ -947,8 +1017,9 @@ bool map::flammable_items_at(const int x, const int y)
 
 bool map::moppable_items_at(const int x, const int y)
 {
- for (int i = 0; i < i_at(x, y).size(); i++) {
-  item *it = &(i_at(x, y)[i]);
+ const std::vector<item> &items_here = i_peek(x, y);
+ for (int i = 0; i < items_here.size(); i++) {
+  const item *it = &(items_here[i]);
   if (it->made_of(LIQUID))
    return true;
  }
@@ -1000,7 +1071,7 @@ bool map::bash(const int x, const int y, const int str, std::string &sound, int
 {
  sound = "";
  bool smashed_web = false;
- if (field_at(x, y).type == fd_web) {
+ if (field_peek(x, y).type == fd_web) {
   smashed_web = true;
   remove_field(x, y);
  }
@@ -1037,7 +1108,7 @@ bool map::bash(const int x, const int y, const int str, std::string &sound, int
   if (res) *res = result;
   if (str >= result && str >= rng(0, 50)) {
    sound += "clang!";
-   ter(x, y) = t_chainfence_posts;
+   ter_set(x, y, t_chainfence_posts);
    add_item(x, y, (*itypes)[itm_wire], 0, rng(4, 10));
    return true;
   } else {
@@ -1051,7 +1122,7 @@ bool map::bash(const int x, const int y, const int str, std::string &sound, int
   if (res) *res = result;
   if (str >= result && str >= rng(0, 120)) {
    sound += "crunch!";
-   ter(x, y) = t_wall_wood_chipped;
+   ter_set(x, y, t_wall_wood_chipped);
    if(one_in(2))
     add_item(x, y, (*itypes)[itm_2x4], 0);
    add_item(x, y, (*itypes)[itm_nail], 0, 2);
@@ -1068,7 +1139,7 @@ bool map::bash(const int x, const int y, const int str, std::string &sound, int
   if (res) *res = result;
   if (str >= result && str >= rng(0, 100)) {
    sound += "crunch!";
-   ter(x, y) = t_wall_wood_broken;
+   ter_set(x, y, t_wall_wood_broken);
    add_item(x, y, (*itypes)[itm_2x4], 0, rng(1, 4));
    add_item(x, y, (*itypes)[itm_nail], 0, rng(1, 3));
    add_item(x, y, (*itypes)[itm_splinter], 0);
@@ -1084,7 +1155,7 @@ bool map::bash(const int x, const int y, const int str, std::string &sound, int
   if (res) *res = result;
   if (str >= result && str >= rng(0, 80)) {
    sound += "crash!";
-   ter(x, y) = t_dirt;
+   ter_set(x, y, t_dirt);
    add_item(x, y, (*itypes)[itm_2x4], 0, rng(2, 5));
    add_item(x, y, (*itypes)[itm_nail], 0, rng(4, 10));
    add_item(x, y, (*itypes)[itm_splinter], 0);
@@ -1101,7 +1172,7 @@ case t_palisade_gate:
   if (res) *res = result;
   if (str >= result && str >= rng(0, 120)) {
    sound += "crunch!";
-   ter(x, y) = t_pit;
+   ter_set(x, y, t_pit);
    if(one_in(2))
    add_item(x, y, (*itypes)[itm_splinter], 0, 20);
    return true;
@@ -1116,7 +1187,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result && str >= rng(0, 120)) {
    sound += "crunch!";
-   ter(x, y) = t_wall_log_chipped;
+   ter_set(x, y, t_wall_log_chipped);
    if(one_in(2))
    add_item(x, y, (*itypes)[itm_splinter], 0, 3);
    return true;
@@ -1131,7 +1202,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result && str >= rng(0, 100)) {
    sound += "crunch!";
-   ter(x, y) = t_wall_log_broken;
+   ter_set(x, y, t_wall_log_broken);
    add_item(x, y, (*itypes)[itm_splinter], 0, 5);
    return true;
   } else {
@@ -1145,7 +1216,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result && str >= rng(0, 80)) {
    sound += "crash!";
-   ter(x, y) = t_dirt;
+   ter_set(x, y, t_dirt);
    add_item(x, y, (*itypes)[itm_splinter], 0, 5);
    return true;
   } else {
@@ -1160,7 +1231,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result && str >= rng(0, 80)) {
    sound += "clang!";
-   ter(x, y) = t_dirt;
+   ter_set(x, y, t_dirt);
    add_item(x, y, (*itypes)[itm_wire], 0, rng(8, 20));
    add_item(x, y, (*itypes)[itm_scrap], 0, rng(0, 12));
    return true;
@@ -1175,7 +1246,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result) {
    sound += "crash!";
-   ter(x, y) = t_dirtfloor;
+   ter_set(x, y, t_dirtfloor);
    add_item(x, y, (*itypes)[itm_2x4], 0, rng(1, 4));
    add_item(x, y, (*itypes)[itm_nail], 0, rng(2, 12));
    add_item(x, y, (*itypes)[itm_splinter], 0);
@@ -1193,7 +1264,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result) {
    sound += "smash!";
-   ter(x, y) = t_door_b;
+   ter_set(x, y, t_door_b);
    return true;
   } else {
    sound += "whump!";
@@ -1206,7 +1277,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result) {
    sound += "crash!";
-   ter(x, y) = t_door_frame;
+   ter_set(x, y, t_door_frame);
    add_item(x, y, (*itypes)[itm_2x4], 0, rng(1, 6));
    add_item(x, y, (*itypes)[itm_nail], 0, rng(2, 12));
    add_item(x, y, (*itypes)[itm_splinter], 0);
@@ -1224,7 +1295,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result) {
    sound += "glass breaking!";
-   ter(x, y) = t_window_frame;
+   ter_set(x, y, t_window_frame);
   add_item(x, y, (*itypes)[itm_sheet], 0, 1);
   add_item(x, y, (*itypes)[itm_stick], 0);
    return true;
@@ -1242,7 +1313,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result) {
    sound += "glass breaking!";
-   ter(x, y) = t_window_frame;
+   ter_set(x, y, t_window_frame);
    return true;
   } else {
    sound += "whack!";
@@ -1255,7 +1326,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result) {
    sound += "crash!";
-   ter(x, y) = t_door_frame;
+   ter_set(x, y, t_door_frame);
    add_item(x, y, (*itypes)[itm_2x4], 0, rng(1, 6));
    add_item(x, y, (*itypes)[itm_nail], 0, rng(2, 12));
    add_item(x, y, (*itypes)[itm_splinter], 0);
@@ -1271,7 +1342,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result) {
    sound += "crash!";
-   ter(x, y) = t_window_frame;
+   ter_set(x, y, t_window_frame);
    const int num_boards = rng(0, 2) * rng(0, 1);
    for (int i = 0; i < num_boards; i++)
     add_item(x, y, (*itypes)[itm_splinter], 0);
@@ -1308,7 +1379,7 @@ case t_wall_log:
     for (int j = -1; j <= 1; j++) {
      if (ter(tentx + i, tenty + j) == t_skin_groundsheet)
       add_item(tentx + i, tenty + j, (*itypes)[itm_damaged_shelter_kit], 0);
-     ter(tentx + i, tenty + j) = t_dirt;
+     ter_set(tentx + i, tenty + j, t_dirt);
     }
 
    sound += "rrrrip!";
@@ -1345,7 +1416,7 @@ case t_wall_log:
     for (int j = -1; j <= 1; j++) {
      if (ter(tentx + i, tenty + j) == t_groundsheet)
       add_item(tentx + i, tenty + j, (*itypes)[itm_broketent], 0);
-     ter(tentx + i, tenty + j) = t_dirt;
+     ter_set(tentx + i, tenty + j, t_dirt);
     }
 
    sound += "rrrrip!";
@@ -1361,7 +1432,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result) {
    sound += "rrrrip!";
-   ter(x, y) = t_dirt;
+   ter_set(x, y, t_dirt);
    return true;
   } else {
    sound += "slap!";
@@ -1377,7 +1448,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result) {
    sound += "metal screeching!";
-   ter(x, y) = t_metal;
+   ter_set(x, y, t_metal);
    add_item(x, y, (*itypes)[itm_scrap], 0, rng(2, 8));
    const int num_boards = rng(0, 3);
    for (int i = 0; i < num_boards; i++)
@@ -1397,7 +1468,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result) {
    sound += "porcelain breaking!";
-   ter(x, y) = t_rubble;
+   ter_set(x, y, t_rubble);
    return true;
   } else {
    sound += "whunk!";
@@ -1414,7 +1485,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result) {
    sound += "smash!";
-   ter(x, y) = t_floor;
+   ter_set(x, y, t_floor);
    add_item(x, y, (*itypes)[itm_2x4], 0, rng(2, 6));
    add_item(x, y, (*itypes)[itm_nail], 0, rng(4, 12));
    add_item(x, y, (*itypes)[itm_splinter], 0);
@@ -1431,7 +1502,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result) {
    sound += "crak";
-   ter(x, y) = t_dirt;
+   ter_set(x, y, t_dirt);
    add_item(x, y, (*itypes)[itm_2x4], 0, rng(1, 3));
    add_item(x, y, (*itypes)[itm_nail], 0, rng(2, 6));
    add_item(x, y, (*itypes)[itm_splinter], 0);
@@ -1447,7 +1518,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result) {
    sound += "crak";
-   ter(x, y) = t_dirt;
+   ter_set(x, y, t_dirt);
    add_item(x, y, (*itypes)[itm_spear_wood], 0, 1);
    return true;
   } else {
@@ -1464,7 +1535,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result) {
    sound += "smash!";
-   ter(x, y) = t_floor;
+   ter_set(x, y, t_floor);
    add_item(x, y, (*itypes)[itm_2x4], 0, rng(1, 3));
    add_item(x, y, (*itypes)[itm_nail], 0, rng(2, 6));
    add_item(x, y, (*itypes)[itm_splinter], 0);
@@ -1484,7 +1555,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result) {
    sound += "glass breaking!";
-   ter(x, y) = t_floor;
+   ter_set(x, y, t_floor);
    return true;
   } else {
    sound += "whack!";
@@ -1498,7 +1569,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result) {
    sound += "glass breaking!";
-   ter(x, y) = t_floor;
+   ter_set(x, y, t_floor);
    return true;
   } else {
    sound += "whack!";
@@ -1511,7 +1582,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result) {
    sound += "crunch!";
-   ter(x, y) = t_underbrush;
+   ter_set(x, y, t_underbrush);
    const int num_sticks = rng(0, 3);
    for (int i = 0; i < num_sticks; i++)
     add_item(x, y, (*itypes)[itm_stick], 0);
@@ -1527,7 +1598,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result && !one_in(4)) {
    sound += "crunch.";
-   ter(x, y) = t_dirt;
+   ter_set(x, y, t_dirt);
    return true;
   } else {
    sound += "brush.";
@@ -1538,7 +1609,7 @@ case t_wall_log:
  case t_shrub:
   if (str >= rng(0, 30) && str >= rng(0, 30) && str >= rng(0, 30) && one_in(2)){
    sound += "crunch.";
-   ter(x, y) = t_underbrush;
+   ter_set(x, y, t_underbrush);
    return true;
   } else {
    sound += "brush.";
@@ -1551,7 +1622,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result) {
    sound += "crunch!";
-   ter(x, y) = t_fungus;
+   ter_set(x, y, t_fungus);
    return true;
   } else {
    sound += "whack!";
@@ -1564,7 +1635,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result) {
    sound += "ker-rash!";
-   ter(x, y) = t_floor;
+   ter_set(x, y, t_floor);
    return true;
   } else {
    sound += "plunk.";
@@ -1576,7 +1647,7 @@ case t_wall_log:
   if (res) *res = result;
   if (str >= result) {
    sound += "smash";
-   ter(x, y) = t_dirt;
+   ter_set(x, y, t_dirt);
    add_item(x, y, (*itypes)[itm_2x4], 0, rng(1, 5));
    add_item(x, y, (*itypes)[itm_nail], 0, rng(2, 10));
    return true;
@@ -1599,32 +1670,32 @@ void map::destroy(game *g, const int x, const int y, const bool makesound)
  switch (ter(x, y)) {
 
  case t_gas_pump:
-  if (makesound && one_in(3))
+  if (g != NULL && makesound && one_in(3))
    g->explosion(x, y, 40, 0, true);
   else {
    for (int i = x - 2; i <= x + 2; i++) {
     for (int j = y - 2; j <= y + 2; j++) {
      if (move_cost(i, j) > 0 && one_in(3))
-      add_item(i, j, g->itypes[itm_gasoline], 0);
+      add_item(i, j, (*itypes)[itm_gasoline], 0);
      if (move_cost(i, j) > 0 && one_in(6))
-      add_item(i, j, g->itypes[itm_steel_chunk], 0);
+      add_item(i, j, (*itypes)[itm_steel_chunk], 0);
     }
    }
   }
-  ter(x, y) = t_rubble;
+  ter_set(x, y, t_rubble);
   break;
 
  case t_door_c:
  case t_door_b:
  case t_door_locked:
  case t_door_boarded:
-  ter(x, y) = t_door_frame;
+  ter_set(x, y, t_door_frame);
   for (int i = x - 2; i <= x + 2; i++) {
    for (int j = y - 2; j <= y + 2; j++) {
     if (move_cost(i, j) > 0 && one_in(6))
-     add_item(i, j, g->itypes[itm_2x4], 0);
+     add_item(i, j, (*itypes)[itm_2x4], 0);
     if (move_cost(i, j) > 0 && one_in(6))
-      add_item(i, j, g->itypes[itm_nail], 0, 3);
+      add_item(i, j, (*itypes)[itm_nail], 0, 3);
    }
   }
   break;
@@ -1635,23 +1706,24 @@ void map::destroy(game *g, const int x, const int y, const bool makesound)
   for (int i = x - 2; i <= x + 2; i++) {
    for (int j = y - 2; j <= y + 2; j++) {
     if (move_cost(i, j) > 0 && one_in(5))
-     add_item(i, j, g->itypes[itm_rock], 0);
-    ter(x, y) = t_rubble;
+     add_item(i, j, (*itypes)[itm_rock], 0);
+    ter_set(x, y, t_rubble);
    }
   }
   break;
 
  case t_floor:
- g->sound(x, y, 20, "SMASH!!");
+  if (g != NULL)
+   g->sound(x, y, 20, "SMASH!!");
   for (int i = x - 2; i <= x + 2; i++) {
    for (int j = y - 2; j <= y + 2; j++) {
     if (move_cost(i, j) > 0 && one_in(5))
-     add_item(i, j, g->itypes[itm_splinter], 0);
+     add_item(i, j, (*itypes)[itm_splinter], 0);
     if (move_cost(i, j) > 0 && one_in(6))
-      add_item(i, j, g->itypes[itm_nail], 0, 3);
+      add_item(i, j, (*itypes)[itm_nail], 0, 3);
    }
   }
-  ter(x, y) = t_rubble;
+  ter_set(x, y, t_rubble);
   for (int i = x - 1; i <= x + 1; i++)
    for (int j = y - 1; j <= y + 1; j++) {
      if (i == x && j == y || !has_flag(collapses, i, j))
@@ -1675,20 +1747,21 @@ void map::destroy(game *g, const int x, const int y, const bool makesound)
  case t_concrete_h:
  case t_wall_v:
  case t_wall_h:
- g->sound(x, y, 20, "SMASH!!");
+  if (g != NULL)
+   g->sound(x, y, 20, "SMASH!!");
   for (int i = x - 2; i <= x + 2; i++) {
    for (int j = y - 2; j <= y + 2; j++) {
     if (move_cost(i, j) > 0 && one_in(5))
-     add_item(i, j, g->itypes[itm_rock], 0);
+     add_item(i, j, (*itypes)[itm_rock], 0);
     if (move_cost(i, j) > 0 && one_in(4))
-     add_item(i, j, g->itypes[itm_splinter], 0);
+     add_item(i, j, (*itypes)[itm_splinter], 0);
     if (move_cost(i, j) > 0 && one_in(3))
-     add_item(i, j, g->itypes[itm_rebar], 0);
+     add_item(i, j, (*itypes)[itm_rebar], 0);
     if (move_cost(i, j) > 0 && one_in(6))
-      add_item(i, j, g->itypes[itm_nail], 0, 3);
+      add_item(i, j, (*itypes)[itm_nail], 0, 3);
    }
   }
-  ter(x, y) = t_rubble;
+  ter_set(x, y, t_rubble);
   for (int i = x - 1; i <= x + 1; i++)
    for (int j = y - 1; j <= y + 1; j++) {
      if (i == x && j == y || !has_flag(supports_roof, i, j))
@@ -1713,9 +1786,9 @@ void map::destroy(game *g, const int x, const int y, const bool makesound)
   break;
 
  default:
-  if (makesound && has_flag(explodes, x, y) && one_in(2))
+  if (g != NULL && makesound && has_flag(explodes, x, y) && one_in(2))
    g->explosion(x, y, 40, 0, true);
-  ter(x, y) = t_rubble;
+  ter_set(x, y, t_rubble);
  }
 
  if (makesound)
@@ -1748,7 +1821,7 @@ void map::shoot(game *g, const int x, const int y, int &dam,
   if (hit_items || one_in(8)) {	// 1 in 8 chance of hitting the door
    dam -= rng(20, 40);
    if (dam > 0)
-    ter(x, y) = t_dirt;
+    ter_set(x, y, t_dirt);
   } else
    dam -= rng(0, 1);
   break;
@@ -1759,26 +1832,26 @@ void map::shoot(game *g, const int x, const int y, int &dam,
  case t_door_locked_alarm:
   dam -= rng(15, 30);
   if (dam > 0)
-   ter(x, y) = t_door_b;
+   ter_set(x, y, t_door_b);
   break;
 
  case t_door_boarded:
   dam -= rng(15, 35);
   if (dam > 0)
-   ter(x, y) = t_door_b;
+   ter_set(x, y, t_door_b);
   break;
 
  case t_window:
  case t_window_domestic:
  case t_window_alarm:
   dam -= rng(0, 5);
-  ter(x, y) = t_window_frame;
+  ter_set(x, y, t_window_frame);
   break;
 
  case t_window_boarded:
   dam -= rng(10, 30);
   if (dam > 0)
-   ter(x, y) = t_window_frame;
+   ter_set(x, y, t_window_frame);
   break;
 
  case t_wall_glass_h:
@@ -1786,13 +1859,13 @@ void map::shoot(game *g, const int x, const int y, int &dam,
  case t_wall_glass_h_alarm:
  case t_wall_glass_v_alarm:
   dam -= rng(0, 8);
-  ter(x, y) = t_floor;
+  ter_set(x, y, t_floor);
   break;
 
  case t_paper:
   dam -= rng(4, 16);
   if (dam > 0)
-   ter(x, y) = t_dirt;
+   ter_set(x, y, t_dirt);
   if (effects & mfb(AMMO_INCENDIARY))
    add_field(g, x, y, fd_fire, 1);
   break;
@@ -1810,7 +1883,7 @@ void map::shoot(game *g, const int x, const int y, int &dam,
       }
      }
     }
-    ter(x, y) = t_gas_pump_smashed;
+    ter_set(x, y, t_gas_pump_smashed);
    }
    dam -= 60;
   }
@@ -1819,7 +1892,7 @@ void map::shoot(game *g, const int x, const int y, int &dam,
  case t_vat:
   if (dam >= 10) {
    g->sound(x, y, 15, "ke-rash!");
-   ter(x, y) = t_floor;
+   ter_set(x, y, t_floor);
   } else
    dam = 0;
   break;
@@ -1900,30 +1973,30 @@ bool map::hit_with_acid(game *g, const int x, const int y)
   case t_wall_glass_v_alarm:
   case t_wall_glass_h_alarm:
   case t_vat:
-   ter(x, y) = t_floor;
+   ter_set(x, y, t_floor);
    break;
 
   case t_door_c:
   case t_door_locked:
   case t_door_locked_alarm:
    if (one_in(3))
-    ter(x, y) = t_door_b;
+    ter_set(x, y, t_door_b);
    break;
 
   case t_door_b:
    if (one_in(4))
-    ter(x, y) = t_door_frame;
+    ter_set(x, y, t_door_frame);
    else
     return false;
    break;
 
   case t_window:
   case t_window_alarm:
-   ter(x, y) = t_window_empty;
+   ter_set(x, y, t_window_empty);
    break;
 
   case t_wax:
-   ter(x, y) = t_floor_wax;
+   ter_set(x, y, t_floor_wax);
    break;
 
   case t_toilet:
@@ -1936,7 +2009,7 @@ bool map::hit_with_acid(game *g, const int x, const int y)
 
   case t_card_science:
   case t_card_military:
-   ter(x, y) = t_card_reader_broken;
+   ter_set(x, y, t_card_reader_broken);
    break;
  }
 
@@ -1950,47 +2023,47 @@ void map::marlossify(const int x, const int y)
   case 1:
   case 2:
   case 3:
-  case 4: ter(x, y) = t_fungus;      break;
+  case 4: ter_set(x, y, t_fungus);      break;
   case 5:
   case 6:
-  case 7: ter(x, y) = t_marloss;     break;
-  case 8: ter(x, y) = t_tree_fungal; break;
-  case 9: ter(x, y) = t_slime;       break;
+  case 7: ter_set(x, y, t_marloss);     break;
+  case 8: ter_set(x, y, t_tree_fungal); break;
+  case 9: ter_set(x, y, t_slime);       break;
  }
 }
 
 bool map::open_door(const int x, const int y, const bool inside)
 {
  if (ter(x, y) == t_door_c) {
-  ter(x, y) = t_door_o;
+  ter_set(x, y, t_door_o);
   return true;
  } else if (ter(x, y) == t_canvas_door) {
-  ter(x, y) = t_canvas_door_o;
+  ter_set(x, y, t_canvas_door_o);
   return true;
  } else if (ter(x, y) == t_skin_door) {
-  ter(x, y) = t_skin_door_o;
+  ter_set(x, y, t_skin_door_o);
   return true;
  } else if (inside && ter(x, y) == t_curtains) {
-  ter(x, y) = t_window_domestic;
+  ter_set(x, y, t_window_domestic);
   return true;
  } else if (inside && ter(x, y) == t_window_domestic) {
-  ter(x, y) = t_window_open;
+  ter_set(x, y, t_window_open);
   return true;
  } else if (ter(x, y) == t_chaingate_c) {
-  ter(x, y) = t_chaingate_o;
+  ter_set(x, y, t_chaingate_o);
   return true;
  } else if (ter(x, y) == t_fencegate_c) {
-  ter(x, y) = t_fencegate_o;
+  ter_set(x, y, t_fencegate_o);
   return true;
  } else if (ter(x, y) == t_door_metal_c) {
-  ter(x, y) = t_door_metal_o;
+  ter_set(x, y, t_door_metal_o);
   return true;
  } else if (ter(x, y) == t_door_glass_c) {
-  ter(x, y) = t_door_glass_o;
+  ter_set(x, y, t_door_glass_o);
   return true;
  } else if (inside &&
             (ter(x, y) == t_door_locked || ter(x, y) == t_door_locked_alarm)) {
-  ter(x, y) = t_door_o;
+  ter_set(x, y, t_door_o);
   return true;
  }
  return false;
@@ -2006,7 +2079,7 @@ void map::translate(const ter_id from, const ter_id to)
  for (int x = 0; x < SEEX * my_MAPSIZE; x++) {
   for (int y = 0; y < SEEY * my_MAPSIZE; y++) {
    if (ter(x, y) == from)
-    ter(x, y) = to;
+    ter_set(x, y, to);
   }
  }
 }
@@ -2014,30 +2087,30 @@ void map::translate(const ter_id from, const ter_id to)
 bool map::close_door(const int x, const int y, const bool inside)
 {
  if (ter(x, y) == t_door_o) {
-  ter(x, y) = t_door_c;
+  ter_set(x, y, t_door_c);
   return true;
  } else if (inside && ter(x, y) == t_window_domestic) {
-  ter(x, y) = t_curtains;
+  ter_set(x, y, t_curtains);
   return true;
  } else if (ter(x, y) == t_canvas_door_o) {
-  ter(x, y) = t_canvas_door;
+  ter_set(x, y, t_canvas_door);
   return true;
  } else if (ter(x, y) == t_skin_door_o) {
-  ter(x, y) = t_skin_door;
+  ter_set(x, y, t_skin_door);
   return true;
  } else if (inside && ter(x, y) == t_window_open) {
-  ter(x, y) = t_window_domestic;
+  ter_set(x, y, t_window_domestic);
   return true;
  } else if (ter(x, y) == t_chaingate_o) {
-  ter(x, y) = t_chaingate_c;
+  ter_set(x, y, t_chaingate_c);
   return true;
   } else if (ter(x, y) == t_fencegate_o) {
-  ter(x, y) = t_fencegate_c;
+  ter_set(x, y, t_fencegate_c);
  } else if (ter(x, y) == t_door_metal_o) {
-  ter(x, y) = t_door_metal_c;
+  ter_set(x, y, t_door_metal_c);
   return true;
  } else if (ter(x, y) == t_door_glass_o) {
-  ter(x, y) = t_door_glass_c;
+  ter_set(x, y, t_door_glass_c);
   return true;
  }
  return false;
@@ -2057,7 +2130,7 @@ int& map::radiation(const int x, const int y)
 
  const int lx = x % SEEX;
  const int ly = y % SEEY;
- return grid[nonant]->rad[lx][ly];
+ return grid[nonant]->rad_at(lx, ly);
 }
 
 std::vector<item>& map::i_at(const int x, const int y)
@@ -2074,7 +2147,23 @@ std::vector<item>& map::i_at(const int x, const int y)
 
  const int lx = x % SEEX;
  const int ly = y % SEEY;
- return grid[nonant]->itm[lx][ly];
+ return grid[nonant]->items_at(lx, ly);
+}
+
+int map::radiation_peek(const int x, const int y) const
+{
+ if (!INBOUNDS(x, y))
+  return 0;
+ const int nonant = int(x / SEEX) + int(y / SEEY) * my_MAPSIZE;
+ return grid[nonant]->peek_rad(x % SEEX, y % SEEY);
+}
+
+const std::vector<item>& map::i_peek(const int x, const int y) const
+{
+ if (!INBOUNDS(x, y))
+  return submap::no_items;
+ const int nonant = int(x / SEEX) + int(y / SEEY) * my_MAPSIZE;
+ return grid[nonant]->peek_items(x % SEEX, y % SEEY);
 }
 
 item map::water_from(const int x, const int y)
@@ -2138,7 +2227,7 @@ void map::add_item(const int x, const int y, itype* type, const int birthday, co
  add_item(x, y, tmp);
 }
 
-void map::add_item(const int x, const int y, item new_item)
+void map::add_item(const int x, const int y, const item &new_item)
 {
  if (new_item.is_style())
   return;
@@ -2178,7 +2267,7 @@ void map::add_item(const int x, const int y, item new_item)
 
  const int lx = x % SEEX;
  const int ly = y % SEEY;
- grid[nonant]->itm[lx][ly].push_back(new_item);
+ grid[nonant]->items_at(lx, ly).push_back(new_item);
  if (new_item.active)
   grid[nonant]->active_item_count++;
 }
@@ -2197,28 +2286,28 @@ void map::process_active_items_in_submap(game *g, const int nonant)
 {
  it_tool* tmp;
  iuse use;
- for (int i = 0; i < SEEX; i++) {
-  for (int j = 0; j < SEEY; j++) {
-   std::vector<item> *items = &(grid[nonant]->itm[i][j]);
-   for (int n = 0; n < items->size(); n++) {
-    if ((*items)[n].active) {
-     if (!(*items)[n].is_tool()) { // It's probably a charger gun
-      (*items)[n].active = false;
-      (*items)[n].charges = 0;
-     } else {
-      tmp = dynamic_cast<it_tool*>((*items)[n].type);
-      (use.*tmp->use)(g, &(g->u), &((*items)[n]), true);
-      if (tmp->turns_per_charge > 0 && int(g->turn) % tmp->turns_per_charge ==0)
-       (*items)[n].charges--;
-      if ((*items)[n].charges <= 0) {
-       (use.*tmp->use)(g, &(g->u), &((*items)[n]), false);
-       if (tmp->revert_to == itm_null || (*items)[n].charges == -1) {
-        items->erase(items->begin() + n);
-        grid[nonant]->active_item_count--;
-        n--;
-       } else
-        (*items)[n].type = g->itypes[tmp->revert_to];
-      }
+ std::map<int, std::vector<item> > &piles = grid[nonant]->itm;
+ for (std::map<int, std::vector<item> >::iterator pile = piles.begin();
+      pile != piles.end(); pile++) {
+  std::vector<item> *items = &(pile->second);
+  for (int n = 0; n < items->size(); n++) {
+   if ((*items)[n].active) {
+    if (!(*items)[n].is_tool()) { // It's probably a charger gun
+     (*items)[n].active = false;
+     (*items)[n].charges = 0;
+    } else {
+     tmp = dynamic_cast<it_tool*>((*items)[n].type);
+     (use.*tmp->use)(g, &(g->u), &((*items)[n]), true);
+     if (tmp->turns_per_charge > 0 && int(g->turn) % tmp->turns_per_charge ==0)
+      (*items)[n].charges--;
+     if ((*items)[n].charges <= 0) {
+      (use.*tmp->use)(g, &(g->u), &((*items)[n]), false);
+      if (tmp->revert_to == itm_null || (*items)[n].charges == -1) {
+       items->erase(items->begin() + n);
+       grid[nonant]->active_item_count--;
+       n--;
+      } else
+       (*items)[n].type = g->itypes[tmp->revert_to];
      }
     }
    }
@@ -2401,7 +2490,15 @@ field& map::field_at(const int x, const int y)
 
  const int lx = x % SEEX;
  const int ly = y % SEEY;
- return grid[nonant]->fld[lx][ly];
+ return grid[nonant]->field_at(lx, ly);
+}
+
+const field& map::field_peek(const int x, const int y) const
+{
+ if (!INBOUNDS(x, y))
+  return submap::no_field;
+ const int nonant = int(x / SEEX) + int(y / SEEY) * my_MAPSIZE;
+ return grid[nonant]->peek_field(x % SEEX, y % SEEY);
 }
 
 bool map::add_field(game *g, const int x, const int y,
@@ -2411,9 +2508,9 @@ bool map::add_field(game *g, const int x, const int y,
 
  if (!INBOUNDS(x, y))
   return false;
- if (field_at(x, y).type == fd_web && t == fd_fire)
+ if (field_peek(x, y).type == fd_web && t == fd_fire)
   density++;
- else if (!field_at(x, y).is_null()) // Blood & bile are null too
+ else if (!field_peek(x, y).is_null()) // Blood & bile are null too
   return false;
  if (density > 3)
   density = 3;
@@ -2423,11 +2520,12 @@ bool map::add_field(game *g, const int x, const int y,
 
  const int lx = x % SEEX;
  const int ly = y % SEEY;
- if (grid[nonant]->fld[lx][ly].type == fd_null)
+ field &fd = grid[nonant]->field_at(lx, ly);
+ if (fd.type == fd_null)
   grid[nonant]->field_count++;
- grid[nonant]->fld[lx][ly] = field(t, density, 0);
- if (g != NULL && lx == g->u.posx && ly == g->u.posy &&
-     grid[nonant]->fld[lx][ly].is_dangerous()) {
+ fd = field(t, density, 0);
+ sight_change_count++;
+ if (g != NULL && lx == g->u.posx && ly == g->u.posy && fd.is_dangerous()) {
   g->cancel_activity_query("You're in a %s!",
                            fieldlist[t].name[density - 1].c_str());
  }
@@ -2442,9 +2540,14 @@ void map::remove_field(const int x, const int y)
 
  const int lx = x % SEEX;
  const int ly = y % SEEY;
- if (grid[nonant]->fld[lx][ly].type != fd_null)
+// Leave the entry for compact(), so process_fields_in_submap() can call this
+ std::map<int, field>::iterator fd = grid[nonant]->fld.find(submap::tile(lx, ly));
+ if (fd == grid[nonant]->fld.end())
+  return;
+ if (fd->second.type != fd_null)
   grid[nonant]->field_count--;
- grid[nonant]->fld[lx][ly] = field();
+ fd->second = field();
+ sight_change_count++;
 }
 
 computer* map::computer_at(const int x, const int y)
@@ -2459,9 +2562,9 @@ computer* map::computer_at(const int x, const int y)
 
  const int lx = x % SEEX;
  const int ly = y % SEEY;
- if (grid[nonant]->comp.name == "")
+ if (grid[nonant]->comp == NULL || grid[nonant]->comp->name == "")
   return NULL;
- return &(grid[nonant]->comp);
+ return grid[nonant]->comp;
 }
 
 bool map::allow_camp(const int x, const int y, const int radius)
@@ -2485,10 +2588,10 @@ basecamp* map::camp_at(const int x, const int y, const int radius)
  	for( int lx = sx; lx < ex; ++lx )
  	{
  		int nonant = lx + ly * my_MAPSIZE;
- 		if (grid[nonant]->camp.is_valid())
+ 		if (grid[nonant]->camp != NULL && grid[nonant]->camp->is_valid())
  		{
  			// we only allow on camp per size radius, kinda
- 			return &(grid[nonant]->camp);
+ 			return grid[nonant]->camp;
  		}
  	}
  }
@@ -2504,7 +2607,8 @@ void map::add_camp(const std::string& name, const int x, const int y)
 	}
 
 	const int nonant = int(x / SEEX) + int(y / SEEY) * my_MAPSIZE;
-	grid[nonant]->camp = basecamp(name, x, y);
+	delete grid[nonant]->camp;
+	grid[nonant]->camp = new basecamp(name, x, y);
 }
 
 void map::debug()
@@ -2678,11 +2782,12 @@ void map::drawsq(WINDOW* w, player &u, const int x, const int y, const bool inve
    sym = (*traps)[tr_at(x, y)]->sym;
  }
 // If there's a field here, draw that instead (unless its symbol is %)
- if (field_at(x, y).type != fd_null &&
-     fieldlist[field_at(x, y).type].sym != '&') {
-  tercol = fieldlist[field_at(x, y).type].color[field_at(x, y).density - 1];
+ const field &field_here = field_peek(x, y);
+ if (field_here.type != fd_null &&
+     fieldlist[field_here.type].sym != '&') {
+  tercol = fieldlist[field_here.type].color[field_here.density - 1];
   drew_field = true;
-  if (fieldlist[field_at(x, y).type].sym == '*') {
+  if (fieldlist[field_here.type].sym == '*') {
    switch (rng(1, 5)) {
     case 1: sym = '*'; break;
     case 2: sym = '0'; break;
@@ -2690,21 +2795,22 @@ void map::drawsq(WINDOW* w, player &u, const int x, const int y, const bool inve
     case 4: sym = '&'; break;
     case 5: sym = '+'; break;
    }
-  } else if (fieldlist[field_at(x, y).type].sym != '%' ||
-             i_at(x, y).size() > 0) {
-   sym = fieldlist[field_at(x, y).type].sym;
+  } else if (fieldlist[field_here.type].sym != '%' ||
+             !i_peek(x, y).empty()) {
+   sym = fieldlist[field_here.type].sym;
    drew_field = false;
   }
  }
 // If there's items here, draw those instead
- if (show_items && !has_flag(container, x, y) && i_at(x, y).size() > 0 && !drew_field) {
+ const std::vector<item> &items_here = i_peek(x, y);
+ if (show_items && !has_flag(container, x, y) && !items_here.empty() && !drew_field) {
   if ((terlist[curr_ter].sym != '.'))
    hi = true;
   else {
-   tercol = i_at(x, y)[i_at(x, y).size() - 1].color();
-   if (i_at(x, y).size() > 1)
+   tercol = items_here.back().color();
+   if (items_here.size() > 1)
     invert = !invert;
-   sym = i_at(x, y)[i_at(x, y).size() - 1].symbol();
+   sym = items_here.back().symbol();
   }
  }
 
@@ -2737,132 +2843,57 @@ void map::drawsq(WINDOW* w, player &u, const int x, const int y, const bool inve
 map::sees based off code by Steve Register [arns@arns.freeservers.com]
 http://roguebasin.roguelikedevelopment.org/index.php?title=Simple_Line_of_Sight
 */
+// Predicates for find_clear_line(); xmax and ymax are the map's bounds
+struct sight_clear {
+ map *m;
+ char *trans_buf;
+ int xmax, ymax;
+ bool operator()(int x, int y)
+ {
+  return m->trans(x, y, trans_buf) && x >= 0 && x < xmax && y >= 0 && y < ymax;
+ }
+};
+
+struct path_clear {
+ map *m;
+ int cost_min, cost_max;
+ int xmax, ymax;
+ bool operator()(int x, int y)
+ {
+  const int cost = m->move_cost(x, y);
+  return cost >= cost_min && cost <= cost_max &&
+         x >= 0 && x < xmax && y >= 0 && y < ymax;
+ }
+};
+
 bool map::sees(const int Fx, const int Fy, const int Tx, const int Ty,
                const int range, int &tc, char * trans_buf)
 {
- const int dx = Tx - Fx;
- const int dy = Ty - Fy;
- const int ax = abs(dx) << 1;
- const int ay = abs(dy) << 1;
- const int sx = SGN(dx);
- const int sy = SGN(dy);
- int x = Fx;
- int y = Fy;
- int t = 0;
- int st;
-
- if (range >= 0 && (abs(dx) > range || abs(dy) > range))
+ if (range >= 0 && (abs(Tx - Fx) > range || abs(Ty - Fy) > range))
   return false;	// Out of range!
- if (ax > ay) { // Mostly-horizontal line
-  st = SGN(ay - (ax >> 1));
-// Doing it "backwards" prioritizes straight lines before diagonal.
+// Straight lines are tried before diagonal ones.
 // This will help avoid creating a string of zombies behind you and will
 // promote "mobbing" behavior (zombies surround you to beat on you)
-  for (tc = abs(ay - (ax >> 1)) * 2 + 1; tc >= -1; tc--) {
-   t = tc * st;
-   x = Fx;
-   y = Fy;
-   do {
-    if (t > 0) {
-     y += sy;
-     t -= ax;
-    }
-    x += sx;
-    t += ay;
-    if (x == Tx && y == Ty) {
-     tc *= st;
-     return true;
-    }
-   } while ((trans(x, y, trans_buf)) && (INBOUNDS(x,y)));
-  }
-  return false;
- } else { // Same as above, for mostly-vertical lines
-  st = SGN(ax - (ay >> 1));
-  for (tc = abs(ax - (ay >> 1)) * 2 + 1; tc >= -1; tc--) {
-  t = tc * st;
-  x = Fx;
-  y = Fy;
-   do {
-    if (t > 0) {
-     x += sx;
-     t -= ay;
-    }
-    y += sy;
-    t += ax;
-    if (x == Tx && y == Ty) {
-     tc *= st;
-     return true;
-    }
-   } while ((trans(x, y, trans_buf)) && (INBOUNDS(x,y)));
-  }
-  return false;
- }
- return false; // Shouldn't ever be reached, but there it is.
+ sight_clear clear;
+ clear.m = this;
+ clear.trans_buf = trans_buf;
+ clear.xmax = SEEX * my_MAPSIZE;
+ clear.ymax = SEEY * my_MAPSIZE;
+ return find_clear_line(Fx, Fy, Tx, Ty, clear, tc);
 }
 
 bool map::clear_path(const int Fx, const int Fy, const int Tx, const int Ty,
                      const int range, const int cost_min, const int cost_max, int &tc)
 {
- const int dx = Tx - Fx;
- const int dy = Ty - Fy;
- const int ax = abs(dx) << 1;
- const int ay = abs(dy) << 1;
- const int sx = SGN(dx);
- const int sy = SGN(dy);
- int x = Fx;
- int y = Fy;
- int t = 0;
- int st;
-
- if (range >= 0 && (abs(dx) > range || abs(dy) > range))
+ if (range >= 0 && (abs(Tx - Fx) > range || abs(Ty - Fy) > range))
   return false;	// Out of range!
- if (ax > ay) { // Mostly-horizontal line
-  st = SGN(ay - (ax >> 1));
-// Doing it "backwards" prioritizes straight lines before diagonal.
-// This will help avoid creating a string of zombies behind you and will
-// promote "mobbing" behavior (zombies surround you to beat on you)
-  for (tc = abs(ay - (ax >> 1)) * 2 + 1; tc >= -1; tc--) {
-   t = tc * st;
-   x = Fx;
-   y = Fy;
-   do {
-    if (t > 0) {
-     y += sy;
-     t -= ax;
-    }
-    x += sx;
-    t += ay;
-    if (x == Tx && y == Ty) {
-     tc *= st;
-     return true;
-    }
-   } while (move_cost(x, y) >= cost_min && move_cost(x, y) <= cost_max &&
-            INBOUNDS(x, y));
-  }
-  return false;
- } else { // Same as above, for mostly-vertical lines
-  st = SGN(ax - (ay >> 1));
-  for (tc = abs(ax - (ay >> 1)) * 2 + 1; tc >= -1; tc--) {
-  t = tc * st;
-  x = Fx;
-  y = Fy;
-   do {
-    if (t > 0) {
-     x += sx;
-     t -= ay;
-    }
-    y += sy;
-    t += ax;
-    if (x == Tx && y == Ty) {
-     tc *= st;
-     return true;
-    }
-   } while (move_cost(x, y) >= cost_min && move_cost(x, y) <= cost_max &&
-            INBOUNDS(x,y));
-  }
-  return false;
- }
- return false; // Shouldn't ever be reached, but there it is.
+ path_clear clear;
+ clear.m = this;
+ clear.cost_min = cost_min;
+ clear.cost_max = cost_max;
+ clear.xmax = SEEX * my_MAPSIZE;
+ clear.ymax = SEEY * my_MAPSIZE;
+ return find_clear_line(Fx, Fy, Tx, Ty, clear, tc);
 }
 
 // Bash defaults to true.
@@ -3038,6 +3069,18 @@ void map::shift(game *g, const int wx, const int wy, const int wz, const int sx,
  // Clear vehicle list and rebuild after shift
  clear_vehicle_cache();
  vehicle_list.clear();
+// Submaps shifted off the map stay in the mapbuffer; trim the empty item piles
+//  and radiation our lookups left in them.  They were in use until now, so
+//  they are the last the mapbuffer should evict.
+ for (int gridx = 0; gridx < my_MAPSIZE; gridx++) {
+  for (int gridy = 0; gridy < my_MAPSIZE; gridy++) {
+   if (gridx < sx || gridx >= my_MAPSIZE + sx ||
+       gridy < sy || gridy >= my_MAPSIZE + sy) {
+    grid[gridx + gridy * my_MAPSIZE]->compact();
+    grid[gridx + gridy * my_MAPSIZE]->turn_last_used = int(g->turn);
+   }
+  }
+ }
 // Shift the map sx submaps to the right and sy submaps down.
 // sx and sy should never be bigger than +/-1.
 // wx and wy are our position in the world, for saving/loading purposes.
@@ -3157,6 +3200,7 @@ bool map::loadn(game *g, const int worldx, const int worldy, const int worldz, c
  submap *tmpsub = MAPBUFFER.lookup_submap(absx, absy, worldz);
  if (tmpsub) {
   grid[gridn] = tmpsub;
+  invalidate_outside_masks();
 
   // Update vehicle data
   for( std::vector<vehicle*>::iterator it = tmpsub->vehicles.begin(),
@@ -3209,6 +3253,7 @@ bool map::loadn(game *g, const int worldx, const int worldy, const int worldz, c
 void map::copy_grid(const int to, const int from)
 {
  grid[to] = grid[from];
+ invalidate_outside_masks();
  for( std::vector<vehicle*>::iterator it = grid[to]->vehicles.begin(),
        end = grid[to]->vehicles.end(); it != end; ++it ) {
   (*it)->smx = to % my_MAPSIZE;
@@ -3253,6 +3298,11 @@ void map::spawn_monsters(game *g)
       tmp.spawnposy = fy;
       tmp.spawn(fx, fy);
       g->z.push_back(tmp);
+      if (tmp.mission_id != -1) {
+       mission *miss = g->find_mission(tmp.mission_id);
+       if (miss != NULL)
+        miss->monster = g->z.handle_at(g->z.size() - 1);
+      }
      }
     }
    }
@@ -3283,6 +3333,15 @@ bool map::inbounds(const int x, const int y)
  return (x >= 0 && x < SEEX * my_MAPSIZE && y >= 0 && y < SEEY * my_MAPSIZE);
 }
 
+bool map::uses_submap(const submap *sm) const
+{
+ for (int i = 0; i < my_MAPSIZE * my_MAPSIZE; i++) {
+  if (grid[i] == sm)
+   return true;
+ }
+ return false;
+}
+
 bool map::add_graffiti(game *g, int x, int y, std::string contents)
 {
   int nx = x;
@@ -3290,7 +3349,7 @@ bool map::add_graffiti(game *g, int x, int y, std::string contents)
   int nonant = int(nx / SEEX) + int(ny / SEEY) * my_MAPSIZE;
   nx %= SEEX;
   ny %= SEEY;
-  grid[nonant]->graf[nx][ny] = graffiti(contents);
+  grid[nonant]->graf[submap::tile(nx, ny)] = contents;
   return true;
 }
 
@@ -3306,7 +3365,10 @@ graffiti map::graffiti_at(int x, int y)
 
  x %= SEEX;
  y %= SEEY;
- return grid[nonant]->graf[x][y];
+ std::map<int, std::string>::iterator graf = grid[nonant]->graf.find(submap::tile(x, y));
+ if (graf == grid[nonant]->graf.end())
+  return graffiti();
+ return graffiti(graf->second);
 }
 
 long map::determine_wall_corner(int x, int y, long sym)
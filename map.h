@@ -37,6 +37,34 @@ struct wrapped_vehicle{
 
 typedef std::vector<wrapped_vehicle> VehicleList;
 
+// Everything map::generate() needs to know about one spot in the world.
+// It is filled in on the main thread (looking up the overmap neighborhood may
+//  load or create overmaps); after that a generation job only reads it, so
+//  several jobs, each with its own map, may run at once.
+struct mapgen_context
+{
+ game *g; // Vehicle prototypes only; generation never writes to it
+ std::vector<mtype*> *mtypes;
+ point om_pos; // The overmap the submaps belong to
+ int x, y, z;  // Submap coordinates within that overmap
+ int turn;
+ oter_id terrain_type, t_north, t_east, t_south, t_west, t_above;
+ unsigned zones;
+ float density; // Static spawn density, scaled by distance to the closest city
+
+ mapgen_context(game *g, overmap *om, const int x, const int y, const int z,
+                const int turn);
+};
+
+// Items that need the game to create a new item type are placed after the
+//  job finishes, back on the main thread.
+struct mapgen_artifact
+{
+ int x, y;
+ bool natural;
+ artifact_natural_property prop;
+};
+
 class map
 {
  public:
@@ -45,7 +73,7 @@ class map
  map();
  map(std::vector<itype*> *itptr, std::vector<itype_id> (*miptr)[num_itloc],
      std::vector<trap*> *trptr);
- ~map();
+ virtual ~map();
 
 // Visual Output
  void draw(game *g, WINDOW* w, const point center);
@@ -107,6 +135,8 @@ class map
 
 // Terrain
  ter_id& ter(const int x, const int y); // Terrain at coord (x, y); {x|y}=(0, SEE{X|Y}*3]
+ void ter_set(const int x, const int y, const ter_id new_terrain); // Use this to change terrain
+ int sight_changes() const { return sight_change_count; }; // Up with ter_set(), fields or loads
  bool is_indoor(const int x, const int y); // Check if current ter is indoors
  std::string tername(const int x, const int y); // Name of terrain at (x, y)
  std::string features(const int x, const int y); // Words relevant to terrain (sharp, etc)
@@ -115,6 +145,7 @@ class map
  bool is_destructable(const int x, const int y);        // checks terrain and vehicles
  bool is_destructable_ter_only(const int x, const int y);       // only checks terrain
  bool is_outside(const int x, const int y);
+ bool is_outside_ter_only(const int x, const int y); // Ignores vehicles
  bool flammable_items_at(const int x, const int y);
  bool moppable_items_at(const int x, const int y);
  point random_outdoor_tile();
@@ -133,15 +164,18 @@ class map
 
 // Radiation
  int& radiation(const int x, const int y);	// Amount of radiation at (x, y);
+ int radiation_peek(const int x, const int y) const; // Same, but read-only
 
 // Items
  std::vector<item>& i_at(int x, int y);
+// Read-only i_at(); unlike it, never leaves an empty pile behind
+ const std::vector<item>& i_peek(const int x, const int y) const;
  item water_from(const int x, const int y);
  void i_clear(const int x, const int y);
  void i_rem(const int x, const int y, const int index);
  point find_item(const item *it);
  void add_item(const int x, const int y, itype* type, int birthday, int quantity = 0);
- void add_item(const int x, const int y, item new_item);
+ void add_item(const int x, const int y, const item &new_item);
  void process_active_items(game *g);
  void process_active_items_in_submap(game *g, const int nonant);
  void process_vehicles(game *g);
@@ -157,6 +191,7 @@ class map
 
 // Fields
  field& field_at(const int x, const int y);
+ const field& field_peek(const int x, const int y) const; // Read-only field_at()
  bool add_field(game *g, const int x, const int y, const field_id t, const unsigned char density);
  void remove_field(const int x, const int y);
  bool process_fields(game *g);				// See fields.cpp
@@ -176,10 +211,17 @@ class map
  graffiti graffiti_at(int x, int y);
  bool add_graffiti(game *g, int x, int y, std::string contents);
 
+ bool uses_submap(const submap *sm) const; // Is sm loaded into our grid?
+
 // mapgen.cpp functions
  void generate(game *g, overmap *om, const int x, const int y, const int z, const int turn);
- void post_process(game *g, unsigned zones);
- void place_spawns(game *g, std::string group, const int chance,
+// generate() is the two halves below.  The first only touches this map and
+//  ctx, and the second saves the result, so only the first may run off the
+//  main thread.
+ void generate(const mapgen_context &ctx);
+ void finish_generate(game *g, overmap *om, const mapgen_context &ctx);
+ void post_process(const mapgen_context &ctx);
+ void place_spawns(std::string group, const int chance,
                    const int x1, const int y1, const int x2, const int y2, const float density);
  void place_items(items_location loc, const int chance, const int x1, const int y1,
                   const int x2, const int y2, bool ongrass, const int turn);
@@ -189,7 +231,10 @@ class map
                 const int faction_id = -1, const int mission_id = -1,
                 std::string name = "NONE");
  void add_spawn(monster *mon);
+ static spawn_point spawn_point_of(monster *mon); // Where add_spawn(mon) puts it
  void create_anomaly(const int cx, const int cy, artifact_natural_property prop);
+ void add_artifact(const int x, const int y, const bool natural = false,
+                   artifact_natural_property prop = ARTPROP_NULL);
  vehicle *add_vehicle(game *g, vhtype_id type, const int x, const int y, const int dir);
  computer* add_computer(const int x, const int y, std::string name, const int security);
 
@@ -204,10 +249,8 @@ protected:
  bool loadn(game *g, const int x, const int y, const int z, const int gridx, const int gridy,
             const  bool update_vehicles = true);
  void copy_grid(const int to, const int from);
- void draw_map(const oter_id terrain_type, const oter_id t_north, const oter_id t_east,
-               const oter_id t_south, const oter_id t_west, const oter_id t_above, const int turn,
-               game *g, const float density);
- void add_extra(map_extra type, game *g);
+ void draw_map(const mapgen_context &ctx, const oter_id terrain_type);
+ void add_extra(map_extra type, const mapgen_context &ctx);
  void rotate(const int turns);// Rotates the current map 90*turns degress clockwise
 			// Useful for houses, shops, etc
 
@@ -224,9 +267,19 @@ protected:
 
  std::vector <trap*> *traps;
  std::vector <itype_id> (*mapitems)[num_itloc];
+ std::vector<mapgen_artifact> pending_artifacts; // Filled by add_artifact()
 
  bool veh_in_active_range;
 
+// Bit y of outside_mask[n][x] is set if square (x, y) of grid[n] is outside
+//  by its terrain.  A submap's mask is rebuilt the first time it is needed
+//  after ter_set() or a load has touched it.
+ unsigned short outside_mask[MAPSIZE * MAPSIZE][SEEX];
+ bool outside_mask_valid[MAPSIZE * MAPSIZE];
+ void build_outside_mask(const int nonant);
+ void invalidate_outside_masks();
+ int sight_change_count;
+
 private:
  submap* grid[MAPSIZE * MAPSIZE];
 };
@@ -2,7 +2,12 @@
 #include "game.h"
 #include "output.h"
 #include "debug.h"
+#include "options.h"
+#include <algorithm>
 #include <fstream>
+#include <iterator>
+#include <sstream>
+#include <unistd.h>
 
 #define dbg(x) dout((DebugLevel)(x),D_MAP) << __FILE__ << ":" << __LINE__ << ": "
 
@@ -26,6 +31,11 @@ void mapbuffer::reset(){
 
  submaps.clear();
  submap_list.clear();
+
+ std::set<tripoint, pointcomp>::iterator ev;
+ for (ev = evicted.begin(); ev != evicted.end(); ev++)
+  (void)unlink(evicted_path(*ev).c_str());
+ evicted.clear();
 }
 
 // game g's existance does not imply that it has been identified, started, or loaded.
@@ -54,8 +64,11 @@ bool mapbuffer::add_submap(int x, int y, int z, submap *sm)
  if (submaps.count(p) != 0)
   return false;
 
- if (master_game)
+ if (master_game) {
   sm->turn_last_touched = int(master_game->turn);
+  sm->turn_last_used = sm->turn_last_touched;
+ }
+ sm->compact();
  submap_list.push_back(sm);
  submaps[p] = sm;
 
@@ -68,12 +81,108 @@ submap* mapbuffer::lookup_submap(int x, int y, int z)
 
  tripoint p(x, y, z);
 
- if (submaps.count(p) == 0)
+ std::map<tripoint, submap*, pointcomp>::iterator it = submaps.find(p);
+ submap *sm = NULL;
+ if (it != submaps.end())
+  sm = it->second;
+ else if (evicted.count(p) != 0)
+  sm = fault_in(p);
+ if (sm == NULL)
   return NULL;
 
- dbg(D_INFO) << "mapbuffer::lookup_submap success: "<< submaps[p];
+ dbg(D_INFO) << "mapbuffer::lookup_submap success: "<< sm;
+
+ if (master_game)
+  sm->turn_last_used = int(master_game->turn);
+ return sm;
+}
+
+std::string mapbuffer::evicted_path(const tripoint &p)
+{
+ std::stringstream path;
+ path << "save/submap." << p.x << "." << p.y << "." << p.z << ".txt";
+ return path.str();
+}
+
+submap* mapbuffer::fault_in(const tripoint &p)
+{
+ std::ifstream fin(evicted_path(p).c_str());
+ if (!fin.is_open()) {
+  debugmsg("Lost evicted submap (%d, %d, %d)", p.x, p.y, p.z);
+  evicted.erase(p);
+  return NULL;
+ }
+ tripoint loc;
+ submap *sm = load_submap(fin, loc, false);
+ fin.close();
+
+ evicted.erase(p);
+ (void)unlink(evicted_path(p).c_str());
+ submap_list.push_back(sm);
+ submaps[p] = sm;
+ return sm;
+}
+
+struct oldest_first
+{
+ bool operator() (const std::pair<int, tripoint> &lhs,
+                  const std::pair<int, tripoint> &rhs) const
+ {
+  return lhs.first < rhs.first;
+ }
+};
+
+void mapbuffer::evict_old_submaps(const map &m)
+{
+ const int budget = int(OPTIONS[OPT_RESIDENT_SUBMAPS]) * 100;
+ if (budget <= 0 || submaps.size() <= budget)
+  return;
+
+// Submaps on the map, or holding vehicles that the map's vehicle list points
+//  at, stay put.  The ones on the map are in use right now, so they are
+//  stamped as such in case the map leaves them behind without a shift.
+ std::vector<std::pair<int, tripoint> > candidates;
+ std::map<tripoint, submap*, pointcomp>::iterator it;
+ for (it = submaps.begin(); it != submaps.end(); it++) {
+  if (m.uses_submap(it->second)) {
+   if (master_game)
+    it->second->turn_last_used = int(master_game->turn);
+  } else if (it->second->vehicles.empty())
+   candidates.push_back(std::make_pair(it->second->turn_last_used, it->first));
+ }
+ std::sort(candidates.begin(), candidates.end(), oldest_first());
+
+// Go well under the budget, so this doesn't happen again every check
+ int excess = submaps.size() - budget * 3 / 4;
+ std::set<submap*> gone;
+ for (int i = 0; i < candidates.size() && excess > 0; i++) {
+  const tripoint &p = candidates[i].second;
+  submap *sm = submaps[p];
+  std::ofstream fout(evicted_path(p).c_str());
+  if (!fout.is_open())
+   break;
+  save_submap(fout, p, sm);
+  fout.close();
+  if (fout.fail()) {
+   (void)unlink(evicted_path(p).c_str());
+   break;
+  }
+  evicted.insert(p);
+  submaps.erase(p);
+  gone.insert(sm);
+  delete sm;
+  excess--;
+ }
 
- return submaps[p];
+ std::list<submap*>::iterator sl = submap_list.begin();
+ while (sl != submap_list.end()) {
+  if (gone.count(*sl) != 0)
+   sl = submap_list.erase(sl);
+  else
+   sl++;
+ }
+ dbg(D_INFO) << "mapbuffer::evict_old_submaps: evicted " << gone.size() <<
+                ", " << submaps.size() << " resident";
 }
 
 void mapbuffer::save_if_dirty()
@@ -88,102 +197,124 @@ void mapbuffer::save()
  std::ofstream fout;
  fout.open("save/maps.txt");
 
- fout << submap_list.size() << std::endl;
  int num_saved_submaps = 0;
- int num_total_submaps = submap_list.size();
+ int num_total_submaps = submap_list.size() + evicted.size();
+ fout << num_total_submaps << std::endl;
 
  for (it = submaps.begin(); it != submaps.end(); it++) {
   if (num_saved_submaps % 100 == 0)
    popup_nowait("Please wait as the map saves [%d/%d]",
                 num_saved_submaps, num_total_submaps);
+  save_submap(fout, it->first, it->second);
+  num_saved_submaps++;
+ }
+// Evicted submaps are already saved the same way; copy them in
+ std::set<tripoint, pointcomp>::iterator ev = evicted.begin();
+ while (ev != evicted.end()) {
+  if (num_saved_submaps % 100 == 0)
+   popup_nowait("Please wait as the map saves [%d/%d]",
+                num_saved_submaps, num_total_submaps);
+  std::ifstream fin(evicted_path(*ev).c_str());
+  if (!fin.is_open()) {
+   debugmsg("Lost evicted submap (%d, %d, %d)", ev->x, ev->y, ev->z);
+   evicted.erase(ev++);
+   continue;
+  }
+// Unlike << rdbuf(), an empty file copies nothing instead of failing fout
+  std::copy(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>(),
+            std::ostreambuf_iterator<char>(fout));
+  num_saved_submaps++;
+  ev++;
+ }
+ // Close the file; that's all we need.
+ fout.close();
+ if (fout.fail())
+  debugmsg("Failed to write save/maps.txt; the map may not have saved");
+}
 
-  fout << it->first.x << " " << it->first.y << " " << it->first.z << std::endl;
-  submap *sm = it->second;
-  fout << sm->turn_last_touched << std::endl;
+void mapbuffer::save_submap(std::ofstream &fout, const tripoint &p, submap *sm)
+{
+ fout << p.x << " " << p.y << " " << p.z << std::endl;
+ sm->compact();
+ fout << sm->turn_last_touched << std::endl;
 // Dump the terrain.
-  for (int j = 0; j < SEEY; j++) {
-   for (int i = 0; i < SEEX; i++)
-    fout << int(sm->ter[i][j]) << " ";
-   fout << std::endl;
-  }
- // Dump the radiation
-  for (int j = 0; j < SEEY; j++) {
-   for (int i = 0; i < SEEX; i++)
-    fout << sm->rad[i][j] << " ";
-  }
+ for (int j = 0; j < SEEY; j++) {
+  for (int i = 0; i < SEEX; i++)
+   fout << int(sm->ter[i][j]) << " ";
   fout << std::endl;
-
- // Items section; designate it with an I.  Then check itm[][] for each square
- //   in the grid and print the coords and the item's details.
- // Designate it with a C if it's contained in the prior item.
- // Also, this wastes space since we print the coords for each item, when we
- //   could be printing a list of items for each coord (except the empty ones)
-  item tmp;
-  for (int j = 0; j < SEEY; j++) {
-   for (int i = 0; i < SEEX; i++) {
-    for (int k = 0; k < sm->itm[i][j].size(); k++) {
-     tmp = sm->itm[i][j][k];
-     fout << "I " << i << " " << j << std::endl;
-     fout << tmp.save_info() << std::endl;
-     for (int l = 0; l < tmp.contents.size(); l++)
-      fout << "C " << std::endl << tmp.contents[l].save_info() << std::endl;
-    }
-   }
-  }
- // Output the traps
-  for (int j = 0; j < SEEY; j++) {
-   for (int i = 0; i < SEEX; i++) {
-    if (sm->trp[i][j] != tr_null)
-     fout << "T " << i << " " << j << " " << sm->trp[i][j] <<
-     std::endl;
-   }
-  }
-
- // Output the fields
-  field tmpf;
-  for (int j = 0; j < SEEY; j++) {
-   for (int i = 0; i < SEEX; i++) {
-    tmpf = sm->fld[i][j];
-    if (tmpf.type != fd_null)
-     fout << "F " << i << " " << j << " " << int(tmpf.type) << " " <<
-             int(tmpf.density) << " " << tmpf.age << std::endl;
-   }
+ }
+// Dump the radiation
+ for (int j = 0; j < SEEY; j++) {
+  for (int i = 0; i < SEEX; i++) {
+   std::map<int, int>::const_iterator rad = sm->rad.find(submap::tile(i, j));
+   fout << (rad == sm->rad.end() ? 0 : rad->second) << " ";
   }
- // Output the spawn points
-  spawn_point tmpsp;
-  for (int i = 0; i < sm->spawns.size(); i++) {
-   tmpsp = sm->spawns[i];
-   fout << "S " << int(tmpsp.type) << " " << tmpsp.count << " " << tmpsp.posx <<
-           " " << tmpsp.posy << " " << tmpsp.faction_id << " " <<
-           tmpsp.mission_id << (tmpsp.friendly ? " 1 " : " 0 ") <<
-           tmpsp.name << std::endl;
+ }
+ fout << std::endl;
+
+// Items section; designate it with an I.  Then go through each square in
+//   itm and print the coords and the item's details.
+// Designate it with a C if it's contained in the prior item.
+// Also, this wastes space since we print the coords for each item, when we
+//   could be printing a list of items for each coord
+ for (std::map<int, std::vector<item> >::iterator pile = sm->itm.begin();
+      pile != sm->itm.end(); pile++) {
+  const int i = pile->first / SEEY, j = pile->first % SEEY;
+  for (int k = 0; k < pile->second.size(); k++) {
+   item &tmp = pile->second[k];
+   fout << "I " << i << " " << j << std::endl;
+   fout << tmp.save_info() << std::endl;
+   for (int l = 0; l < tmp.contents.size(); l++)
+    fout << "C " << std::endl << tmp.contents[l].save_info() << std::endl;
   }
- // Output the vehicles
-  for (int i = 0; i < sm->vehicles.size(); i++) {
-   fout << "V ";
-   sm->vehicles[i]->save (fout);
+ }
+// Output the traps
+ for (int j = 0; j < SEEY; j++) {
+  for (int i = 0; i < SEEX; i++) {
+   if (sm->trp[i][j] != tr_null)
+    fout << "T " << i << " " << j << " " << sm->trp[i][j] <<
+    std::endl;
   }
- // Output the computer
-  if (sm->comp.name != "")
-   fout << "c " << sm->comp.save_data() << std::endl;
-
- // Output base camp if any
-  if (sm->camp.is_valid())
-  	fout << "B " << sm->camp.save_data() << std::endl;
+ }
 
- // Output the graffiti
+// Output the fields
  for (int j = 0; j < SEEY; j++) {
   for (int i = 0; i < SEEX; i++) {
-   if (sm->graf[i][j].contents)
-    fout << "G " << i << " " << j << *sm->graf[i][j].contents << std::endl;
+   const field &tmpf = sm->peek_field(i, j);
+   if (tmpf.type != fd_null)
+    fout << "F " << i << " " << j << " " << int(tmpf.type) << " " <<
+            int(tmpf.density) << " " << tmpf.age << std::endl;
   }
  }
-
-  fout << "----" << std::endl;
-  num_saved_submaps++;
+// Output the spawn points
+ spawn_point tmpsp;
+ for (int i = 0; i < sm->spawns.size(); i++) {
+  tmpsp = sm->spawns[i];
+  fout << "S " << int(tmpsp.type) << " " << tmpsp.count << " " << tmpsp.posx <<
+          " " << tmpsp.posy << " " << tmpsp.faction_id << " " <<
+          tmpsp.mission_id << (tmpsp.friendly ? " 1 " : " 0 ") <<
+          tmpsp.name << std::endl;
  }
- // Close the file; that's all we need.
- fout.close();
+// Output the vehicles
+ for (int i = 0; i < sm->vehicles.size(); i++) {
+  fout << "V ";
+  sm->vehicles[i]->save (fout);
+ }
+// Output the computer
+ if (sm->comp != NULL && sm->comp->name != "")
+  fout << "c " << sm->comp->save_data() << std::endl;
+
+// Output base camp if any
+ if (sm->camp != NULL && sm->camp->is_valid())
+ 	fout << "B " << sm->camp->save_data() << std::endl;
+
+// Output the graffiti
+ for (std::map<int, std::string>::iterator graf = sm->graf.begin();
+      graf != sm->graf.end(); graf++)
+  fout << "G " << graf->first / SEEY << " " << graf->first % SEEY <<
+          graf->second << std::endl;
+
+ fout << "----" << std::endl;
 }
 
 void mapbuffer::load()
@@ -192,117 +323,124 @@ void mapbuffer::load()
   debugmsg("Can't load mapbuffer without a master_game");
   return;
  }
- std::map<tripoint, submap*>::iterator it;
  std::ifstream fin;
  fin.open("save/maps.txt");
  if (!fin.is_open())
   return;
 
- int itx, ity, t, d, a, num_submaps, num_loaded=0;
- bool fields_here = false;
- item it_tmp;
- std::string databuff;
+ int num_submaps, num_loaded=0;
  fin >> num_submaps;
 
  while (!fin.eof()) {
   if (num_loaded % 100 == 0)
    popup_nowait("Please wait as the map loads [%d/%d]",
                 num_loaded, num_submaps);
-  int locx, locy, locz, turn;
-  submap* sm = new submap;
-  fin >> locx >> locy >> locz >> turn;
-  sm->turn_last_touched = turn;
-  int turndif = (master_game ? int(master_game->turn) - turn : 0);
-  if (turndif < 0)
-   turndif = 0;
+  tripoint p;
+  submap *sm = load_submap(fin, p, true);
+  submap_list.push_back(sm);
+  submaps[p] = sm;
+  num_loaded++;
+ }
+ fin.close();
+}
+
+// Radiation decays for as long as a submap sat in the save file; decay is
+//  false for evicted submaps, which were part of the running game all along.
+submap *mapbuffer::load_submap(std::ifstream &fin, tripoint &p, const bool decay)
+{
+ int itx, ity, t, d, a, turn;
+ bool fields_here = false;
+ item it_tmp;
+ std::string databuff;
+ submap* sm = new submap;
+ fin >> p.x >> p.y >> p.z >> turn;
+ sm->turn_last_touched = turn;
+ int turndif = (master_game && decay ? int(master_game->turn) - turn : 0);
+ if (turndif < 0)
+  turndif = 0;
 // Load terrain
-  for (int j = 0; j < SEEY; j++) {
-   for (int i = 0; i < SEEX; i++) {
-    int tmpter;
-    fin >> tmpter;
-    sm->ter[i][j] = ter_id(tmpter);
-    sm->itm[i][j].clear();
-    sm->trp[i][j] = tr_null;
-    sm->fld[i][j] = field();
-    sm->graf[i][j] = graffiti();
-   }
+ for (int j = 0; j < SEEY; j++) {
+  for (int i = 0; i < SEEX; i++) {
+   int tmpter;
+   fin >> tmpter;
+   sm->ter[i][j] = ter_id(tmpter);
+   sm->trp[i][j] = tr_null;
   }
+ }
 // Load irradiation
-  for (int j = 0; j < SEEY; j++) {
-   for (int i = 0; i < SEEX; i++) {
-    int radtmp;
-    fin >> radtmp;
-    radtmp -= int(turndif / 100);	// Radiation slowly decays
-    if (radtmp < 0)
-     radtmp = 0;
-    sm->rad[i][j] = radtmp;
-   }
+ for (int j = 0; j < SEEY; j++) {
+  for (int i = 0; i < SEEX; i++) {
+   int radtmp;
+   fin >> radtmp;
+   radtmp -= int(turndif / 100);	// Radiation slowly decays
+   if (radtmp > 0)
+    sm->rad_at(i, j) = radtmp;
   }
-// Load items and traps and fields and spawn points and vehicles
-  std::string string_identifier;
-  do {
-   fin >> string_identifier; // "----" indicates end of this submap
-   t = 0;
-   if (string_identifier == "I") {
-    fin >> itx >> ity;
-    getline(fin, databuff); // Clear out the endline
-    getline(fin, databuff);
-    it_tmp.load_info(databuff, master_game);
-    sm->itm[itx][ity].push_back(it_tmp);
-    if (it_tmp.active)
-     sm->active_item_count++;
-   } else if (string_identifier == "C") {
-    getline(fin, databuff); // Clear out the endline
-    getline(fin, databuff);
-    int index = sm->itm[itx][ity].size() - 1;
-    it_tmp.load_info(databuff, master_game);
-    sm->itm[itx][ity][index].put_in(it_tmp);
-    if (it_tmp.active)
-     sm->active_item_count++;
-   } else if (string_identifier == "T") {
-    fin >> itx >> ity >> t;
-    sm->trp[itx][ity] = trap_id(t);
-   } else if (string_identifier == "F") {
-    fields_here = true;
-    fin >> itx >> ity >> t >> d >> a;
-    sm->fld[itx][ity] = field(field_id(t), d, a);
-    sm->field_count++;
-   } else if (string_identifier == "S") {
-    char tmpfriend;
-    int tmpfac = -1, tmpmis = -1;
-    std::string spawnname;
-    fin >> t >> a >> itx >> ity >> tmpfac >> tmpmis >> tmpfriend >> spawnname;
-    spawn_point tmp(mon_id(t), a, itx, ity, tmpfac, tmpmis, (tmpfriend == '1'),
-                    spawnname);
-    sm->spawns.push_back(tmp);
-   } else if (string_identifier == "V") {
-    vehicle * veh = new vehicle(master_game);
-    veh->load (fin);
-    //veh.smx = gridx;
-    //veh.smy = gridy;
-    master_game->m.vehicle_list.insert(veh);
-    sm->vehicles.push_back(veh);
-   } else if (string_identifier == "c") {
-    getline(fin, databuff);
-    sm->comp.load_data(databuff);
-   } else if (string_identifier == "B") {
-    getline(fin, databuff);
-    sm->camp.load_data(databuff);
-   } else if (string_identifier == "G") {
-     std::string s;
-    int j;
-    int i;
-    fin >> j >> i;
-    getline(fin,s);
-    sm->graf[j][i] = graffiti(s);
-   }
-  } while (string_identifier != "----" && !fin.eof());
-
-  submap_list.push_back(sm);
-  submaps[ tripoint(locx, locy, locz) ] = sm;
-  num_loaded++;
  }
- fin.close();
+// Load items and traps and fields and spawn points and vehicles
+ std::string string_identifier;
+ do {
+  fin >> string_identifier; // "----" indicates end of this submap
+  t = 0;
+  if (string_identifier == "I") {
+   fin >> itx >> ity;
+   getline(fin, databuff); // Clear out the endline
+   getline(fin, databuff);
+   it_tmp.load_info(databuff, master_game);
+   sm->items_at(itx, ity).push_back(it_tmp);
+   if (it_tmp.active)
+    sm->active_item_count++;
+  } else if (string_identifier == "C") {
+   getline(fin, databuff); // Clear out the endline
+   getline(fin, databuff);
+   std::vector<item> &pile = sm->items_at(itx, ity);
+   it_tmp.load_info(databuff, master_game);
+   pile[pile.size() - 1].put_in(it_tmp);
+   if (it_tmp.active)
+    sm->active_item_count++;
+  } else if (string_identifier == "T") {
+   fin >> itx >> ity >> t;
+   sm->trp[itx][ity] = trap_id(t);
+  } else if (string_identifier == "F") {
+   fields_here = true;
+   fin >> itx >> ity >> t >> d >> a;
+   sm->field_at(itx, ity) = field(field_id(t), d, a);
+   sm->field_count++;
+  } else if (string_identifier == "S") {
+   char tmpfriend;
+   int tmpfac = -1, tmpmis = -1;
+   std::string spawnname;
+   fin >> t >> a >> itx >> ity >> tmpfac >> tmpmis >> tmpfriend >> spawnname;
+   spawn_point tmp(mon_id(t), a, itx, ity, tmpfac, tmpmis, (tmpfriend == '1'),
+                   spawnname);
+   sm->spawns.push_back(tmp);
+  } else if (string_identifier == "V") {
+   vehicle * veh = new vehicle(master_game);
+   veh->load (fin);
+   //veh.smx = gridx;
+   //veh.smy = gridy;
+   master_game->m.vehicle_list.insert(veh);
+   sm->vehicles.push_back(veh);
+  } else if (string_identifier == "c") {
+   getline(fin, databuff);
+   delete sm->comp;
+   sm->comp = new computer();
+   sm->comp->load_data(databuff);
+  } else if (string_identifier == "B") {
+   getline(fin, databuff);
+   delete sm->camp;
+   sm->camp = new basecamp();
+   sm->camp->load_data(databuff);
+  } else if (string_identifier == "G") {
+    std::string s;
+   int j;
+   int i;
+   fin >> j >> i;
+   getline(fin,s);
+   sm->graf[submap::tile(j, i)] = s;
+  }
+ } while (string_identifier != "----" && !fin.eof());
+ return sm;
 }
 
 int mapbuffer::size()
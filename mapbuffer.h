@@ -1,7 +1,9 @@
 #include "map.h"
 #include "line.h"
 #include <map>
+#include <set>
 #include <list>
+#include <iosfwd>
 
 class game;
 
@@ -37,13 +39,24 @@ class mapbuffer
   void reset();
 
   bool add_submap(int x, int y, int z, submap *sm);
+// Reads the submap back in from disk if it was evicted
   submap* lookup_submap(int x, int y, int z);
+// Writes the least recently used submaps to disk and frees them until
+//  we're under the OPT_RESIDENT_SUBMAPS budget.  Submaps on m or holding
+//  vehicles are never evicted.
+  void evict_old_submaps(const map &m);
 
   int size();
 
  private:
+  void save_submap(std::ofstream &fout, const tripoint &p, submap *sm);
+  submap* load_submap(std::ifstream &fin, tripoint &p, const bool decay);
+  std::string evicted_path(const tripoint &p);
+  submap* fault_in(const tripoint &p);
+
   std::map<tripoint, submap*, pointcomp> submaps;
   std::list<submap*> submap_list;
+  std::set<tripoint, pointcomp> evicted; // On disk, see evict_old_submaps()
   game *master_game;
   bool dirty;
 };
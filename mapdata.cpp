@@ -20,19 +20,14 @@ std::ostream & operator<<(std::ostream & out, const submap * sm)
  }
 
  out << "\n\titm:";
- for(int x = 0; x < SEEX; ++x)
+ for( std::map<int, std::vector<item> >::const_iterator pile = sm->itm.begin();
+      pile != sm->itm.end(); ++pile )
  {
-  for(int y = 0; y < SEEY; ++y)
+  for( std::vector<item>::const_iterator it = pile->second.begin(),
+    end = pile->second.end(); it != end; ++it )
   {
-   if( !sm->itm[x][y].empty() )
-   {
-    for( std::vector<item>::const_iterator it = sm->itm[x][y].begin(),
-      end = sm->itm[x][y].end(); it != end; ++it )
-    {
-     out << "\n\t("<<x<<","<<y<<") ";
-     out << *it << ", ";
-    }
-   }
+   out << "\n\t("<<pile->first / SEEY<<","<<pile->first % SEEY<<") ";
+   out << *it << ", ";
   }
  }
 
@@ -45,3 +40,53 @@ std::ostream & operator<<(std::ostream & out, const submap & sm)
  out << (&sm);
  return out;
 }
+
+submap::~submap()
+{
+ delete comp;
+ delete camp;
+}
+
+const std::vector<item> submap::no_items;
+const field submap::no_field;
+
+const std::vector<item> &submap::peek_items(const int x, const int y) const
+{
+ std::map<int, std::vector<item> >::const_iterator it = itm.find(tile(x, y));
+ return (it == itm.end() ? no_items : it->second);
+}
+
+int submap::peek_rad(const int x, const int y) const
+{
+ std::map<int, int>::const_iterator it = rad.find(tile(x, y));
+ return (it == rad.end() ? 0 : it->second);
+}
+
+const field &submap::peek_field(const int x, const int y) const
+{
+ std::map<int, field>::const_iterator it = fld.find(tile(x, y));
+ return (it == fld.end() ? no_field : it->second);
+}
+
+void submap::compact()
+{
+ for (std::map<int, std::vector<item> >::iterator it = itm.begin();
+      it != itm.end(); ) {
+  if (it->second.empty())
+   itm.erase(it++);
+  else
+   ++it;
+ }
+ for (std::map<int, int>::iterator it = rad.begin(); it != rad.end(); ) {
+  if (it->second == 0)
+   rad.erase(it++);
+  else
+   ++it;
+ }
+ for (std::map<int, field>::iterator it = fld.begin(); it != fld.end(); ) {
+  if (it->second.type == fd_null)
+   fld.erase(it++);
+  else
+   ++it;
+ }
+}
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <string>
+#include <map>
 #include "color.h"
 #include "item.h"
 #include "trap.h"
@@ -765,18 +766,18 @@ struct field {
   age = a;
  }
 
- bool is_null()
+ bool is_null() const
  {
   return (type == fd_null || type == fd_blood || type == fd_bile ||
           type == fd_slime);
  }
 
- bool is_dangerous()
+ bool is_dangerous() const
  {
   return fieldlist[type].dangerous[density - 1];
  }
 
- std::string name()
+ std::string name() const
  {
   return fieldlist[type].name[density - 1];
  }
@@ -800,18 +801,43 @@ struct spawn_point {
 
 struct submap {
  ter_id			ter[SEEX][SEEY]; // Terrain on each square
- std::vector<item>	itm[SEEX][SEEY]; // Items on each square
  trap_id		trp[SEEX][SEEY]; // Trap on each square
- field			fld[SEEX][SEEY]; // Field on each square
- int			rad[SEEX][SEEY]; // Irradiation of each square
- graffiti graf[SEEX][SEEY]; // Graffiti on each square
+// Most squares have no items, radiation, field or graffiti, so only the
+//  squares that do are kept, keyed by tile(x, y); see compact()
+ std::map<int, std::vector<item> > itm; // Items on each square
+ std::map<int, field> fld; // Field on each square
+ std::map<int, int>	rad; // Irradiation of each square
+ std::map<int, std::string> graf; // Graffiti on each square
  int active_item_count;
  int field_count;
- int turn_last_touched;
+ int turn_last_touched; // Saved; radiation decays from here on load
+ int turn_last_used;    // Not saved; the mapbuffer evicts the oldest first
  std::vector<spawn_point> spawns;
  std::vector<vehicle*> vehicles;
- computer comp;
- basecamp camp;  // only allowing one basecamp per submap
+ computer *comp; // NULL if there's no computer here
+ basecamp *camp; // NULL if there's no camp; only one basecamp per submap
+
+ submap() : active_item_count(0), field_count(0), turn_last_touched(0),
+            turn_last_used(0), comp(NULL), camp(NULL) {};
+ ~submap();
+
+ static int tile(const int x, const int y) { return x * SEEY + y; };
+ std::vector<item> &items_at(const int x, const int y) { return itm[tile(x, y)]; };
+ int &rad_at(const int x, const int y) { return rad[tile(x, y)]; };
+ field &field_at(const int x, const int y) { return fld[tile(x, y)]; };
+// Read-only versions of the above, which never add an entry
+ static const std::vector<item> no_items; // peek_items() of an empty square
+ static const field no_field; // peek_field() of an empty square
+ const std::vector<item> &peek_items(const int x, const int y) const;
+ int peek_rad(const int x, const int y) const;
+ const field &peek_field(const int x, const int y) const;
+// Drops the empty item piles, zero radiation and null fields that lookups
+//  leave behind
+ void compact();
+
+private:
+ submap(const submap &);
+ submap &operator=(const submap &);
 };
 
 std::ostream & operator<<(std::ostream &, const submap *);
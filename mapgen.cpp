@@ -81,41 +81,17 @@ void mansion_room(map *m, int x1, int y1, int x2, int y2); // pick & build
 void line(map *m, ter_id type, int x1, int y1, int x2, int y2);
 void square(map *m, ter_id type, int x1, int y1, int x2, int y2);
 void rough_circle(map *m, ter_id type, int x, int y, int rad);
-void add_corpse(game *g, map *m, int x, int y);
+void add_corpse(const mapgen_context &ctx, map *m, int x, int y);
 
-void map::generate(game *g, overmap *om, const int x, const int y, const int z, const int turn)
+mapgen_context::mapgen_context(game *g, overmap *om, const int x, const int y, const int z,
+                               const int turn) :
+ g(g), mtypes(&g->mtypes), om_pos(om->pos()), x(x), y(y), z(z), turn(turn)
 {
- dbg(D_INFO) << "map::generate( g["<<g<<"], om["<<(void*)om<<"], x["<<x<<"], "
-            << "y["<<y<<"], turn["<<turn<<"] )";
-
-// First we have to create new submaps and initialize them to 0 all over
-// We create all the submaps, even if we're not a tinymap, so that map
-//  generation which overflows won't cause a crash.  At the bottom of this
-//  function, we save the upper-left 4 submaps, and delete the rest.
- for (int i = 0; i < my_MAPSIZE * my_MAPSIZE; i++) {
-  grid[i] = new submap;
-  grid[i]->active_item_count = 0;
-  grid[i]->field_count = 0;
-  grid[i]->turn_last_touched = turn;
-  grid[i]->comp = computer();
-  grid[i]->camp = basecamp();
-  for (int x = 0; x < SEEX; x++) {
-   for (int y = 0; y < SEEY; y++) {
-    grid[i]->ter[x][y] = t_null;
-    grid[i]->trp[x][y] = tr_null;
-    grid[i]->fld[x][y] = field();
-    grid[i]->rad[x][y] = 0;
-    grid[i]->graf[x][y] = graffiti();
-   }
-  }
- }
-
- oter_id terrain_type, t_north, t_east, t_south, t_west, t_above;
- unsigned zones = 0;
+ zones = 0;
  int overx = x / 2;
  int overy = y / 2;
  if ( x >= OMAPX * 2 || x < 0 || y >= OMAPY * 2 || y < 0) {
-  dbg(D_INFO) << "map::generate: In section 1";
+  dbg(D_INFO) << "mapgen_context: In section 1";
 
 // This happens when we're at the very edge of the overmap, and are generating
 // terrain for the adjacent overmap.
@@ -156,7 +132,7 @@ void map::generate(game *g, overmap *om, const int x, const int y, const int z,
   else
    t_west = om->ter(OMAPX - 1, overy, z);
  } else {
-  dbg(D_INFO) << "map::generate: In section 2";
+  dbg(D_INFO) << "mapgen_context: In section 2";
 
   t_above = om->ter(overx, overy, z + 1);
   terrain_type = om->ter(overx, overy, z);
@@ -189,20 +165,66 @@ void map::generate(game *g, overmap *om, const int x, const int y, const int z,
  // This attempts to scale density of zombies inversely with distance from the nearest city.
  // In other words, make city centers dense and perimiters sparse.
  city *closest_city = &om->cities[om->closest_city(point(overx, overy))];
- float density = 0.0;
+ density = 0.0;
  if (closest_city) {
   float size = (float)closest_city->s;
   float dist = (float)rl_dist(overx, overy, closest_city->x, closest_city->y);
   density = log(1 + (size - dist) / size);
  }
- draw_map(terrain_type, t_north, t_east, t_south, t_west, t_above, turn, g, density);
+}
 
- if ( one_in( oterlist[terrain_type].embellishments.chance ))
-  add_extra( random_map_extra( oterlist[terrain_type].embellishments ), g);
+void map::generate(game *g, overmap *om, const int x, const int y, const int z, const int turn)
+{
+ dbg(D_INFO) << "map::generate( g["<<g<<"], om["<<(void*)om<<"], x["<<x<<"], "
+            << "y["<<y<<"], turn["<<turn<<"] )";
 
- post_process(g, zones);
+ mapgen_context ctx(g, om, x, y, z, turn);
+ generate(ctx);
+ finish_generate(g, om, ctx);
+}
+
+void map::generate(const mapgen_context &ctx)
+{
+// Every random roll below comes from a stream keyed on where we are
+ rng_stream mapgen_rng;
+ mapgen_rng.seed(rng_world_seed(), ctx.om_pos.x, ctx.om_pos.y, ctx.x, ctx.y, ctx.z);
+ rng_stream_scope mapgen_scope(mapgen_rng);
+
+ pending_artifacts.clear();
+
+// First we have to create new submaps and initialize them to 0 all over
+// We create all the submaps, even if we're not a tinymap, so that map
+//  generation which overflows won't cause a crash.  At the bottom of this
+//  function, we save the upper-left 4 submaps, and delete the rest.
+ for (int i = 0; i < my_MAPSIZE * my_MAPSIZE; i++) {
+  grid[i] = new submap;
+  grid[i]->turn_last_touched = ctx.turn;
+  for (int x = 0; x < SEEX; x++) {
+   for (int y = 0; y < SEEY; y++) {
+    grid[i]->ter[x][y] = t_null;
+    grid[i]->trp[x][y] = tr_null;
+   }
+  }
+ }
+
+
+ draw_map(ctx, ctx.terrain_type);
+
+ if ( one_in( oterlist[ctx.terrain_type].embellishments.chance ))
+  add_extra( random_map_extra( oterlist[ctx.terrain_type].embellishments ), ctx);
+
+ post_process(ctx);
+}
+
+void map::finish_generate(game *g, overmap *om, const mapgen_context &ctx)
+{
+ for (int i = 0; i < pending_artifacts.size(); i++) {
+  const mapgen_artifact &art = pending_artifacts[i];
+  add_item(art.x, art.y, art.natural ? g->new_natural_artifact(art.prop) :
+                                       g->new_artifact(), 0);
+ }
+ pending_artifacts.clear();
 
-// Okay, we know who are neighbors are.  Let's draw!
 // And finally save used submaps and delete the rest.
  for (int i = 0; i < my_MAPSIZE; i++) {
   for (int j = 0; j < my_MAPSIZE; j++) {
@@ -211,17 +233,20 @@ void map::generate(game *g, overmap *om, const int x, const int y, const int z,
    dbg(D_INFO) << grid[i+j];
 
    if (i <= 1 && j <= 1)
-    saven(om, turn, x, y, z, i, j);
+    saven(om, ctx.turn, ctx.x, ctx.y, ctx.z, i, j);
    else
     delete grid[i + j * my_MAPSIZE];
   }
  }
 }
 
-void map::draw_map(const oter_id terrain_type, const oter_id t_north, const oter_id t_east,
-                   const oter_id t_south, const oter_id t_west, const oter_id t_above,
-                   const int turn, game *g, const float density)
+void map::draw_map(const mapgen_context &ctx, const oter_id terrain_type)
 {
+ const oter_id t_north = ctx.t_north, t_east = ctx.t_east, t_south = ctx.t_south,
+               t_west = ctx.t_west, t_above = ctx.t_above;
+ const int turn = ctx.turn;
+ const float density = ctx.density;
+
 // Big old switch statement with a case for each overmap terrain type.
 // Many of these can be copied from another type, then rotated; for instance,
 //  ot_house_east is identical to ot_house_north, just rotated 90 degrees to
@@ -308,7 +333,7 @@ void map::draw_map(const oter_id terrain_type, const oter_id t_north, const oter
   }
     if (one_in(4))
   {
-      add_vehicle (g, veh_truck, 12, 12, 90);
+      add_vehicle (ctx.g, veh_truck, 12, 12, 90);
 	  }
   break;
  case ot_forest:
@@ -733,7 +758,7 @@ void map::draw_map(const oter_id terrain_type, const oter_id t_north, const oter
   if (terrain_type == ot_road_ew)
    rotate(1);
   if(rn == 1)
-   place_spawns(g, "GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
+   place_spawns("GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
   place_items(mi_road, 5, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, false, turn);
   break;
 
@@ -771,7 +796,7 @@ void map::draw_map(const oter_id terrain_type, const oter_id t_north, const oter
   if (terrain_type == ot_road_wn)
    rotate(3);
   if(rn == 1)
-   place_spawns(g, "GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
+   place_spawns("GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
   place_items(mi_road, 5, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, false, turn);
   break;
 
@@ -809,7 +834,7 @@ void map::draw_map(const oter_id terrain_type, const oter_id t_north, const oter
   if (terrain_type == ot_road_new)
    rotate(3);
   if(rn == 1)
-   place_spawns(g, "GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
+   place_spawns("GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
   place_items(mi_road, 5, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, false, turn);
   break;
 
@@ -871,7 +896,7 @@ void map::draw_map(const oter_id terrain_type, const oter_id t_north, const oter
   } else
    place_items(mi_road,  5, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, false, turn);
   if(rn == 1)
-   place_spawns(g, "GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
+   place_spawns("GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
   if (terrain_type == ot_road_nesw_manhole)
    ter(rng(6, SEEX * 2 - 6), rng(6, SEEX * 2 - 6)) = t_manhole_cover;
   break;
@@ -1280,7 +1305,7 @@ void map::draw_map(const oter_id terrain_type, const oter_id t_north, const oter
    }
    place_items(mi_rare, 60, 0, 0, SEEX * 2 - 1, SEEY * 2 - 1, false, turn);
   } else { // Just boring old zombies
-   place_spawns(g, "GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
+   place_spawns("GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
   }
 
   if (terrain_type == ot_house_east  || terrain_type == ot_house_base_east)
@@ -1349,7 +1374,7 @@ void map::draw_map(const oter_id terrain_type, const oter_id t_north, const oter
 					vt = veh_motorcycle;
 			}
 
-      add_vehicle (g, vt, vx, vy, one_in(2)? 90 : 270);
+      add_vehicle (ctx.g, vt, vx, vy, one_in(2)? 90 : 270);
   }
   place_items(mi_road, 8, 0, 0, SEEX * 2 - 1, SEEY * 2 - 1, false, turn);
   if (t_east  >= ot_road_null && t_east  <= ot_road_nesw_manhole)
@@ -1490,7 +1515,7 @@ void map::draw_map(const oter_id terrain_type, const oter_id t_north, const oter
    rotate(2);
   if (terrain_type == ot_s_gas_west)
    rotate(3);
-  place_spawns(g, "GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
+  place_spawns("GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
   break;
 
  case ot_s_pharm_north:
@@ -1563,7 +1588,7 @@ void map::draw_map(const oter_id terrain_type, const oter_id t_north, const oter
    rotate(2);
   if (terrain_type == ot_s_pharm_west)
    rotate(3);
-  place_spawns(g, "GROUP_PHARM", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
+  place_spawns("GROUP_PHARM", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
   break;
 
  case ot_s_grocery_north:
@@ -1630,7 +1655,7 @@ void map::draw_map(const oter_id terrain_type, const oter_id t_north, const oter
    rotate(2);
   if (terrain_type == ot_s_grocery_west)
    rotate(3);
-  place_spawns(g, "GROUP_GROCERY", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
+  place_spawns("GROUP_GROCERY", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
   break;
 
  case ot_s_hardware_north:
@@ -1754,7 +1779,7 @@ void map::draw_map(const oter_id terrain_type, const oter_id t_north, const oter
    rotate(2);
   if (terrain_type == ot_s_hardware_west)
    rotate(3);
-  place_spawns(g, "GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
+  place_spawns("GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
   break;
 
  case ot_s_electronics_north:
@@ -1800,7 +1825,7 @@ void map::draw_map(const oter_id terrain_type, const oter_id t_north, const oter
    rotate(2);
   if (terrain_type == ot_s_electronics_west)
    rotate(3);
-  place_spawns(g, "GROUP_ELECTRO", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
+  place_spawns("GROUP_ELECTRO", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
   break;
 
  case ot_s_sports_north:
@@ -1870,7 +1895,7 @@ void map::draw_map(const oter_id terrain_type, const oter_id t_north, const oter
    rotate(2);
   if (terrain_type == ot_s_sports_west)
    rotate(3);
-  place_spawns(g, "GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
+  place_spawns("GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
   break;
 
  case ot_s_liquor_north:
@@ -1931,7 +1956,7 @@ void map::draw_map(const oter_id terrain_type, const oter_id t_north, const oter
    rotate(2);
   if (terrain_type == ot_s_liquor_west)
    rotate(3);
-  place_spawns(g, "GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
+  place_spawns("GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
   break;
 
  case ot_s_gun_north:
@@ -1985,7 +2010,7 @@ void map::draw_map(const oter_id terrain_type, const oter_id t_north, const oter
    rotate(2);
   if (terrain_type == ot_s_gun_west)
    rotate(3);
-  place_spawns(g, "GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
+  place_spawns("GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
   break;
 
  case ot_s_clothes_north:
@@ -2070,7 +2095,7 @@ void map::draw_map(const oter_id terrain_type, const oter_id t_north, const oter
    rotate(2);
   if (terrain_type == ot_s_clothes_west)
    rotate(3);
-  place_spawns(g, "GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
+  place_spawns("GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
   break;
 
  case ot_s_library_north:
@@ -2130,7 +2155,7 @@ void map::draw_map(const oter_id terrain_type, const oter_id t_north, const oter
    rotate(2);
   if (terrain_type == ot_s_library_west)
    rotate(3);
-  place_spawns(g, "GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
+  place_spawns("GROUP_ZOMBIE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
   break;
 
  case ot_s_restaurant_north:
@@ -2257,7 +2282,7 @@ void map::draw_map(const oter_id terrain_type, const oter_id t_north, const oter
   if (terrain_type == ot_s_restaurant_west)
    rotate(3);
   }
-  place_spawns(g, "GROUP_GROCERY", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
+  place_spawns("GROUP_GROCERY", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
   break;
 
 //....
@@ -3074,7 +3099,7 @@ case ot_lmoe: {
      add_spawn(mon_zombie_soldier, 1, rnx, rny);
     else if (one_in(2)) {
      item body;
-     body.make_corpse(g->itypes[itm_corpse], g->mtypes[mon_null], 0);
+     body.make_corpse((*itypes)[itm_corpse], (*ctx.mtypes)[mon_null], 0);
      add_item(rnx, rny, body);
      place_items(mi_launchers,  10, rnx, rny, rnx, rny, true, 0);
      place_items(mi_mil_rifles, 30, rnx, rny, rnx, rny, true, 0);
@@ -3191,15 +3216,15 @@ case ot_lmoe: {
 // Start with all rock floor
    square(this, t_rock_floor, 0, 0, SEEX * 2 - 1, SEEY * 2 - 1);
 // We always start at the south and go north.
-// We use (g->levx / 2 + g->levz) % 5 to guarantee that rooms don't repeat.
-   switch (1 + int(g->levy / 2 + g->levz) % 4) {// TODO: More varieties!
+// We use (y / 2 + z) % 4 to guarantee that rooms don't repeat.
+   switch (1 + int(ctx.y / 2 + ctx.z) % 4) {// TODO: More varieties!
 
     case 1: // Flame bursts
      square(this, t_rock, 0, 0, SEEX - 1, SEEY * 2 - 1);
      square(this, t_rock, SEEX + 2, 0, SEEX * 2 - 1, SEEY * 2 - 1);
      for (int i = 2; i < SEEY * 2 - 4; i++) {
-      add_field(g, SEEX    , i, fd_fire_vent, rng(1, 3));
-      add_field(g, SEEX + 1, i, fd_fire_vent, rng(1, 3));
+      add_field(NULL, SEEX    , i, fd_fire_vent, rng(1, 3));
+      add_field(NULL, SEEX + 1, i, fd_fire_vent, rng(1, 3));
      }
      break;
 
@@ -3383,8 +3408,8 @@ case ot_lmoe: {
   square(this, t_rock_floor, SEEX - 1, 1, SEEX + 2, 4);
   square(this, t_rock_floor, SEEX, 5, SEEX + 1, SEEY * 2 - 1);
   line(this, t_stairs_up, SEEX, SEEY * 2 - 1, SEEX + 1, SEEY * 2 - 1);
-  add_item(rng(SEEX, SEEX + 1), rng(2, 3), g->new_artifact(), 0);
-  add_item(rng(SEEX, SEEX + 1), rng(2, 3), g->new_artifact(), 0);
+  add_artifact(rng(SEEX, SEEX + 1), rng(2, 3));
+  add_artifact(rng(SEEX, SEEX + 1), rng(2, 3));
   return;
 
  case ot_sewage_treatment:
@@ -3751,7 +3776,7 @@ case ot_lmoe: {
     case 1: { // Toxic gas
      int cx = rng(9, 14), cy = rng(9, 14);
      ter(cx, cy) = t_rock;
-     add_field(g, cx, cy, fd_gas_vent, 1);
+     add_field(NULL, cx, cy, fd_gas_vent, 1);
     } break;
 
     case 2: { // Lava
@@ -3791,7 +3816,7 @@ case ot_lmoe: {
       } while (body.x == -1 && tries < 10);
       if (tries < 10) {
        item miner;
-       miner.make_corpse(g->itypes[itm_corpse], g->mtypes[mon_null], 0);
+       miner.make_corpse((*itypes)[itm_corpse], (*ctx.mtypes)[mon_null], 0);
        add_item(body.x, body.y, miner);
        place_items(mi_mine_equipment, 60, body.x, body.y, body.x, body.y,
                    false, 0);
@@ -3838,7 +3863,7 @@ case ot_lmoe: {
      line(this, t_rock, orx + 1, ory + 2, orx + 3, ory + 2);
      ter(orx + 3, ory + 3) = t_rock;
      item miner;
-     miner.make_corpse(g->itypes[itm_corpse], g->mtypes[mon_null], 0);
+     miner.make_corpse((*itypes)[itm_corpse], (*ctx.mtypes)[mon_null], 0);
      add_item(orx + 2, ory + 3, miner);
      place_items(mi_mine_equipment, 60, orx + 2, ory + 3, orx + 2, ory + 3,
                  false, 0);
@@ -4001,7 +4026,7 @@ case ot_lmoe: {
 
    case 2: { // The Thing dog
     item miner;
-    miner.make_corpse(g->itypes[itm_corpse], g->mtypes[mon_null], 0);
+    miner.make_corpse((*itypes)[itm_corpse], (*ctx.mtypes)[mon_null], 0);
     int num_bodies = rng(4, 8);
     for (int i = 0; i < num_bodies; i++) {
      int x = rng(4, SEEX * 2 - 5), y = rng(4, SEEX * 2 - 5);
@@ -4009,7 +4034,7 @@ case ot_lmoe: {
      place_items(mi_mine_equipment, 60, x, y, x, y, false, 0);
     }
     add_spawn(mon_dog_thing, 1, rng(SEEX, SEEX + 1), rng(SEEX, SEEX + 1), true);
-    add_item(rng(SEEX, SEEX + 1), rng(SEEY, SEEY + 1), g->new_artifact(), 0);
+    add_artifact(rng(SEEX, SEEX + 1), rng(SEEY, SEEY + 1));
    } break;
 
    case 3: { // Spiral down
@@ -4169,7 +4194,7 @@ case ot_lmoe: {
   line(this, t_counter, buildx - 3, buildy - 3, buildx + 3, buildy - 3);
   place_items(mi_toxic_dump_equipment, 80,
               buildx - 3, buildy - 3, buildx + 3, buildy - 3, false, 0);
-  add_item(buildx, buildy, g->itypes[itm_id_military], 0);
+  add_item(buildx, buildy, (*itypes)[itm_id_military], 0);
   ter(buildx, buildy + 4) = t_door_locked;
 
   rotate(rng(0, 3));
@@ -4207,9 +4232,9 @@ case ot_lmoe: {
         hermx = rng(SEEX - 6, SEEX + 5), hermy = rng(SEEX - 6, SEEY + 5);
     std::vector<point> bloodline = line_to(origx, origy, hermx, hermy, 0);
     for (int ii = 0; ii < bloodline.size(); ii++)
-     add_field(g, bloodline[ii].x, bloodline[ii].y, fd_blood, 2);
+     add_field(NULL, bloodline[ii].x, bloodline[ii].y, fd_blood, 2);
     item body;
-    body.make_corpse(g->itypes[itm_corpse], g->mtypes[mon_null], g->turn);
+    body.make_corpse((*itypes)[itm_corpse], (*ctx.mtypes)[mon_null], turn);
     add_item(hermx, hermy, body);
     place_items(mi_rare, 25, hermx - 1, hermy - 1, hermx + 1, hermy + 1,true,0);
    } break;
@@ -4217,7 +4242,7 @@ case ot_lmoe: {
 
   } else { // We're above ground!
 // First, draw a forest
-    draw_map(ot_forest, t_north, t_east, t_south, t_west, t_above, turn, g, density);
+    draw_map(ctx, ot_forest);
 // Clear the center with some rocks
    square(this, t_rock, SEEX - 6, SEEY - 6, SEEX + 5, SEEY + 5);
    int pathx, pathy;
@@ -4264,7 +4289,7 @@ case ot_lmoe: {
      for (int cy = cavey - 1; cy <= cavey + 1; cy++) {
       ter(cx, cy) = t_rock_floor;
       if (one_in(10))
-       add_field(g, cx, cy, fd_blood, rng(1, 3));
+       add_field(NULL, cx, cy, fd_blood, rng(1, 3));
       if (one_in(20))
        add_spawn(mon_sewer_rat, 1, cx, cy);
      }
@@ -4281,7 +4306,7 @@ case ot_lmoe: {
       for (int cy = path[i].y - 1; cy <= path[i].y + 1; cy++) {
        ter(cx, cy) = t_rock_floor;
        if (one_in(10))
-        add_field(g, cx, cy, fd_blood, rng(1, 3));
+        add_field(NULL, cx, cy, fd_blood, rng(1, 3));
        if (one_in(20))
         add_spawn(mon_sewer_rat, 1, cx, cy);
       }
@@ -4396,7 +4421,7 @@ case ot_s_garage_north:
             vt = one_in(2) ? veh_sandbike : veh_sandbike_chassis;
           else
             vt = one_in(2) ? veh_motorcycle : veh_motorcycle_chassis;
-          add_vehicle (g, vt, vx, vy, theta);
+          add_vehicle (ctx.g, vt, vx, vy, theta);
         }
   }
   break;
@@ -4790,7 +4815,7 @@ break;
   if (terrain_type == ot_police_east)
    rotate(3);
 
-  place_spawns(g, "GROUP_POLICE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
+  place_spawns("GROUP_POLICE", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, density);
  } break;
 
  case ot_bank_north:
@@ -5331,7 +5356,7 @@ break;
   rn = rng(10, 15);
   for (int i = 0; i < rn; i++) {
    item body;
-   body.make_corpse(g->itypes[itm_corpse], g->mtypes[mon_null], g->turn);
+   body.make_corpse((*itypes)[itm_corpse], (*ctx.mtypes)[mon_null], turn);
    int zx = rng(0, SEEX * 2 - 1), zy = rng(0, SEEY * 2 - 1);
    if (ter(zx, zy) == t_bed || one_in(3))
     add_item(zx, zy, body);
@@ -5659,7 +5684,7 @@ break;
   rn = rng(15, 20);
   for (int i = 0; i < rn; i++) {
    item body;
-   body.make_corpse(g->itypes[itm_corpse], g->mtypes[mon_null], g->turn);
+   body.make_corpse((*itypes)[itm_corpse], (*ctx.mtypes)[mon_null], turn);
    int zx = rng(0, SEEX * 2 - 1), zy = rng(0, SEEY * 2 - 1);
    if (ter(zx, zy) == t_bed || one_in(3))
     add_item(zx, zy, body);
@@ -6404,7 +6429,7 @@ break;
     else {
      for (int webx = nodex; webx <= nodex + 3; webx++) {
       for (int weby = nodey; weby <= nodey + 3; weby++)
-       add_field(g, webx, weby, fd_web, rng(1, 3));
+       add_field(NULL, webx, weby, fd_web, rng(1, 3));
      }
      add_spawn(mon_spider_web, 1, spawnx, spawny);
     }
@@ -7261,10 +7286,10 @@ break;
 
 }
 
-void map::post_process(game *g, unsigned zones)
+void map::post_process(const mapgen_context &ctx)
 {
  std::string junk;
- if (zones & mfb(OMZONE_CITY)) {
+ if (ctx.zones & mfb(OMZONE_CITY)) {
   if (!one_in(10)) { // 90% chance of smashing stuff up
    for (int x = 0; x < 24; x++) {
     for (int y = 0; y < 24; y++)
@@ -7276,19 +7301,19 @@ void map::post_process(game *g, unsigned zones)
    for (int i = 0; i < num_corpses; i++) {
     int x = rng(0, 23), y = rng(0, 23);
     if (move_cost(x, y) > 0)
-     add_corpse(g, this, x, y);
+     add_corpse(ctx, this, x, y);
    }
   }
  } // OMZONE_CITY
 
- if (zones & mfb(OMZONE_BOMBED)) {
+ if (ctx.zones & mfb(OMZONE_BOMBED)) {
   while (one_in(4)) {
    point center( rng(4, 19), rng(4, 19) );
    int radius = rng(1, 4);
    for (int x = center.x - radius; x <= center.x + radius; x++) {
     for (int y = center.y - radius; y <= center.y + radius; y++) {
      if (rl_dist(x, y, center.x, center.y) <= rng(1, radius))
-      destroy(g, x, y, false);
+      destroy(NULL, x, y, false);
     }
    }
   }
@@ -7296,7 +7321,7 @@ void map::post_process(game *g, unsigned zones)
 
 }
 
-void map::place_spawns(game *g, std::string group, const int chance,
+void map::place_spawns(std::string group, const int chance,
                        const int x1, const int y1, const int x2, const int y2, const float density)
 {
  if (!OPTIONS[OPT_STATIC_SPAWN])
@@ -7320,7 +7345,7 @@ void map::place_spawns(game *g, std::string group, const int chance,
    } while( move_cost(x, y) == 0 && tries );
 
    // Pick a monster type
-   mon_id monster = MonsterGroupManager::GetMonsterFromGroup(group, &g->mtypes);
+   mon_id monster = MonsterGroupManager::GetMonsterFromGroup(group);
 
    add_spawn(monster, 1, x, y);
   }
@@ -7331,32 +7356,20 @@ void map::place_spawns(game *g, std::string group, const int chance,
 void map::place_items(items_location loc, int chance, int x1, int y1,
                       int x2, int y2, bool ongrass, int turn)
 {
- std::vector<itype_id> eligible = (*mapitems)[loc];
+ const mapitem_table &eligible = mapitem_tables[loc];
 
  if (chance >= 100 || chance <= 0) {
   debugmsg("map::place_items() called with an invalid chance (%d)", chance);
   return;
  }
- if (eligible.size() == 0) { // No items here! (Why was it called?)
+ if (eligible.items.size() == 0) { // No items here! (Why was it called?)
   debugmsg("map::place_items() called for an empty items list (list #%d)", loc);
   return;
  }
 
- int item_chance = 0;	// # of items
- for (int i = 0; i < eligible.size(); i++)
-  item_chance += (*itypes)[eligible[i]]->rarity;
- int selection, randnum;
  int px, py;
  while (rng(0, 99) < chance) {
-  randnum = rng(1, item_chance);
-  selection = -1;
-  while (randnum > 0) {
-   selection++;
-   if (selection >= eligible.size())
-    debugmsg("OOB selection (%d of %d); randnum is %d, item_chance %d",
-             selection, eligible.size(), randnum, item_chance);
-   randnum -= (*itypes)[eligible[selection]]->rarity;
-  }
+  itype_id selected = eligible.pick();
   int tries = 0;
   do {
    px = rng(x1, x2);
@@ -7368,12 +7381,12 @@ void map::place_items(items_location loc, int chance, int x1, int y1,
             (!ongrass && (ter(px, py) == t_dirt || ter(px, py) == t_grass))) &&
            tries < 20);
   if (tries < 20) {
-   add_item(px, py, (*itypes)[eligible[selection]], turn);
+   add_item(px, py, (*itypes)[selected], turn);
 // Guns in the home and behind counters are generated with their ammo
 // TODO: Make this less of a hack
-   if ((*itypes)[eligible[selection]]->is_gun() &&
+   if ((*itypes)[selected]->is_gun() &&
        (loc == mi_homeguns || loc == mi_behindcounter)) {
-    it_gun* tmpgun = dynamic_cast<it_gun*> ((*itypes)[eligible[selection]]);
+    it_gun* tmpgun = dynamic_cast<it_gun*> ((*itypes)[selected]);
     add_item(px, py, (*itypes)[default_ammo(tmpgun->ammo)], turn);
    }
   }
@@ -7382,24 +7395,9 @@ void map::place_items(items_location loc, int chance, int x1, int y1,
 
 void map::put_items_from(items_location loc, int num, int x, int y, int turn)
 {
- std::vector<itype_id> eligible = (*mapitems)[loc];
- int item_chance = 0;	// # of items
- for (int i = 0; i < eligible.size(); i++)
-  item_chance += (*itypes)[eligible[i]]->rarity;
-
- for (int i = 0; i < num; i++) {
-  int selection, randnum;
-  randnum = rng(1, item_chance);
-  selection = -1;
-  while (randnum > 0) {
-   selection++;
-   if (selection >= eligible.size())
-    debugmsg("OOB selection (%d of %d); randnum is %d, item_chance %d",
-             selection, eligible.size(), randnum, item_chance);
-   randnum -= (*itypes)[eligible[selection]]->rarity;
-  }
-  add_item(x, y, (*itypes)[eligible[selection]], turn);
- }
+ const mapitem_table &eligible = mapitem_tables[loc];
+ for (int i = 0; i < num; i++)
+  add_item(x, y, (*itypes)[eligible.pick()], turn);
 }
 
 void map::add_spawn(mon_id type, int count, int x, int y, bool friendly,
@@ -7422,6 +7420,13 @@ void map::add_spawn(mon_id type, int count, int x, int y, bool friendly,
 }
 
 void map::add_spawn(monster *mon)
+{
+ spawn_point sp = spawn_point_of(mon);
+ add_spawn(sp.type, sp.count, sp.posx, sp.posy, sp.friendly, sp.faction_id,
+           sp.mission_id, sp.name);
+}
+
+spawn_point map::spawn_point_of(monster *mon)
 {
  int spawnx, spawny;
  std::string spawnname = (mon->unique_name == "" ? "NONE" : mon->unique_name);
@@ -7438,8 +7443,9 @@ void map::add_spawn(monster *mon)
   spawny += SEEY;
  spawnx %= SEEX;
  spawny %= SEEY;
- add_spawn(mon_id(mon->type->id), 1, spawnx, spawny, (mon->friendly < 0),
-           mon->faction_id, mon->mission_id, spawnname);
+ return spawn_point(mon_id(mon->type->id), 1, spawnx, spawny,
+                    mon->faction_id, mon->mission_id, (mon->friendly < 0),
+                    spawnname);
 }
 
 vehicle *map::add_vehicle(game *g, vhtype_id type, int x, int y, int dir)
@@ -7478,8 +7484,9 @@ computer* map::add_computer(int x, int y, std::string name, int security)
 {
  ter(x, y) = t_console; // TODO: Turn this off?
  int nonant = int(x / SEEX) + int(y / SEEY) * my_MAPSIZE;
- grid[nonant]->comp = computer(name, security);
- return &(grid[nonant]->comp);
+ delete grid[nonant]->comp;
+ grid[nonant]->comp = new computer(name, security);
+ return grid[nonant]->comp;
 }
 
 void map::rotate(int turns)
@@ -7488,7 +7495,7 @@ void map::rotate(int turns)
  trap_id traprot        [SEEX*2][SEEY*2];
  std::vector<item> itrot[SEEX*2][SEEY*2];
  std::vector<spawn_point> sprot[MAPSIZE * MAPSIZE];
- computer tmpcomp;
+ computer *tmpcomp;
  std::vector<vehicle*> tmpveh;
 
  switch (turns) {
@@ -8837,10 +8844,10 @@ void mansion_room(map *m, int x1, int y1, int x2, int y2)
  build_mansion_room(m, type, x1, y1, x2, y2);
 }
 
-void map::add_extra(map_extra type, game *g)
+void map::add_extra(map_extra type, const mapgen_context &ctx)
 {
  item body;
- body.make_corpse(g->itypes[itm_corpse], g->mtypes[mon_null], g->turn);
+ body.make_corpse((*itypes)[itm_corpse], (*ctx.mtypes)[mon_null], ctx.turn);
 
  switch (type) {
 
@@ -8875,7 +8882,7 @@ void map::add_extra(map_extra type, game *g)
    case 3: extra_items = mi_allguns;	break;
    case 4: extra_items = mi_bionics;	break;
   }
-  place_spawns(g, "GROUP_MAYBE_MIL", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, 0.1);//0.1 = 1-5
+  place_spawns("GROUP_MAYBE_MIL", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, 0.1);//0.1 = 1-5
   place_items(extra_items, 70, cx - 4, cy - 4, cx + 4, cy + 4, true, 0);
  }
  break;
@@ -8898,7 +8905,7 @@ void map::add_extra(map_extra type, game *g)
      add_item(x, y, (*itypes)[itm_id_military], 0);
    }
   }
-  place_spawns(g, "GROUP_MAYBE_MIL", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, 0.1);//0.1 = 1-5
+  place_spawns("GROUP_MAYBE_MIL", 2, 0, 0, SEEX * 2 - 1, SEEX * 2 - 1, 0.1);//0.1 = 1-5
   place_items(mi_rare, 25, 0, 0, SEEX * 2 - 1, SEEY * 2 - 1, true, 0);
  }
  break;
@@ -9026,7 +9033,7 @@ void map::add_extra(map_extra type, game *g)
     add_item(x, y, body);
     int splatter_range = rng(1, 3);
     for (int j = 0; j <= splatter_range; j++) {
-     add_field(g, x + (j * x_offset), y + (j * y_offset), fd_blood, 1);
+     add_field(NULL, x + (j * x_offset), y + (j * y_offset), fd_blood, 1);
     }
     place_items(mi_drugdealer, 75, x, y, x, y, true, 0);
     if (a_has_drugs && num_drugs > 0) {
@@ -9060,7 +9067,7 @@ void map::add_extra(map_extra type, game *g)
     add_item(x, y, body);
     int splatter_range = rng(1, 3);
     for (int j = 0; j <= splatter_range; j++) {
-     add_field(g, x + (j * x_offset), y + (j * y_offset), fd_blood, 1);
+     add_field(NULL, x + (j * x_offset), y + (j * y_offset), fd_blood, 1);
     }
     place_items(mi_drugdealer, 75, x, y, x, y, true, 0);
     if (!a_has_drugs && num_drugs > 0) {
@@ -9179,18 +9186,15 @@ void map::add_extra(map_extra type, game *g)
  case mx_portal_in:
  {
   int x = rng(5, SEEX * 2 - 6), y = rng(5, SEEY * 2 - 6);
-  add_field(g, x, y, fd_fatigue, 3);
+  add_field(NULL, x, y, fd_fatigue, 3);
   for (int i = x - 5; i <= x + 5; i++) {
    for (int j = y - 5; j <= y + 5; j++) {
     if (rng(0, 9) > trig_dist(x, y, i, j)) {
      marlossify(i, j);
      if (ter(i, j) == t_marloss)
-      add_item(x, y, (*itypes)[itm_marloss_berry], g->turn);
-     if (one_in(15)) {
-      monster creature(g->mtypes[mon_id(rng(mon_gelatin, mon_blank))]);
-      creature.spawn(i, j);
-      g->z.push_back(creature);
-     }
+      add_item(x, y, (*itypes)[itm_marloss_berry], ctx.turn);
+     if (one_in(15))
+      add_spawn(mon_id(rng(mon_gelatin, mon_blank)), 1, i, j);
     }
    }
   }
@@ -9202,12 +9206,22 @@ void map::add_extra(map_extra type, game *g)
   artifact_natural_property prop =
    artifact_natural_property(rng(ARTPROP_NULL + 1, ARTPROP_MAX - 1));
   create_anomaly(center.x, center.y, prop);
-  add_item(center.x, center.y, g->new_natural_artifact(prop), 0);
+  add_artifact(center.x, center.y, true, prop);
  } break;
 
  } // switch (prop)
 }
 
+void map::add_artifact(int x, int y, bool natural, artifact_natural_property prop)
+{
+ mapgen_artifact art;
+ art.x = x;
+ art.y = y;
+ art.natural = natural;
+ art.prop = prop;
+ pending_artifacts.push_back(art);
+}
+
 void map::create_anomaly(int cx, int cy, artifact_natural_property prop)
 {
  rough_circle(this, t_rubble, cx, cy, 5);
@@ -9350,10 +9364,10 @@ void rough_circle(map *m, ter_id type, int x, int y, int rad)
  }
 }
 
-void add_corpse(game *g, map *m, int x, int y)
+void add_corpse(const mapgen_context &ctx, map *m, int x, int y)
 {
  item body;
- body.make_corpse(g->itypes[itm_corpse], g->mtypes[mon_null], 0);
+ body.make_corpse((*m->itypes)[itm_corpse], (*ctx.mtypes)[mon_null], 0);
  m->add_item(x, y, body);
  m->put_items_from(mi_shoes,  1, x, y);
  m->put_items_from(mi_pants,  1, x, y);
@@ -1,5 +1,9 @@
 #ifndef _MAPITEMS_H_
 #define _MAPITEMS_H_
+
+#include <vector>
+#include "itype.h"
+
 enum items_location {
  mi_none, mi_child_items,
  mi_field, mi_forest, mi_hive, mi_hive_center,
@@ -63,4 +67,24 @@ struct items_location_and_chance
   chance = c;
  };
 };
+
+// Running totals of item rarity for one items_location, built once by
+// game::init_mapitems().  pick() turns a roll of rng(1, total()) into an item
+// by binary search; it selects exactly what the old subtract-until-zero walk
+// over the list did for the same roll.
+struct mapitem_table
+{
+ std::vector<itype_id> items;
+ std::vector<int> cumulative; // Sum of rarity of items[0] through items[i]
+
+ void build(const std::vector<itype_id> &list,
+            const std::vector<itype*> &itypes);
+ int total() const { return cumulative.empty() ? 0 : cumulative.back(); }
+ bool empty() const { return total() <= 0; }
+ itype_id pick(int roll) const;
+ itype_id pick() const; // Rolls for itself
+};
+
+extern mapitem_table mapitem_tables[num_itloc];
+
 #endif
@@ -2,7 +2,38 @@
 #include "itype.h"
 #include "omdata.h"
 #include "setvector.h"
+#include "rng.h"
 #include <cstdarg>
+#include <algorithm>
+
+mapitem_table mapitem_tables[num_itloc];
+
+void mapitem_table::build(const std::vector<itype_id> &list,
+                          const std::vector<itype*> &itypes)
+{
+ items = list;
+ cumulative.clear();
+ cumulative.reserve(list.size());
+ int sum = 0;
+ for (int i = 0; i < list.size(); i++) {
+  sum += itypes[list[i]]->rarity;
+  cumulative.push_back(sum);
+ }
+}
+
+itype_id mapitem_table::pick(int roll) const
+{
+ int selection = std::lower_bound(cumulative.begin(), cumulative.end(), roll) -
+                 cumulative.begin();
+ if (selection >= items.size())
+  return itm_null;
+ return items[selection];
+}
+
+itype_id mapitem_table::pick() const
+{
+ return pick(rng(1, total()));
+}
 
 void game::init_mapitems()
 {
@@ -922,4 +953,7 @@ void game::init_mapitems()
 	itm_dynamite_act, itm_firecracker_pack_act, itm_firecracker_act, 
 	itm_mininuke_act, itm_UPS_on, itm_mp3_on, itm_c4armed, itm_apparatus, 
 	itm_brazier, itm_rag_bloody, NULL);
+
+ for (int i = 0; i < num_itloc; i++)
+  mapitem_tables[i].build(mapitems[i], itypes);
 }
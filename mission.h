@@ -130,6 +130,7 @@ struct mission {
  int npc_id;		// ID of a related npc
  int good_fac_id, bad_fac_id;	// IDs of the protagonist/antagonist factions
  int step;		// How much have we completed?
+ int monster;		// Handle in g->z of our monster, if seen in play; not saved
  mission_id follow_up;	// What mission do we get after this succeeds?
  text_hash text;
 
@@ -152,6 +153,7 @@ struct mission {
   good_fac_id = -1;
   bad_fac_id = -1;
   step = 0;
+  monster = -1;
  }
 };
 
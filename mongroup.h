@@ -4,15 +4,32 @@
 #include "mtype.h"
 #include <vector>
 #include <map>
+#include <string>
 
 typedef std::map<mon_id, int> FreqDef;
 typedef FreqDef::iterator FreqDef_iter;
 
+// One spawnable member of a group, with its monster's difficulty copied out of
+// the mtype so a spawn roll never has to look the type up.
+struct MonsterGroupEntry
+{
+    mon_id monster;
+    int frequency;
+    int difficulty;
+};
+
 struct MonsterGroup
 {
     std::string name;
     mon_id defaultMonster;
     FreqDef  monsters;
+
+    // Built by MonsterGroupManager::CompileGroups(), in FreqDef order
+    std::vector<MonsterGroupEntry> entries;         // Every member
+    std::vector<MonsterGroupEntry> classic_entries; // OPT_CLASSIC_ZOMBIES subset
+    std::vector<bool> members;                      // Indexed by mon_id
+
+    MonsterGroup() : defaultMonster(mon_null) {}
 };
 
 /*enum MonsterGroupType
@@ -39,37 +56,43 @@ struct MonsterGroup
 };*/
 
 struct mongroup {
- std::string type;
+ int type;       // Group id, see MonsterGroupManager::GroupId()
  int posx, posy, posz;
  unsigned char radius;
  unsigned int population;
  bool dying;
  bool diffuse;   // group size ind. of dist. from center and radius invariant
+ bool horde;     // Drifts towards noise, see overmap::move_hordes()
+ int targetx, targety; // Where a horde is drifting to; not saved
+ int interest;   // Moves left towards the target; not saved
  mongroup(std::string ptype, int pposx, int pposy, int pposz, unsigned char prad,
-          unsigned int ppop) {
-  type = ptype;
-  posx = pposx;
-  posy = pposy;
-  posz = pposz;
-  radius = prad;
-  population = ppop;
-  dying = false;
-  diffuse = false;
- }
- bool is_safe() { return (type == "GROUP_NULL" || type == "GROUP_FOREST"); };
+          unsigned int ppop);
+ mongroup(int ptype, int pposx, int pposy, int pposz, unsigned char prad,
+          unsigned int ppop);
+ bool is_safe();
 };
 
+// Groups are interned to small integer ids (GROUP_NULL is always 0) so that
+// spawn rolls and membership tests index flat tables instead of copying
+// groups out of a string-keyed map.
 class MonsterGroupManager
 {
     public:
         static void LoadJSONGroups();
-        static mon_id GetMonsterFromGroup(std::string, std::vector <mtype*> *, int turn = -1);
-        static bool IsMonsterInGroup(std::string, mon_id);
-        static std::string Monster2Group(mon_id);
+        static void CompileGroups(std::vector <mtype*> *mtypes);
+        static int GroupId(std::string group); // Interns; main thread only
+        static int FindGroupId(const std::string &group); // Unknown: GROUP_NULL
+        static const std::string& GroupName(int group);
+        static mon_id GetMonsterFromGroup(int group, int turn = -1);
+        static mon_id GetMonsterFromGroup(std::string group, int turn = -1);
+        static bool IsMonsterInGroup(int group, mon_id);
+        static int Monster2Group(mon_id); // 0 (GROUP_NULL) for none
         static std::vector<mon_id> GetMonstersFromGroup(std::string);
-        static MonsterGroup GetMonsterGroup(std::string group);
+        static const MonsterGroup& GetMonsterGroup(std::string group);
 
     private:
-        static std::map<std::string, MonsterGroup> monsterGroupMap;
+        static std::map<std::string, int> groupIds;
+        static std::vector<MonsterGroup> groups;   // Indexed by group id
+        static std::vector<int> monsterGroups;     // mon_id -> group id
 };
 #endif
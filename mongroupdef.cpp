@@ -18,76 +18,193 @@
 //     default monster will never get picked, and nor will the others past the
 //     monster that makes the point count go over 1000
 
-std::map<std::string, MonsterGroup> MonsterGroupManager::monsterGroupMap;
+std::map<std::string, int> MonsterGroupManager::groupIds;
+std::vector<MonsterGroup> MonsterGroupManager::groups;
+std::vector<int> MonsterGroupManager::monsterGroups;
 
-void game::init_mongroups() { MonsterGroupManager::LoadJSONGroups(); }
+// Set once the groups are loaded; every mongroup asks, so skip the lookup
+static int zombie_group = -1;
+// Every group the data defines is interned here, before any mapgen worker
+//  starts; the workers only read groupIds, through FindGroupId()
+void game::init_mongroups()
+{
+ MonsterGroupManager::LoadJSONGroups();
+ MonsterGroupManager::CompileGroups(&mtypes);
+ zombie_group = MonsterGroupManager::GroupId("GROUP_ZOMBIE");
+}
 
-mon_id MonsterGroupManager::GetMonsterFromGroup(std::string group, std::vector <mtype*> *mtypes, int turn)
+mongroup::mongroup(std::string ptype, int pposx, int pposy, int pposz,
+                   unsigned char prad, unsigned int ppop)
 {
-    int roll = rng(1, 1000);
-    MonsterGroup g = monsterGroupMap[group];
-    for (FreqDef_iter it = g.monsters.begin(); it != g.monsters.end(); ++it)
+ type = MonsterGroupManager::GroupId(ptype);
+ posx = pposx;
+ posy = pposy;
+ posz = pposz;
+ radius = prad;
+ population = ppop;
+ dying = false;
+ diffuse = false;
+ horde = (type == zombie_group);
+ targetx = posx;
+ targety = posy;
+ interest = 0;
+}
+
+mongroup::mongroup(int ptype, int pposx, int pposy, int pposz,
+                   unsigned char prad, unsigned int ppop)
+{
+ type = ptype;
+ posx = pposx;
+ posy = pposy;
+ posz = pposz;
+ radius = prad;
+ population = ppop;
+ dying = false;
+ diffuse = false;
+ horde = (type == zombie_group);
+ targetx = posx;
+ targety = posy;
+ interest = 0;
+}
+
+bool mongroup::is_safe()
+{
+ static const int forest = MonsterGroupManager::GroupId("GROUP_FOREST");
+ return (type == 0 || type == forest);
+}
+
+int MonsterGroupManager::GroupId(std::string group)
+{
+    if (groups.empty()) // GROUP_NULL always comes first
     {
-        if((turn == -1 || (turn + 900 >= MINUTES(STARTING_MINUTES) + (*mtypes)[it->first]->difficulty)) &&
-           (!OPTIONS[OPT_CLASSIC_ZOMBIES] ||
-            (*mtypes)[it->first]->in_category(MC_CLASSIC) ||
-            (*mtypes)[it->first]->in_category(MC_WILDLIFE)))
-        {   //Not too hard for us (or we dont care)
-            if(it->second >= roll) return it->first;
-            else roll -= it->second;
-        }
+        groups.push_back(MonsterGroup());
+        groups[0].name = "GROUP_NULL";
+        groupIds["GROUP_NULL"] = 0;
     }
-    return g.defaultMonster;
+    std::map<std::string, int>::iterator it = groupIds.find(group);
+    if (it != groupIds.end())
+        return it->second;
+    int id = groups.size();
+    groups.push_back(MonsterGroup());
+    groups[id].name = group;
+    groups[id].members.resize(num_monsters, false);
+    groupIds[group] = id;
+    return id;
 }
 
-bool MonsterGroupManager::IsMonsterInGroup(std::string group, mon_id monster)
+int MonsterGroupManager::FindGroupId(const std::string &group)
 {
-    MonsterGroup g = monsterGroupMap[group];
-    for (FreqDef_iter it = g.monsters.begin(); it != g.monsters.end(); ++it)
+    std::map<std::string, int>::const_iterator it = groupIds.find(group);
+    return (it == groupIds.end() ? 0 : it->second);
+}
+
+const std::string& MonsterGroupManager::GroupName(int group)
+{
+    if (group < 0 || group >= groups.size())
+        return groups[0].name;
+    return groups[group].name;
+}
+
+// Flattens every loaded group into entry lists and builds the reverse
+// mon_id -> group table.  Monster2Group() used to return the first group, by
+// name, listing the monster; groupIds is name-ordered so that is kept.
+void MonsterGroupManager::CompileGroups(std::vector <mtype*> *mtypes)
+{
+    GroupId("GROUP_NULL");
+    monsterGroups.assign(num_monsters, 0);
+    for (int id = 0; id < groups.size(); id++)
+    {
+        MonsterGroup &g = groups[id];
+        g.entries.clear();
+        g.classic_entries.clear();
+        g.members.assign(num_monsters, false);
+        for (FreqDef_iter it = g.monsters.begin(); it != g.monsters.end(); ++it)
+        {
+            mtype *type = (*mtypes)[it->first];
+            MonsterGroupEntry entry;
+            entry.monster = it->first;
+            entry.frequency = it->second;
+            entry.difficulty = type->difficulty;
+            g.entries.push_back(entry);
+            if (type->in_category(MC_CLASSIC) || type->in_category(MC_WILDLIFE))
+                g.classic_entries.push_back(entry);
+            g.members[it->first] = true;
+        }
+    }
+    for (std::map<std::string, int>::reverse_iterator it = groupIds.rbegin();
+         it != groupIds.rend(); ++it)
     {
-        if(it->first == monster) return true;
+        const MonsterGroup &g = groups[it->second];
+        for (int i = 0; i < g.entries.size(); i++)
+            monsterGroups[g.entries[i].monster] = it->second;
     }
-    return false;
 }
 
-std::string MonsterGroupManager::Monster2Group(mon_id monster)
+mon_id MonsterGroupManager::GetMonsterFromGroup(int group, int turn)
 {
-    for (std::map<std::string, MonsterGroup>::const_iterator it = monsterGroupMap.begin(); it != monsterGroupMap.end(); ++it)
+    int roll = rng(1, 1000);
+    if (group < 0 || group >= groups.size())
+        group = 0;
+    const MonsterGroup &g = groups[group];
+    const std::vector<MonsterGroupEntry> &entries =
+        (OPTIONS[OPT_CLASSIC_ZOMBIES] ? g.classic_entries : g.entries);
+    for (int i = 0; i < entries.size(); i++)
     {
-        if(IsMonsterInGroup(it->first, monster ))
-        {
-            return it->first;
+        if(turn == -1 || (turn + 900 >= MINUTES(STARTING_MINUTES) + entries[i].difficulty))
+        {   //Not too hard for us (or we dont care)
+            if(entries[i].frequency >= roll) return entries[i].monster;
+            else roll -= entries[i].frequency;
         }
     }
-    return "GROUP_NULL";
+    return g.defaultMonster;
+}
+
+mon_id MonsterGroupManager::GetMonsterFromGroup(std::string group, int turn)
+{
+    return GetMonsterFromGroup(FindGroupId(group), turn);
+}
+
+bool MonsterGroupManager::IsMonsterInGroup(int group, mon_id monster)
+{
+    if (group < 0 || group >= groups.size() || monster < 0 ||
+        monster >= groups[group].members.size())
+        return false;
+    return groups[group].members[monster];
+}
+
+int MonsterGroupManager::Monster2Group(mon_id monster)
+{
+    if (monster < 0 || monster >= monsterGroups.size())
+        return 0;
+    return monsterGroups[monster];
 }
 
 std::vector<mon_id> MonsterGroupManager::GetMonstersFromGroup(std::string group)
 {
-    MonsterGroup g = GetMonsterGroup(group);
+    const MonsterGroup &g = GetMonsterGroup(group);
 
     std::vector<mon_id> monsters;
 
     monsters.push_back(g.defaultMonster);
 
-    for (FreqDef_iter it = g.monsters.begin(); it != g.monsters.end(); ++it)
+    for (int i = 0; i < g.entries.size(); i++)
     {
-        monsters.push_back(it->first);
+        monsters.push_back(g.entries[i].monster);
     }
     return monsters;
 }
 
-MonsterGroup MonsterGroupManager::GetMonsterGroup(std::string group)
+const MonsterGroup& MonsterGroupManager::GetMonsterGroup(std::string group)
 {
-    std::map<std::string, MonsterGroup>::iterator it = monsterGroupMap.find(group);
-    if(it == monsterGroupMap.end())
+    std::map<std::string, int>::iterator it = groupIds.find(group);
+    if(it == groupIds.end())
     {
         debugmsg("Unable to get the group '%s'", group.c_str());
-        return MonsterGroup();
+        return groups[GroupId("GROUP_NULL")];
     }
     else
     {
-        return it->second;
+        return groups[it->second];
     }
 }
 
@@ -155,12 +272,13 @@ void MonsterGroupManager::LoadJSONGroups()
     picojson::object jsonobj;
     MonsterGroup g;
 
-    const picojson::array& groups = groupsRaw.get<picojson::array>();
-    for (picojson::array::const_iterator it_groups = groups.begin(); it_groups != groups.end(); ++it_groups)
+    const picojson::array& jsongroups = groupsRaw.get<picojson::array>();
+    for (picojson::array::const_iterator it_groups = jsongroups.begin(); it_groups != jsongroups.end(); ++it_groups)
     {
         jsonobj = it_groups->get<picojson::object>();
         g = GetMGroupFromJSON(&jsonobj);
-        monsterGroupMap[g.name] = g;
+        int id = GroupId(g.name);
+        groups[id] = g;
     }
 }
 
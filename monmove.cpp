@@ -24,6 +24,27 @@ void monster::receive_moves()
  moves += speed;
 }
 
+bool monster::unstimulated(game *g, const std::vector<point> &targets, int range)
+{
+ if (friendly != 0 || wandf > 0 || !plans.empty() || effects.any() ||
+     (type->sp_freq > 0 && sp_timeout == 0) ||
+     g->m.field_peek(posx, posy).type != fd_null)
+  return false;
+ if (has_flag(MF_SMELLS)) {
+  for (int x = -1; x <= 1; x++) {
+   for (int y = -1; y <= 1; y++) {
+    if (g->scent(posx + x, posy + y) > 0)
+     return false;
+   }
+  }
+ }
+ for (int i = 0; i < targets.size(); i++) {
+  if (rl_dist(posx, posy, targets[i].x, targets[i].y) <= range)
+   return false;
+ }
+ return true;
+}
+
 bool monster::wander()
 {
  return (plans.empty());
@@ -49,9 +70,8 @@ bool monster::can_move_to(map &m, int x, int y)
 // circumstance (or else the monster will "phase" through solid terrain!)
 void monster::set_dest(int x, int y, int &t)
 {
- plans.clear();
 // TODO: This causes a segfault, once in a blue moon!  Whyyyyy.
- plans = line_to(posx, posy, x, y, t);
+ line_to(posx, posy, x, y, t, plans);
 }
 
 // Move towards (x,y) for f more turns--generally if we hear a sound there
@@ -610,7 +630,7 @@ void monster::move_to(game *g, int x, int y)
   }
 // Diggers turn the dirt into dirtmound
   if (has_flag(MF_DIGS))
-   g->m.ter(posx, posy) = t_dirtmound;
+   g->m.ter_set(posx, posy, t_dirtmound);
 // Acid trail monsters leave... a trail of acid
   if (has_flag(MF_ACIDTRAIL))
    g->m.add_field(g, posx, posy, fd_acid, 1);
@@ -34,6 +34,7 @@ monster::monster()
  mission_id = -1;
  dead = false;
  made_footstep = false;
+ idle_turns = 0;
  unique_name = "";
 }
 
@@ -60,6 +61,7 @@ monster::monster(mtype *t)
  mission_id = -1;
  dead = false;
  made_footstep = false;
+ idle_turns = 0;
  unique_name = "";
 }
 
@@ -86,6 +88,7 @@ monster::monster(mtype *t, int x, int y)
  mission_id = -1;
  dead = false;
  made_footstep = false;
+ idle_turns = 0;
  unique_name = "";
 }
 
@@ -237,25 +240,6 @@ nc_color monster::color_with_effects()
  return ret;
 }
 
-bool monster::has_flag(m_flag f)
-{
- for (int i = 0; i < type->flags.size(); i++) {
-  if (type->flags[i] == f)
-   return true;
- }
- return false;
-}
-
-bool monster::can_see()
-{
- return has_flag(MF_SEES) && !has_effect(ME_BLIND);
-}
-
-bool monster::can_hear()
-{
- return has_flag(MF_HEARS) && !has_effect(ME_DEAF);
-}
-
 bool monster::made_of(material m)
 {
  if (type->mat == m)
@@ -619,11 +603,9 @@ void monster::die(game *g)
  if (!dead)
   dead = true;
 // Drop goodies
- int total_chance = 0, total_it_chance, cur_chance, selected_location,
-     selected_item;
+ int total_chance = 0, cur_chance, selected_location;
  bool animal_done = false;
- std::vector<items_location_and_chance> it = g->monitems[type->id];
- std::vector<itype_id> mapit;
+ const std::vector<items_location_and_chance> &it = g->monitems[type->id];
  if (type->item_chance != 0 && it.size() == 0)
   debugmsg("Type %s has item_chance %d but no items assigned!",
            type->name.c_str(), type->item_chance);
@@ -638,17 +620,8 @@ void monster::die(game *g)
     selected_location++;
     cur_chance -= it[selected_location].chance;
    }
-   total_it_chance = 0;
-   mapit = g->mapitems[it[selected_location].loc];
-   for (int i = 0; i < mapit.size(); i++)
-    total_it_chance += g->itypes[mapit[i]]->rarity;
-   cur_chance = rng(1, total_it_chance);
-   selected_item = -1;
-   while (cur_chance > 0) {
-    selected_item++;
-    cur_chance -= g->itypes[mapit[selected_item]]->rarity;
-   }
-   g->m.add_item(posx, posy, g->itypes[mapit[selected_item]], 0);
+   itype_id selected_item = mapitem_tables[it[selected_location].loc].pick();
+   g->m.add_item(posx, posy, g->itypes[selected_item], 0);
    if (type->item_chance < 0)
     animal_done = true;	// Only drop ONE item.
   }
@@ -704,38 +677,27 @@ void monster::die(game *g)
 
 void monster::add_effect(monster_effect_type effect, int duration)
 {
- for (int i = 0; i < effects.size(); i++) {
-  if (effects[i].type == effect) {
-   effects[i].duration += duration;
-   return;
-  }
- }
- effects.push_back(monster_effect(effect, duration));
-}
-
-bool monster::has_effect(monster_effect_type effect)
-{
- for (int i = 0; i < effects.size(); i++) {
-  if (effects[i].type == effect)
-   return true;
+ if (effects[effect])
+  effect_turns[effect] += duration;
+ else {
+  effects.set(effect);
+  effect_turns[effect] = duration;
  }
- return false;
 }
 
 void monster::rem_effect(monster_effect_type effect)
 {
- for (int i = 0; i < effects.size(); i++) {
-  if (effects[i].type == effect) {
-   effects.erase(effects.begin() + i);
-   i--;
-  }
- }
+ effects.reset(effect);
 }
 
 void monster::process_effects(game *g)
 {
- for (int i = 0; i < effects.size(); i++) {
-  switch (effects[i].type) {
+ if (effects.none())
+  return;
+ for (int i = 0; i < NUM_MONSTER_EFFECTS; i++) {
+  if (!effects[i])
+   continue;
+  switch (i) {
   case ME_POISONED:
    speed -= rng(0, 3);
    hurt(rng(1, 3));
@@ -752,16 +714,15 @@ void monster::process_effects(game *g)
    break;
 
   }
-  if (effects[i].duration > 0) {
-   effects[i].duration--;
+  if (effect_turns[i] > 0) {
+   effect_turns[i]--;
    if (g->debugmon)
-    debugmsg("Duration %d", effects[i].duration);
+    debugmsg("Duration %d", effect_turns[i]);
   }
-  if (effects[i].duration == 0) {
+  if (effect_turns[i] == 0) {
    if (g->debugmon)
     debugmsg("Deleting");
-   effects.erase(effects.begin() + i);
-   i--;
+   effects.reset(i);
   }
  }
 }
@@ -810,3 +771,65 @@ void monster::add_item(item it)
 {
  inv.push_back(it);
 }
+
+// Handles hold the slot in their low 16 bits and its generation above that
+#define MONSTER_SLOT_BITS 16
+#define MONSTER_GEN_MAX 0x7fff
+
+void monster_list::push_back(const monster &mon)
+{
+ int slot;
+ if (free_slots.empty()) {
+  slot = slot_index.size();
+  slot_index.push_back(-1);
+  slot_gen.push_back(0);
+ } else {
+  slot = free_slots.back();
+  free_slots.pop_back();
+ }
+ slot_index[slot] = mons.size();
+ mon_slot.push_back(slot);
+ mons.push_back(mon);
+ pushes++;
+}
+
+void monster_list::remove(int i)
+{
+ const int slot = mon_slot[i], last = mons.size() - 1;
+ if (i != last) {
+  mons[i] = mons[last];
+  mon_slot[i] = mon_slot[last];
+  slot_index[mon_slot[i]] = i;
+ }
+ mons.pop_back();
+ mon_slot.pop_back();
+ slot_index[slot] = -1;
+// Rather than wrap its generation and repeat an old handle, retire the slot
+ if (slot_gen[slot] < MONSTER_GEN_MAX) {
+  slot_gen[slot]++;
+  free_slots.push_back(slot);
+ }
+}
+
+void monster_list::clear()
+{
+ for (int i = mons.size() - 1; i >= 0; i--)
+  remove(i);
+}
+
+int monster_list::handle_at(int i) const
+{
+ if (i < 0 || i >= mons.size())
+  return -1;
+ return mon_slot[i] | (slot_gen[mon_slot[i]] << MONSTER_SLOT_BITS);
+}
+
+int monster_list::index_of(int handle) const
+{
+ if (handle < 0)
+  return -1;
+ const int slot = handle & ((1 << MONSTER_SLOT_BITS) - 1);
+ if (slot >= slot_index.size() || slot_gen[slot] != (handle >> MONSTER_SLOT_BITS))
+  return -1;
+ return slot_index[slot];
+}
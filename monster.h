@@ -27,6 +27,9 @@ ME_RUN,			// For hit-and-run monsters; we're running for a bit;
 NUM_MONSTER_EFFECTS
 };
 
+#define MONSTER_IDLE_TURNS 5   // Unstimulated turns before a monster goes dormant
+#define MONSTER_DORMANT_RATE 4 // A dormant monster only acts every this many turns
+
 enum monster_attitude {
 MATT_NULL = 0,
 MATT_FRIEND,
@@ -37,13 +40,6 @@ MATT_ATTACK,
 NUM_MONSTER_ATTITUDES
 };
 
-struct monster_effect
-{
- monster_effect_type type;
- int duration;
- monster_effect(monster_effect_type T, int D) : type (T), duration (D) {}
-};
-
 class monster {
  public:
  monster();
@@ -61,9 +57,9 @@ class monster {
  void draw(WINDOW* w, int plx, int ply, bool inv);
  nc_color color_with_effects();	// Color with fire, beartrapped, etc.
 				// Inverts color if inv==true
- bool has_flag(m_flag f);	// Returns true if f is set (see mtype.h)
- bool can_see();		// MF_SEES and no ME_BLIND
- bool can_hear();		// MF_HEARS and no ME_DEAF
+ bool has_flag(m_flag f) { return type->flags[f]; } // See mtype.h
+ bool can_see() { return type->flags[MF_SEES] && !effects[ME_BLIND]; }
+ bool can_hear() { return type->flags[MF_HEARS] && !effects[ME_DEAF]; }
  bool made_of(material m);	// Returns true if it's made of m
 
  void load_info(std::string data, std::vector<mtype*> *mtypes);
@@ -85,6 +81,10 @@ class monster {
 				      // the route.  Give up after f steps.
  void plan(game *g);
  void move(game *g); // Actual movement
+// True if nothing nearby could make us do more than stumble about: no plans,
+//  sound, effect, field, scent or charged special attack, and none of targets
+//  within range
+ bool unstimulated(game *g, const std::vector<point> &targets, int range);
  void footsteps(game *g, int x, int y); // noise made by movement
  void friendly_move(game *g);
 
@@ -114,7 +114,7 @@ class monster {
 
 // Other
  void add_effect(monster_effect_type effect, int duration);
- bool has_effect(monster_effect_type effect); // True if we have the effect
+ bool has_effect(monster_effect_type effect) { return effects[effect]; }
  void rem_effect(monster_effect_type effect); // Remove a given effect
  void process_effects(game *g);	// Process long-term effects
  bool make_fungus(game *g);	// Makes this monster into a fungus version
@@ -127,7 +127,8 @@ class monster {
  int wandx, wandy; // Wander destination - Just try to move in that direction
  int wandf;	   // Urge to wander - Increased by sound, decrements each move
  std::vector<item> inv; // Inventory
- std::vector<monster_effect> effects; // Active effects, e.g. on fire
+ std::bitset<NUM_MONSTER_EFFECTS> effects; // Active effects, e.g. on fire
+ int effect_turns[NUM_MONSTER_EFFECTS]; // Turns left of each; < 0 is forever
 
 // If we were spawned by the map, store our origin for later use
  int spawnmapx, spawnmapy, spawnposx, spawnposy;
@@ -143,10 +144,43 @@ class monster {
  mtype *type;
  bool dead;
  bool made_footstep;
+ int idle_turns; // Turns in a row unstimulated(); not saved
  std::string unique_name; // If we're unique
 
 private:
  std::vector <point> plans;
 };
 
+// The monsters in play, indexed like a vector.  Removing one moves the last
+//  monster into its place, so indices change on removal; a handle names the
+//  same monster until it is removed, and is never reused for another.  A slot
+//  is retired once its generation is used up, after 32768 monsters.
+class monster_list
+{
+ public:
+  monster_list() : pushes(0) {}
+
+  int size() const { return mons.size(); }
+  bool empty() const { return mons.empty(); }
+  monster& operator[](int i) { return mons[i]; }
+  const monster& operator[](int i) const { return mons[i]; }
+
+  void reserve(int n) { mons.reserve(n); mon_slot.reserve(n); }
+  void push_back(const monster &mon);
+  void remove(int i);
+  void clear();
+
+  int handle_at(int i) const; // -1 if i is out of range
+  int index_of(int handle) const; // -1 if that monster is gone
+  int push_count() const { return pushes; } // Monsters ever added
+
+ private:
+  std::vector<monster> mons;
+  std::vector<int> mon_slot;   // The slot of mons[i]
+  std::vector<int> slot_index; // The index of the slot's monster; -1 if free
+  std::vector<int> slot_gen;   // Bumped each time the slot is freed
+  std::vector<int> free_slots;
+  int pushes;
+};
+
 #endif
@@ -5,6 +5,7 @@
 
 #include <string>
 #include <vector>
+#include <bitset>
 #include <math.h>
 #include "mondeath.h"
 #include "monattack.h"
@@ -186,7 +187,7 @@ struct mtype {
 
  m_size size;
  material mat;	// See enums.h for material list.  Generally, flesh; veggy?
- std::vector<m_flag> flags;
+ std::bitset<MF_MAX> flags; // Bit n is set if we have m_flag n
  std::vector<m_category> categories;
  std::vector<monster_trigger> anger;   // What angers us?
  std::vector<monster_trigger> placate; // What reduces our anger?
@@ -238,7 +239,7 @@ struct mtype {
   item_chance = 0;
   dies = NULL;
   sp_attack = NULL;
-  flags.push_back(MF_HUMAN);
+  flags.set(MF_HUMAN);
  }
  // Non-default (messy)
  mtype (int pid, std::string pname, monster_species pspecies, char psym,
@@ -283,11 +284,7 @@ struct mtype {
 
  bool has_flag(m_flag flag)
  {
-  for (int i = 0; i < flags.size(); i++) {
-   if (flags[i] == flag)
-    return true;
-  }
-  return false;
+  return flags[flag];
  }
 
  bool in_category(m_category category)
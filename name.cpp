@@ -4,6 +4,7 @@
 #include <map>
 
 #include "name.h"
+#include "rng.h"
 #include "picojson.h"
 
 NameGenerator::NameGenerator() {
@@ -65,7 +66,7 @@ std::vector<std::string> NameGenerator::filteredNames(uint32_t searchFlags) {
 std::string NameGenerator::getName(uint32_t searchFlags) {
   std::vector<std::string> theseNames = filteredNames(searchFlags);
 
-  return theseNames[std::rand() % theseNames.size()];
+  return theseNames[rng(0, theseNames.size() - 1)];
 }
 
 std::string NameGenerator::generateName(bool male) {
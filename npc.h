@@ -8,6 +8,7 @@
 #include <vector>
 #include <string>
 #include <sstream>
+#include <map>
 
 #define NPC_LOW_VALUE       5
 #define NPC_HI_VALUE        8
@@ -395,6 +396,46 @@ struct npc_chatbin
  }
 };
 
+/*
+ * Shared, per-turn view of the world for NPC planning, cleared by
+ * game::monmove() before any NPC acts and filled in as NPCs ask.  Sight lines
+ * are kept per (observer tile, target tile) for all NPCs together: the first
+ * NPC to ask about a pair of tiles traces the line and every NPC standing on
+ * the same tile reuses it, until the turn ends or map::sight_changes() goes
+ * up.  Monsters, their danger and their priority are read live from g->z,
+ * since they come, go and move while NPCs act.
+ */
+class npc;
+
+class npc_turn_snapshot
+{
+public:
+ npc_turn_snapshot();
+ void clear();
+ bool sees(game *g, int Fx, int Fy, int Tx, int Ty, int range, int &t); // As map::sees()
+ bool sees_monster(game *g, npc *p, monster *mon, int &t); // As game::pl_sees()
+ int confident_range(npc *p); // Of p's wielded gun, worked out once
+ const std::vector<point>& item_piles(game *g);
+
+private:
+ struct sight_line {
+  bool sees;
+  int t;
+ };
+ struct gun_range {
+  int npc_id, recoil;
+  itype *gun;
+  it_ammo *ammo;
+  int range;
+ };
+ std::map<int, sight_line> sights; // By sight_key()
+ int sights_changes; // g->m.sight_changes() when sights were filled
+ int sights_turn;    // And the turn, since vehicles move between turns
+ std::vector<gun_range> ranges;
+ std::vector<point> piles;
+ bool piles_built;
+};
+
 class npc : public player {
 
 public:
@@ -513,7 +554,8 @@ public:
  int  choose_escape_item(); // Returns index of our best escape aid
 
 // Helper functions for ranged combat
- int  confident_range(int index = -1); // >= 50% chance to hit
+ int  confident_range(game *g, int index = -1); // >= 50% chance to hit
+ int  calc_confident_range(int index = -1); // As above, worked out afresh
  bool wont_hit_friend(game *g, int tarx, int tary, int index = -1);
  bool can_reload(); // Wielding a gun that is not fully loaded
  bool need_to_reload(); // Wielding a gun that is empty
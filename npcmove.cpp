@@ -42,6 +42,150 @@ struct ratio_index
  ratio_index(double R, int I) : ratio (R), index (I) {};
 };
 
+// Used in npc::wont_hit_friend(); walk_line() stops at the first square that
+//  a shot along the line, or one that strays from it, might hit a friend on
+struct friendly_fire_check
+{
+ game *g;
+ npc *shooter;
+ int confident;
+ bool operator()(int tx, int ty)
+ {
+  int dist = rl_dist(shooter->posx, shooter->posy, tx, ty);
+  int deviation = 1 + int(dist / confident);
+  for (int x = tx - deviation; x <= tx + deviation; x++) {
+   for (int y = ty - deviation; y <= ty + deviation; y++) {
+// Hit the player?
+    if (shooter->is_friend() && g->u.posx == x && g->u.posy == y)
+     return false;
+// Hit a friendly monster?
+/*
+    for (int n = 0; n < g->z.size(); n++) {
+     if (g->z[n].friendly != 0 && g->z[n].posx == x && g->z[n].posy == y)
+      return false;
+    }
+*/
+// Hit an NPC that's on our team?
+/*
+    for (int n = 0; n < g->active_npc.size(); n++) {
+     npc* guy = &(g->active_npc[n]);
+     if (guy != shooter && (shooter->is_friend() == guy->is_friend()) &&
+         guy->posx == x && guy->posy == y)
+      return false;
+    }
+*/
+   }
+  }
+  return true;
+ }
+};
+
+// Used in npc::move_to(); walk_line() stops at the first square
+struct first_step
+{
+ point p;
+ bool operator()(int x, int y)
+ {
+  p = point(x, y);
+  return false;
+ }
+};
+
+npc_turn_snapshot::npc_turn_snapshot()
+{
+ sights_changes = -1;
+ sights_turn = -1;
+ piles_built = false;
+}
+
+void npc_turn_snapshot::clear()
+{
+ sights.clear();
+ sights_changes = -1;
+ sights_turn = -1;
+ ranges.clear();
+ piles.clear();
+ piles_built = false;
+}
+
+// Both ends packed into one key; -1 for squares outside the reality bubble
+static int sight_key(int Fx, int Fy, int Tx, int Ty)
+{
+ const int w = SEEX * MAPSIZE, h = SEEY * MAPSIZE;
+ if (Fx < 0 || Fx >= w || Fy < 0 || Fy >= h ||
+     Tx < 0 || Tx >= w || Ty < 0 || Ty >= h)
+  return -1;
+ return ((Fx * h + Fy) * w + Tx) * h + Ty;
+}
+
+// The range check is cheap and differs between NPCs, so only the line itself
+//  is shared
+bool npc_turn_snapshot::sees(game *g, int Fx, int Fy, int Tx, int Ty,
+                             int range, int &t)
+{
+ if (range >= 0 && (abs(Tx - Fx) > range || abs(Ty - Fy) > range))
+  return false;
+ const int key = sight_key(Fx, Fy, Tx, Ty);
+ if (key == -1)
+  return g->m.sees(Fx, Fy, Tx, Ty, -1, t);
+ if (sights_changes != g->m.sight_changes() || sights_turn != int(g->turn)) {
+  sights.clear();
+  sights_changes = g->m.sight_changes();
+  sights_turn = int(g->turn);
+ }
+ std::map<int, sight_line>::iterator it = sights.find(key);
+ if (it == sights.end()) {
+  sight_line line;
+  line.t = 0;
+  line.sees = g->m.sees(Fx, Fy, Tx, Ty, -1, line.t);
+  it = sights.insert(std::make_pair(key, line)).first;
+ }
+ t = it->second.t;
+ return it->second.sees;
+}
+
+bool npc_turn_snapshot::sees_monster(game *g, npc *p, monster *mon, int &t)
+{
+ if (mon->has_flag(MF_DIGS) && !p->has_active_bionic(bio_ground_sonar) &&
+     rl_dist(p->posx, p->posy, mon->posx, mon->posy) > 1)
+  return false; // Same as game::pl_sees()
+ int range = p->sight_range(g->light_level());
+ return sees(g, p->posx, p->posy, mon->posx, mon->posy, range, t);
+}
+
+// Recoil, a new gun or new ammo all change the answer
+int npc_turn_snapshot::confident_range(npc *p)
+{
+ for (int i = 0; i < ranges.size(); i++) {
+  if (ranges[i].npc_id == p->id && ranges[i].recoil == p->recoil &&
+      ranges[i].gun == p->weapon.type && ranges[i].ammo == p->weapon.curammo)
+   return ranges[i].range;
+ }
+ gun_range r;
+ r.npc_id = p->id;
+ r.recoil = p->recoil;
+ r.gun = p->weapon.type;
+ r.ammo = p->weapon.curammo;
+ r.range = p->calc_confident_range(-1);
+ ranges.push_back(r);
+ return r.range;
+}
+
+// Every tile in the reality bubble holding items, found on first request
+const std::vector<point>& npc_turn_snapshot::item_piles(game *g)
+{
+ if (!piles_built) {
+  piles_built = true;
+  for (int x = 0; x < SEEX * MAPSIZE; x++) {
+   for (int y = 0; y < SEEY * MAPSIZE; y++) {
+    if (!g->m.i_peek(x, y).empty())
+     piles.push_back(point(x, y));
+   }
+  }
+ }
+ return piles;
+}
+
 // class npc functions!
 
 void npc::move(game *g)
@@ -52,7 +196,7 @@ void npc::move(game *g)
  choose_monster_target(g, target, danger, total_danger);
  if (g->debugmon)
   debugmsg("NPC %s: target = %d, danger = %d, range = %d",
-           name.c_str(), target, danger, confident_range(-1));
+           name.c_str(), target, danger, confident_range(g));
 
  if (is_enemy()) {
   int pl_danger = player_danger( &(g->u) );
@@ -155,10 +299,10 @@ void npc::execute_action(game *g, npc_action action, int target)
  std::vector<point> line;
  if (tarx != posx || tary != posy) {
   int linet, dist = sight_range(g->light_level());
-  if (g->m.sees(posx, posy, tarx, tary, dist, linet))
-   line = line_to(posx, posy, tarx, tary, linet);
+  if (g->npc_snapshot.sees(g, posx, posy, tarx, tary, dist, linet))
+   line_to(posx, posy, tarx, tary, linet, line);
   else
-   line = line_to(posx, posy, tarx, tary, 0);
+   line_to(posx, posy, tarx, tary, 0, line);
  }
 
  switch (action) {
@@ -285,7 +429,7 @@ void npc::execute_action(game *g, npc_action action, int target)
   break;
 
  case npc_look_for_player:
-  if (saw_player_recently() && g->m.sees(posx, posy, plx, ply, light, linet)) {
+  if (saw_player_recently() && g->npc_snapshot.sees(g, posx, posy, plx, ply, light, linet)) {
 // (plx, ply) is the point where we last saw the player
    update_path(g, plx, ply);
    move_to_next(g);
@@ -395,7 +539,7 @@ void npc::choose_monster_target(game *g, int &enemy, int &danger,
 
  for (int i = 0; i < g->z.size(); i++) {
   monster *mon = &(g->z[i]);
-  if (g->pl_sees(this, mon, linet)) {
+  if (g->npc_snapshot.sees_monster(g, this, mon, linet)) {
    int distance = (100 * rl_dist(posx, posy, mon->posx, mon->posy)) /
                   mon->speed;
    double hp_percent = (mon->type->hp - mon->hp) / mon->type->hp;
@@ -509,7 +653,7 @@ npc_action npc::method_of_attack(game *g, int target, int danger)
    return npc_alt_attack;
   if (weapon.is_gun() && (!use_silent || weapon.is_silent()) && weapon.charges > 0) {
    it_gun* gun = dynamic_cast<it_gun*>(weapon.type);
-   if (dist > confident_range()) {
+   if (dist > confident_range(g)) {
     if (can_reload() && (enough_time_to_reload(g, target, weapon) || in_vehicle))
      return npc_reload;
     else if (in_vehicle && dist > 1)
@@ -525,7 +669,7 @@ npc_action npc::method_of_attack(game *g, int target, int danger)
       return npc_pause; // wait for clear shot
     else
      return npc_avoid_friendly_fire;
-   else if (dist <= confident_range() / 3 && weapon.charges >= gun->burst &&
+   else if (dist <= confident_range(g) / 3 && weapon.charges >= gun->burst &&
             gun->burst > 1 &&
             ((weapon.curammo && target_HP >= weapon.curammo->damage * 3) || emergency(danger * 2)))
     return npc_shoot_burst;
@@ -750,9 +894,17 @@ void npc::use_escape_item(game *g, int index, int target)
 }
 
 // Index defaults to -1, i.e., wielded weapon
-int npc::confident_range(int index)
+int npc::confident_range(game *g, int index)
 {
+ if (index == -1 && (!weapon.is_gun() || weapon.charges <= 0))
+  return 1;
+ if (index == -1)
+  return g->npc_snapshot.confident_range(this);
+ return calc_confident_range(index);
+}
 
+int npc::calc_confident_range(int index)
+{
  if (index == -1 && (!weapon.is_gun() || weapon.charges <= 0))
   return 1;
 
@@ -834,44 +986,17 @@ int npc::confident_range(int index)
 bool npc::wont_hit_friend(game *g, int tarx, int tary, int index)
 {
  int linet = 0, dist = sight_range(g->light_level());
- int confident = confident_range(index);
+ int confident = confident_range(g, index);
  if (rl_dist(posx, posy, tarx, tary) == 1)
   return true; // If we're *really* sure that our aim is dead-on
 
- std::vector<point> traj;
- if (g->m.sees(posx, posy, tarx, tary, dist, linet))
-  traj = line_to(posx, posy, tarx, tary, linet);
- else
-  traj = line_to(posx, posy, tarx, tary, 0);
-
- for (int i = 0; i < traj.size(); i++) {
-  int dist = rl_dist(posx, posy, traj[i].x, traj[i].y);
-  int deviation = 1 + int(dist / confident);
-  for (int x = traj[i].x - deviation; x <= traj[i].x + deviation; x++) {
-   for (int y = traj[i].y - deviation; y <= traj[i].y + deviation; y++) {
-// Hit the player?
-    if (is_friend() && g->u.posx == x && g->u.posy == y)
-     return false;
-// Hit a friendly monster?
-/*
-    for (int n = 0; n < g->z.size(); n++) {
-     if (g->z[n].friendly != 0 && g->z[n].posx == x && g->z[n].posy == y)
-      return false;
-    }
-*/
-// Hit an NPC that's on our team?
-/*
-    for (int n = 0; n < g->active_npc.size(); n++) {
-     npc* guy = &(g->active_npc[n]);
-     if (guy != this && (is_friend() == guy->is_friend()) &&
-         guy->posx == x && guy->posy == y)
-      return false;
-    }
-*/
-   }
-  }
- }
- return true;
+ if (!g->npc_snapshot.sees(g, posx, posy, tarx, tary, dist, linet))
+  linet = 0;
+ friendly_fire_check check;
+ check.g = g;
+ check.shooter = this;
+ check.confident = confident;
+ return walk_line(posx, posy, tarx, tary, linet, check);
 }
 
 bool npc::can_reload()
@@ -964,12 +1089,13 @@ void npc::move_to(game *g, int x, int y)
            posx, posy, x, y);
   debugmsg("Route is size %d.", path.size());
 */
-  int linet;
-  std::vector<point> newpath;
-  if (g->m.sees(posx, posy, x, y, -1, linet))
-   newpath = line_to(posx, posy, x, y, linet);
-  x = newpath[0].x;
-  y = newpath[0].y;
+  int linet = 0;
+  if (!g->npc_snapshot.sees(g, posx, posy, x, y, -1, linet))
+   linet = 0;
+  first_step step;
+  walk_line(posx, posy, x, y, linet, step);
+  x = step.p.x;
+  y = step.p.y;
  }
  if (x == posx && y == posy)	// We're just pausing!
   moves -= 100;
@@ -1188,9 +1314,11 @@ void npc::find_item(game *g)
  if (maxy >= SEEY * MAPSIZE)
   maxy = SEEY * MAPSIZE - 1;
 
- for (int x = minx; x <= maxx; x++) {
-  for (int y = miny; y <= maxy; y++) {
-   if (g->m.sees(posx, posy, x, y, range, linet)) {
+ const std::vector<point> &piles = g->npc_snapshot.item_piles(g);
+ for (int p = 0; p < piles.size(); p++) {
+  int x = piles[p].x, y = piles[p].y;
+  if (x >= minx && x <= maxx && y >= miny && y <= maxy) {
+   if (g->npc_snapshot.sees(g, posx, posy, x, y, range, linet)) {
     for (int i = 0; i < g->m.i_at(x, y).size(); i++) {
      int itval = value(g->m.i_at(x, y)[i]);
      int wgt = g->m.i_at(x, y)[i].weight(), vol = g->m.i_at(x, y)[i].volume();
@@ -1530,12 +1658,12 @@ void npc::alt_attack(game *g, int target)
   std::vector<point> trajectory;
   int linet, light = g->light_level();
 
-  if (dist <= confident_range(index) && wont_hit_friend(g, tarx, tary, index)) {
+  if (dist <= confident_range(g, index) && wont_hit_friend(g, tarx, tary, index)) {
 
-   if (g->m.sees(posx, posy, tarx, tary, light, linet))
-    trajectory = line_to(posx, posy, tarx, tary, linet);
+   if (g->npc_snapshot.sees(g, posx, posy, tarx, tary, light, linet))
+    line_to(posx, posy, tarx, tary, linet, trajectory);
    else
-    trajectory = line_to(posx, posy, tarx, tary, 0);
+    line_to(posx, posy, tarx, tary, 0, trajectory);
    moves -= 125;
    if (g->u_see(posx, posy, linet))
     g->add_msg("%s throws a %s.", name.c_str(), used->tname().c_str());
@@ -1547,7 +1675,7 @@ void npc::alt_attack(game *g, int target)
    if (!used->active || used->charges > 2) // Safe to hold on to, for now
     avoid_friendly_fire(g, target); // Maneuver around player
    else { // We need to throw this live (grenade, etc) NOW! Pick another target?
-    int conf = confident_range(index);
+    int conf = confident_range(g, index);
     for (int dist = 2; dist <= conf; dist++) {
      for (int x = posx - dist; x <= posx + dist; x++) {
       for (int y = posy - dist; y <= posy + dist; y++) {
@@ -1584,10 +1712,10 @@ void npc::alt_attack(game *g, int target)
  * should be equal to the original location of our target, and risking friendly
  * fire is better than holding on to a live grenade / whatever.
  */
-    if (g->m.sees(posx, posy, tarx, tary, light, linet))
-     trajectory = line_to(posx, posy, tarx, tary, linet);
+    if (g->npc_snapshot.sees(g, posx, posy, tarx, tary, light, linet))
+     line_to(posx, posy, tarx, tary, linet, trajectory);
     else
-     trajectory = line_to(posx, posy, tarx, tary, 0);
+     line_to(posx, posy, tarx, tary, 0, trajectory);
     moves -= 125;
     if (g->u_see(posx, posy, linet))
      g->add_msg("%s throws a %s.", name.c_str(), used->tname().c_str());
@@ -1897,7 +2025,7 @@ void npc::mug_player(game *g, player &mark)
 void npc::look_for_player(game *g, player &sought)
 {
  int linet, range = sight_range(g->light_level());
- if (g->m.sees(posx, posy, sought.posx, sought.posy, range, linet)) {
+ if (g->npc_snapshot.sees(g, posx, posy, sought.posx, sought.posy, range, linet)) {
   if (sought.is_npc())
    debugmsg("npc::look_for_player() called, but we can see %s!",
             sought.name.c_str());
@@ -1909,7 +2037,7 @@ void npc::look_for_player(game *g, player &sought)
 
  if (!path.empty()) {
   point dest = path[path.size() - 1];
-  if (!g->m.sees(posx, posy, dest.x, dest.y, range, linet)) {
+  if (!g->npc_snapshot.sees(g, posx, posy, dest.x, dest.y, range, linet)) {
    move_to_next(g);
    return;
   }
@@ -1918,7 +2046,7 @@ void npc::look_for_player(game *g, player &sought)
  std::vector<point> possibilities;
  for (int x = 1; x < SEEX * MAPSIZE; x += 11) { // 1, 12, 23, 34
   for (int y = 1; y < SEEY * MAPSIZE; y += 11) {
-   if (g->m.sees(posx, posy, x, y, range, linet))
+   if (g->npc_snapshot.sees(g, posx, posy, x, y, range, linet))
     possibilities.push_back(point(x, y));
   }
  }
@@ -2029,7 +2157,7 @@ void npc::go_to_destination(game *g)
      if ((g->m.move_cost(x + dx, y + dy) > 0 ||
           g->m.has_flag(bashable, x + dx, y + dy) ||
           g->m.ter(x + dx, y + dy) == t_door_c) &&
-         g->m.sees(posx, posy, x + dx, y + dy, light, linet)) {
+         g->npc_snapshot.sees(g, posx, posy, x + dx, y + dy, light, linet)) {
       path = g->m.route(posx, posy, x + dx, y + dy);
       if (!path.empty() && can_move_to(g, path[0].x, path[0].y)) {
        move_to_next(g);
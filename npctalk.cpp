@@ -1923,7 +1923,7 @@ Tab key to switch lists, letters to pick items, Enter to finalize, Esc to quit\n
   }
 // Do it in two passes, so removing items doesn't corrupt yours[]
   for (int i = 0; i < removing.size(); i++)
-   g->u.i_rem(removing[i]);
+   g->u.i_rem(removing[i], g);
 
   for (int i = 0; i < theirs.size(); i++) {
    item tmp = p->inv[theirs[i]];
@@ -1939,6 +1939,7 @@ Tab key to switch lists, letters to pick items, Enter to finalize, Esc to quit\n
       tmp.invlet++;
     }
     g->u.inv.push_back(tmp);
+    g->crafting_view_adjust(tmp, 1);
    } else
     newinv.push_back(tmp);
   }
@@ -210,6 +210,8 @@ option_key lookup_option_key(std::string id)
   return OPT_QUERY_DISASSEMBLE;
  if (id == "drop_empty")
   return OPT_DROP_EMPTY;
+ if (id == "no_animations")
+  return OPT_NO_ANIMATIONS;
  if (id == "skill_rust")
   return OPT_SKILL_RUST;
  if (id == "delete_world")
@@ -226,6 +228,8 @@ option_key lookup_option_key(std::string id)
   return OPT_STATIC_SPAWN;
  if (id == "classic_zombies")
   return OPT_CLASSIC_ZOMBIES;
+ if (id == "resident_submaps")
+  return OPT_RESIDENT_SUBMAPS;
  return OPT_NULL;
 }
 
@@ -246,6 +250,7 @@ std::string option_string(option_key key)
   case OPT_GRADUAL_NIGHT_LIGHT: return "gradual_night_light";
   case OPT_QUERY_DISASSEMBLE: return "query_disassemble";
   case OPT_DROP_EMPTY: return "drop_empty";
+  case OPT_NO_ANIMATIONS: return "no_animations";
   case OPT_SKILL_RUST: return "skill_rust";
   case OPT_DELETE_WORLD: return "delete_world";
   case OPT_INITIAL_POINTS: return "initial_points";
@@ -254,6 +259,7 @@ std::string option_string(option_key key)
   case OPT_VIEWPORT_Y: return "viewport_y";
   case OPT_STATIC_SPAWN: return "static_spawn";
   case OPT_CLASSIC_ZOMBIES: return "classic_zombies";
+  case OPT_RESIDENT_SUBMAPS: return "resident_submaps";
   default:			return "unknown_option";
  }
  return "unknown_option";
@@ -276,6 +282,7 @@ std::string option_desc(option_key key)
   case OPT_GRADUAL_NIGHT_LIGHT: return "If true will add nice gradual-lighting\n(should only make a difference @night)";
   case OPT_QUERY_DISASSEMBLE: return "If true, will query before disassembling\nitems";
   case OPT_DROP_EMPTY: return "Set to drop empty containers after use\n0 - don't drop any\n1 - all except watertight containers\n2 - all containers";
+  case OPT_NO_ANIMATIONS: return "If true, explosions and shrapnel\nare not animated";
   case OPT_SKILL_RUST: return "Set the level of skill rust\n0 - vanilla Cataclysm\n1 - capped at skill levels\n2 - none at all";
   case OPT_DELETE_WORLD: return "Delete saves upon player death\n0 - no\n1 - yes\n2 - query";
   case OPT_INITIAL_POINTS: return "Initial points available on character\ngeneration.  Default is 6";
@@ -284,6 +291,7 @@ std::string option_desc(option_key key)
   case OPT_VIEWPORT_Y: return "WINDOWS ONLY: Set the expansion of the viewport along\nthe Y axis.  Must restart for changes\nto take effect.  Default is 12. POSIX\nsystems will use terminal size at startup.";
   case OPT_STATIC_SPAWN: return "Spawn zombies at game start instead of\nduring game. Must delete save directory\nafter changing for it to take effect.\nDefault is F";
   case OPT_CLASSIC_ZOMBIES: return "Only spawn classic zombies and natural\nwildlife. Probably requires a reset of\nsave folder to take effect. Default is F";
+  case OPT_RESIDENT_SUBMAPS: return "Hundreds of map pieces kept in memory.\nThe rest wait on disk until you come\nback.  0 - no limit.  Default is 40";
   default:			return " ";
  }
  return "Big ol Bug";
@@ -306,6 +314,7 @@ std::string option_name(option_key key)
   case OPT_GRADUAL_NIGHT_LIGHT: return "Gradual night light";
   case OPT_QUERY_DISASSEMBLE: return "Query on disassembly";
   case OPT_DROP_EMPTY: return "Drop empty containers";
+  case OPT_NO_ANIMATIONS: return "No animations";
   case OPT_SKILL_RUST: return "Skill Rust";
   case OPT_DELETE_WORLD: return "Delete World";
   case OPT_INITIAL_POINTS: return "Initial points";
@@ -314,6 +323,7 @@ std::string option_name(option_key key)
   case OPT_VIEWPORT_Y: return "Viewport height";
   case OPT_STATIC_SPAWN: return "Static spawn";
   case OPT_CLASSIC_ZOMBIES: return "Classic zombies";
+  case OPT_RESIDENT_SUBMAPS: return "Resident submaps (x100)";
   default:			return "Unknown Option (BUG)";
  }
  return "Big ol Bug";
@@ -332,6 +342,7 @@ bool option_is_bool(option_key id)
   case OPT_INITIAL_TIME:
   case OPT_VIEWPORT_X:
   case OPT_VIEWPORT_Y:
+  case OPT_RESIDENT_SUBMAPS:
    return false;
     break;
   default:
@@ -372,6 +383,9 @@ char option_max_options(option_key id)
       case OPT_VIEWPORT_Y:
         ret = 93; // TODO Set up min/max values so weird numbers don't have to be used.
         break;
+      case OPT_RESIDENT_SUBMAPS:
+        ret = 101;
+        break;
       default:
         ret = 2;
         break;
@@ -416,6 +430,8 @@ query_disassemble T\n\
 # Player will automatically drop empty containers after use\n\
 # 0 - don't drop any, 1 - drop all except watertight containers, 2 - drop all containers\n\
 drop_empty 0\n\
+# If true, explosions and shrapnel are not animated\n\
+no_animations F\n\
 # \n\
 # GAMEPLAY OPTIONS: CHANGING THESE OPTIONS WILL AFFECT GAMEPLAY DIFFICULTY! \n\
 # Level of skill rust: 0 - vanilla Cataclysm, 1 - capped at skill levels, 2 - none at all\n\
@@ -434,6 +450,8 @@ viewport_y 12\n\
 static_spawn T\n\
 # Only spawn classic zombies and natural wildlife.  You must create a new world after changing\n\
 classic_zombies F\n\
+# Hundreds of submaps kept in memory; the least recently visited wait on disk.  0 for no limit\n\
+resident_submaps 40\n\
 ";
  fout.close();
 }
@@ -19,6 +19,7 @@ OPT_AUTOSAVE, // Automatically save the game on intervals.
 OPT_GRADUAL_NIGHT_LIGHT, // be so cool at night :)
 OPT_QUERY_DISASSEMBLE, // Query before disassembling items
 OPT_DROP_EMPTY, // auto drop empty containers after use
+OPT_NO_ANIMATIONS, // Don't animate explosions and shrapnel
 OPT_SKILL_RUST, // level of skill rust
 OPT_DELETE_WORLD, // Delete workd every time New Character is created
 OPT_INITIAL_POINTS, // Set the number of character points
@@ -27,6 +28,7 @@ OPT_VIEWPORT_X, // Set the width of the terrain window, in characters
 OPT_VIEWPORT_Y, // Set the height of the terrain window, in characters
 OPT_STATIC_SPAWN, // Makes zombies spawn using the new static system
 OPT_CLASSIC_ZOMBIES, // Only spawn the more classic zombies
+OPT_RESIDENT_SUBMAPS, // Hundreds of submaps kept in memory; 0 for no limit
 NUM_OPTION_KEYS
 };
 
@@ -47,6 +49,9 @@ struct option_table
             case OPT_INITIAL_TIME:
                 options[i] = 8;
                 break;
+            case OPT_RESIDENT_SUBMAPS:
+                options[i] = 40;
+                break;
             default:
                 options[i] = 0;
             }
@@ -126,6 +126,7 @@ overmap::overmap()
  , nullret(ot_null)
  , nullbool(false)
  , nullstr("")
+ , index_valid(false)
 {
 // debugmsg("Warning - null overmap!");
  if (num_ter_types > 256 - 32)
@@ -140,6 +141,7 @@ overmap::overmap(game *g, int x, int y)
  , nullret(ot_null)
  , nullbool(false)
  , nullstr("")
+ , index_valid(false)
 {
  if (name.empty()) {
   debugmsg("Attempting to load overmap for unknown player!  Saving won't work!");
@@ -155,6 +157,7 @@ overmap::overmap(game *g, int x, int y)
 
  init_layers();
  open(g);
+ build_index();
 }
 
 overmap::overmap(overmap const& o)
@@ -168,6 +171,9 @@ overmap::overmap(overmap const& o)
     , prefix(o.prefix)
     , name(o.name)
     , layer(NULL)
+    , ter_index(o.ter_index)
+    , city_houses(o.city_houses)
+    , index_valid(o.index_valid)
 {
     layer = new map_layer[OVERMAP_LAYERS];
     for(int z = 0; z < OVERMAP_LAYERS; ++z) {
@@ -200,6 +206,9 @@ overmap& overmap::operator=(overmap const& o)
     loc = o.loc;
     prefix = o.prefix;
     name = o.name;
+    ter_index = o.ter_index;
+    city_houses = o.city_houses;
+    index_valid = o.index_valid;
 
     if (layer) {
         delete [] layer;
@@ -244,6 +253,35 @@ oter_id& overmap::ter(int x, int y, int z)
  return layer[z + OVERMAP_DEPTH].terrain[x][y];
 }
 
+void overmap::ter_set(int x, int y, int z, oter_id type)
+{
+ ter(x, y, z) = type;
+ if (z == 0)
+  index_valid = false;
+}
+
+void overmap::build_index()
+{
+ ter_index.assign(num_ter_types, std::vector<point>());
+ city_houses.assign(cities.size(), std::vector<point>());
+ if (layer == NULL)
+  return;
+ for (int x = 0; x < OMAPX; x++) {
+  for (int y = 0; y < OMAPY; y++)
+   ter_index[ter(x, y, 0)].push_back(point(x, y));
+ }
+ for (int i = 0; i < cities.size(); i++) {
+  const city &c = cities[i];
+  for (int x = c.x - c.s; x <= c.x + c.s; x++) {
+   for (int y = c.y - c.s; y <= c.y + c.s; y++) {
+    if (ter(x, y, 0) >= ot_house_north && ter(x, y, 0) <= ot_house_west)
+     city_houses[i].push_back( point(x, y) );
+   }
+  }
+ }
+ index_valid = true;
+}
+
 bool& overmap::seen(int x, int y, int z)
 {
  if (x < 0 || x >= OMAPX || y < 0 || y >= OMAPY || z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT) {
@@ -819,6 +857,7 @@ void overmap::make_tutorial()
  ter(50, 50, 0) = ot_tutorial;
  ter(50, 50, -1) = ot_tutorial;
  zg.clear();
+ index_valid = false;
 }
 
 // checks whether ter(x,y) is defined 'close to' the given type.
@@ -830,6 +869,22 @@ bool overmap::ter_in_type_range(int x, int y, int z, oter_id type, int type_rang
    return false;
 }
 
+// Where (dx, dy), on the edge of the box d squares out from the origin, came
+//  in find_closest()'s old scan of that box, which took the four edges in turn
+//  and skipped one square on each.
+static int box_scan_order(int dx, int dy, int d)
+{
+ if (dy == -d && dx <= d - 2)
+  return 4 * (dx + d);
+ if (dy == d && dx >= 2 - d)
+  return 4 * (d - dx) + 1;
+ if (dx == -d && dy >= 2 - d)
+  return 4 * (d - dy) + 2;
+ if (dx == d && dy <= d - 2)
+  return 4 * (dy + d) + 3;
+ return 8 * d;
+}
+
 point overmap::find_closest(point origin, oter_id type, int type_range,
                             int &dist, bool must_be_seen)
 {
@@ -838,51 +893,45 @@ point overmap::find_closest(point origin, oter_id type, int type_range,
   if (!must_be_seen || seen(origin.x, origin.y, 0))
    return point(origin.x, origin.y);
 
+ if (!index_valid)
+  build_index();
  int max = (dist == 0 ? OMAPX : dist);
- // expanding box
- for (dist = 0; dist <= max; dist++) {
-  // each edge length is 2*dist-2, because corners belong to one edge
-  // south is +y, north is -y
-  for (int i = 0; i < dist*2-1; i++) {
-   //start at northwest, scan north edge
-   int x = origin.x - dist + i;
-   int y = origin.y - dist;
-   if (ter_in_type_range(x, y, 0, type, type_range))
-    if (!must_be_seen || seen(x, y, 0))
-     return point(x, y);
-
-   //start at southeast, scan south
-   x = origin.x + dist - i;
-   y = origin.y + dist;
-   if (ter_in_type_range(x, y, 0, type, type_range))
-    if (!must_be_seen || seen(x, y, 0))
-     return point(x, y);
-
-   //start at southwest, scan west
-   x = origin.x - dist;
-   y = origin.y + dist - i;
-   if (ter_in_type_range(x, y, 0, type, type_range))
-    if (!must_be_seen || seen(x, y, 0))
-     return point(x, y);
-
-   //start at northeast, scan east
-   x = origin.x + dist;
-   y = origin.y - dist + i;
-   if (ter_in_type_range(x, y, 0, type, type_range))
-    if (!must_be_seen || seen(x, y, 0))
-     return point(x, y);
-  }
- }
- dist=-1;
- return point(-1, -1);
+// Nearest by expanding box; of those in the same box, the first the old scan
+//  would have reached
+ point ret(-1, -1);
+ int best_dist = max + 1, best_order = 0;
+ for (int t = std::max(0, int(type)); t < type + type_range && t < num_ter_types; t++) {
+  const std::vector<point> &places = ter_index[t];
+  for (int i = 0; i < places.size(); i++) {
+   const int dx = places[i].x - origin.x, dy = places[i].y - origin.y;
+   const int d = std::max(abs(dx), abs(dy));
+   if (d == 0 || d > best_dist)
+    continue;
+   const int order = box_scan_order(dx, dy, d);
+   if (d == best_dist && order >= best_order)
+    continue;
+   if (must_be_seen && !seen(places[i].x, places[i].y, 0))
+    continue;
+   ret = places[i];
+   best_dist = d;
+   best_order = order;
+  }
+ }
+ dist = (ret.x == -1 ? -1 : best_dist);
+ return ret;
 }
 
 std::vector<point> overmap::find_terrain(std::string term, int cursx, int cursy, int zlevel)
 {
+// Match the names once, not once per square
+ bool matches[num_ter_types];
+ for (int t = 0; t < num_ter_types; t++)
+  matches[t] = (oterlist[t].name.find(term) != std::string::npos);
+
  std::vector<point> found;
  for (int x = 0; x < OMAPX; x++) {
   for (int y = 0; y < OMAPY; y++) {
-   if (seen(x, y, zlevel) && oterlist[ter(x, y, zlevel)].name.find(term) != std::string::npos)
+   if (matches[ter(x, y, zlevel)] && seen(x, y, zlevel))
     found.push_back( point(x, y) );
   }
  }
@@ -910,17 +959,9 @@ point overmap::random_house_in_city(int city_id)
            cities.size() - 1);
   return point(-1, -1);
  }
- std::vector<point> valid;
- int startx = cities[city_id].x - cities[city_id].s,
-     endx   = cities[city_id].x + cities[city_id].s,
-     starty = cities[city_id].y - cities[city_id].s,
-     endy   = cities[city_id].y + cities[city_id].s;
- for (int x = startx; x <= endx; x++) {
-  for (int y = starty; y <= endy; y++) {
-   if (ter(x, y, 0) >= ot_house_north && ter(x, y, 0) <= ot_house_west)
-    valid.push_back( point(x, y) );
-  }
- }
+ if (!index_valid || city_houses.size() != cities.size())
+  build_index();
+ const std::vector<point> &valid = city_houses[city_id];
  if (valid.empty())
   return point(-1, -1);
 
@@ -1313,6 +1354,66 @@ void overmap::process_mongroups()
  }
 }
 
+// Groups that already cover (x, y) are already there, so only the ones
+//  outside it are drawn in.  The latest signal a horde hears wins.
+void overmap::signal_hordes(int x, int y, int z, int power)
+{
+ for (int i = 0; i < zg.size(); i++) {
+  mongroup &mg = zg[i];
+  if (!mg.horde || mg.diffuse || mg.dying || mg.posz != z)
+   continue;
+  int dist = trig_dist(x, y, mg.posx, mg.posy) - mg.radius;
+  if (dist > 0 && dist <= power) {
+   mg.targetx = x;
+   mg.targety = y;
+   mg.interest = rl_dist(mg.posx, mg.posy, x, y);
+  }
+ }
+}
+
+void overmap::move_hordes()
+{
+ for (int i = 0; i < zg.size(); i++) {
+  mongroup &mg = zg[i];
+  if (mg.interest <= 0)
+   continue;
+  if (mg.targetx != mg.posx)
+   mg.posx += (mg.targetx > mg.posx ? 1 : -1);
+  if (mg.targety != mg.posy)
+   mg.posy += (mg.targety > mg.posy ? 1 : -1);
+// Hordes stay on their own overmap
+  if (mg.posx < 0) mg.posx = 0;
+  if (mg.posy < 0) mg.posy = 0;
+  if (mg.posx >= OMAPX * 2) mg.posx = OMAPX * 2 - 1;
+  if (mg.posy >= OMAPY * 2) mg.posy = OMAPY * 2 - 1;
+  mg.interest--;
+  if (mg.posx == mg.targetx && mg.posy == mg.targety)
+   mg.interest = 0;
+ }
+}
+
+void overmap::mongroups_overlapping(int x1, int y1, int x2, int y2, int z,
+                                    std::vector<int> &groups,
+                                    std::vector<int> &dist)
+{
+ groups.clear();
+ dist.clear();
+ for (int i = 0; i < zg.size(); i++) {
+  const mongroup &mg = zg[i];
+  if (mg.posz != z)
+   continue;
+// The nearest submap of the rectangle to the group's centre
+  int nx = (mg.posx < x1 ? x1 : (mg.posx > x2 ? x2 : mg.posx));
+  int ny = (mg.posy < y1 ? y1 : (mg.posy > y2 ? y2 : mg.posy));
+  int d = (mg.diffuse ? rl_dist(nx, ny, mg.posx, mg.posy) :
+                        trig_dist(nx, ny, mg.posx, mg.posy));
+  if (d <= mg.radius) {
+   groups.push_back(i);
+   dist.push_back(d);
+  }
+ }
+}
+
 void overmap::place_forest()
 {
  int x, y;
@@ -2544,7 +2645,7 @@ void overmap::save()
  }
 
  for (int i = 0; i < zg.size(); i++)
-  fout << "Z " << zg[i].type << " " << zg[i].posx << " " << zg[i].posy << " " << zg[i].posz << " " <<
+  fout << "Z " << MonsterGroupManager::GroupName(zg[i].type) << " " << zg[i].posx << " " << zg[i].posy << " " << zg[i].posz << " " <<
     int(zg[i].radius) << " " << zg[i].population << " " << zg[i].diffuse <<
     std::endl;
  for (int i = 0; i < cities.size(); i++)
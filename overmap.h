@@ -67,6 +67,14 @@ class overmap
   void first_house(int &x, int &y);
 
   void process_mongroups(); // Makes them die out, maybe more
+// Hordes whose territory ends within power submaps of (x, y) start drifting
+//  there; all in submap coordinates, like mongroup::posx
+  void signal_hordes(int x, int y, int z, int power);
+  void move_hordes(); // Moves each drifting horde one submap
+// Indices of groups on level z whose territory overlaps the submaps from
+//  (x1, y1) to (x2, y2); dist gets each one's distance to that rectangle
+  void mongroups_overlapping(int x1, int y1, int x2, int y2, int z,
+                             std::vector<int> &groups, std::vector<int> &dist);
 
 /* Returns the closest point of terrain type [type, type + type_range)
  * Use type_range of 4, for instance, to match all gun stores (4 rotations).
@@ -88,6 +96,9 @@ class overmap
 
   bool ter_in_type_range(int x, int y, int z, oter_id type, int type_range);
   oter_id& ter(int x, int y, int z);
+// Once the overmap is built, change terrain with this, so the index of where
+//  each type is stays current
+  void ter_set(int x, int y, int z, oter_id type);
   bool&   seen(int x, int y, int z);
   std::vector<mongroup*> monsters_at(int x, int y, int z);
   bool is_safe(int x, int y, int z); // true if monsters_at is empty, or only woodland
@@ -120,6 +131,13 @@ class overmap
   bool nullbool;
   std::string nullstr;
 
+// Where each terrain type is on z-level 0, and the houses in each city, in
+//  the order a scan by x then y finds them; see build_index()
+  std::vector< std::vector<point> > ter_index;
+  std::vector< std::vector<point> > city_houses;
+  bool index_valid;
+  void build_index();
+
   // Initialise
   void init_layers();
   void open(game *g);
@@ -3115,11 +3115,12 @@ void player::suffer(game *g)
  if (has_artifact_with(AEP_FORCE_TELEPORT) && one_in(600))
   g->teleport(this);
 
+ const int rads_here = g->m.radiation_peek(posx, posy);
  if (is_wearing(itm_hazmat_suit)) {
-  if (radiation < int((100 * g->m.radiation(posx, posy)) / 20))
-   radiation += rng(0, g->m.radiation(posx, posy) / 20);
- } else if (radiation < int((100 * g->m.radiation(posx, posy)) / 8))
-  radiation += rng(0, g->m.radiation(posx, posy) / 8);
+  if (radiation < int((100 * rads_here) / 20))
+   radiation += rng(0, rads_here / 20);
+ } else if (radiation < int((100 * rads_here) / 8))
+  radiation += rng(0, rads_here / 8);
 
  if (rng(1, 2500) < radiation && (int(g->turn) % 150 == 0 || radiation > 2000)){
   mutate(g);
@@ -3362,14 +3363,16 @@ void player::i_add(item it, game *g)
   inv_sorted = false;
 
  if (it.count_by_charges()) {
+  if (g != NULL && this == &g->u)
+   g->crafting_view_adjust(it, 1);
   for (int i = 0; i < inv.size(); i++) {
    if (inv[i].type->id == item_type_id) {
 
      // does it stack?
     if (inv[i].charges > 0) {
      inv[i].charges += it.charges;
-      it.charges = 0;
-      return;
+     it.charges = 0;
+     return;
     }
    }
   }
@@ -3382,6 +3385,8 @@ void player::i_add(item it, game *g)
   it_artifact_tool *art = dynamic_cast<it_artifact_tool*>(it.type);
   g->add_artifact_messages(art->effects_carried);
  }
+ if (g != NULL && this == &g->u)
+  g->crafting_view_adjust(it, 1);
  inv.push_back(it);
 }
 
@@ -3572,14 +3577,19 @@ void player::remove_mission_items(int mission_id)
  }
 }
 
-item player::i_rem(char let)
+// Worn items aren't within reach for crafting, so only the weapon and the
+//  inventory tell g
+item player::i_rem(char let, game *g)
 {
  item tmp;
+ bool crafting = (g != NULL && this == &g->u);
  if (weapon.invlet == let) {
   if (weapon.type->id > num_items && weapon.type->id < num_all_items)
    return ret_null;
   tmp = weapon;
   weapon = ret_null;
+  if (crafting)
+   g->crafting_view_adjust(tmp, -1);
   return tmp;
  }
  for (int i = 0; i < worn.size(); i++) {
@@ -3589,8 +3599,12 @@ item player::i_rem(char let)
    return tmp;
   }
  }
- if (inv.index_by_letter(let) != -1)
-  return inv.remove_item_by_letter(let);
+ if (inv.index_by_letter(let) != -1) {
+  tmp = inv.remove_item_by_letter(let);
+  if (crafting)
+   g->crafting_view_adjust(tmp, -1);
+  return tmp;
+ }
  return ret_null;
 }
 
@@ -3637,18 +3651,13 @@ item& player::i_of_type(itype_id type)
  return ret_null;
 }
 
-std::vector<item> player::inv_dump()
+void player::inv_dump(std::vector<item> &ret)
 {
- std::vector<item> ret;
+ ret.reserve(ret.size() + 1 + worn.size() + inv.num_items());
  if (weapon.type->id != 0 && weapon.type->id < num_items)
   ret.push_back(weapon);
- for (int i = 0; i < worn.size(); i++)
-  ret.push_back(worn[i]);
- for(int i = 0; i < inv.size(); i++) {
-  for (int j = 0; j < inv.stack_at(i).size(); j++)
-   ret.push_back(inv.stack_at(i)[j]);
- }
- return ret;
+ ret.insert(ret.end(), worn.begin(), worn.end());
+ inv.as_vector(ret);
 }
 
 item player::i_remn(int index)
@@ -3880,12 +3889,12 @@ bool player::has_watertight_container()
    if (cont->flags & mfb(con_wtight) && cont->flags & mfb(con_seals))
     return true;
   }
- }
- if (weapon.is_container() && weapon.contents.empty()) {
+ }
+ if (weapon.is_container() && weapon.contents.empty()) {
    it_container* cont = dynamic_cast<it_container*>(weapon.type);
    if (cont->flags & mfb(con_wtight) && cont->flags & mfb(con_seals))
-    return true;
- }
+    return true;
+ }
 
  return false;
 }
@@ -3915,7 +3924,7 @@ bool player::has_matching_liquid(int it)
       return true;
     }
   }
- }
+ }
  if (weapon.is_container() && !weapon.contents.empty()) {
   if (weapon.contents[0].type->id == it) { // liquid matches
     it_container* container = dynamic_cast<it_container*>(weapon.type);
@@ -3937,7 +3946,7 @@ bool player::has_matching_liquid(int it)
   if (weapon.contents[0].charges < holding_container_charges)
     return true;
   }
-}
+}
 
  return false;
 }
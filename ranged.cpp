@@ -17,7 +17,19 @@ double calculate_missed_by(player &p, int trange, item* weapon);
 void shoot_monster(game *g, player &p, monster &mon, int &dam, double goodhit, item* weapon);
 void shoot_player(game *g, player &p, player *h, int &dam, double goodhit);
 
-void splatter(game *g, std::vector<point> trajectory, int dam,
+// What a burst leaves behind.  Every shot is resolved first; the blood they
+//  spill and the squares they fly through are only applied once it is over.
+struct burst_effects
+{
+ std::vector<point> blood; // Squares to spatter, in order
+ std::vector<field_id> blood_type;
+ std::vector< std::vector<point> > paths; // Each shot's flight, to animate
+ char bullet;
+
+ void finish(game *g, player &p);
+};
+
+void splatter(burst_effects &fx, const point &from, const point &to, int dam,
               monster* mon = NULL);
 
 void ammo_effects(game *g, int x, int y, long flags);
@@ -85,7 +97,6 @@ void game::fire(player &p, int tarx, int tary, std::vector<point> &trajectory,
  if (curammo->type == AT_BOLT || curammo->type == AT_ARROW)
   is_bolt = true;
 
- int x = p.posx, y = p.posy;
  // Have to use the gun, gunmods don't have a type
  it_gun* firing = dynamic_cast<it_gun*>(p.weapon.type);
  if (p.has_trait(PF_TRIGGERHAPPY) && one_in(30))
@@ -107,10 +118,16 @@ void game::fire(player &p, int tarx, int tary, std::vector<point> &trajectory,
  if (num_shots == 0)
   debugmsg("game::fire() - num_shots = 0!");
 
-// Set up a timespec for use in the nanosleep function below
- timespec ts;
- ts.tv_sec = 0;
- ts.tv_nsec = BULLET_SPEED;
+// The trajectory is only recomputed when the burst changes targets, and hits
+//  are looked up in one index of everyone near the line of fire
+ burst_effects fx;
+ fx.bullet = (effects & mfb(AMMO_FLAME) ? '#' : '*');
+ const bool animate = animations_enabled();
+ int reach = rl_dist(p.posx, p.posy, tarx, tary) + 12;
+ if (reach > SEEX * 4)
+  reach = SEEX * 4;
+ const creature_area area(this, p.posx, p.posy, reach);
+ bool made_sound = false;
 
  // Use up some ammunition
  int trange = trig_dist(p.posx, p.posy, tarx, tary);
@@ -131,26 +148,26 @@ void game::fire(player &p, int tarx, int tary, std::vector<point> &trajectory,
  for (int curshot = 0; curshot < num_shots; curshot++) {
 // Burst-fire weapons allow us to pick a new target after killing the first
   if (curshot > 0 &&
-      (mon_at(tarx, tary) == -1 || z[mon_at(tarx, tary)].hp <= 0)) {
+      (area.mon_at(this, tarx, tary) == -1 || z[area.mon_at(this, tarx, tary)].hp <= 0)) {
    std::vector<point> new_targets;
    int mondex;
    for (int radius = 1; radius <= 2 + p.skillLevel("gun") && new_targets.empty();
         radius++) {
     for (int diff = 0 - radius; diff <= radius; diff++) {
-     mondex = mon_at(tarx + diff, tary - radius);
+     mondex = area.mon_at(this, tarx + diff, tary - radius);
      if (mondex != -1 && z[mondex].hp > 0 && z[mondex].friendly == 0)
       new_targets.push_back( point(tarx + diff, tary - radius) );
 
-     mondex = mon_at(tarx + diff, tary + radius);
+     mondex = area.mon_at(this, tarx + diff, tary + radius);
      if (mondex != -1 && z[mondex].hp > 0 && z[mondex].friendly == 0)
       new_targets.push_back( point(tarx + diff, tary + radius) );
 
      if (diff != 0 - radius && diff != radius) { // Corners were already checked
-      mondex = mon_at(tarx - radius, tary + diff);
+      mondex = area.mon_at(this, tarx - radius, tary + diff);
       if (mondex != -1 && z[mondex].hp > 0 && z[mondex].friendly == 0)
        new_targets.push_back( point(tarx - radius, tary + diff) );
 
-      mondex = mon_at(tarx + radius, tary + diff);
+      mondex = area.mon_at(this, tarx + radius, tary + diff);
       if (mondex != -1 && z[mondex].hp > 0 && z[mondex].friendly == 0)
        new_targets.push_back( point(tarx + radius, tary + diff) );
      }
@@ -161,12 +178,14 @@ void game::fire(player &p, int tarx, int tary, std::vector<point> &trajectory,
     tarx = new_targets[target_picked].x;
     tary = new_targets[target_picked].y;
     if (m.sees(p.posx, p.posy, tarx, tary, 0, tart))
-     trajectory = line_to(p.posx, p.posy, tarx, tary, tart);
+     line_to(p.posx, p.posy, tarx, tary, tart, trajectory);
     else
-     trajectory = line_to(p.posx, p.posy, tarx, tary, 0);
+     line_to(p.posx, p.posy, tarx, tary, 0, trajectory);
    } else if ((!p.has_trait(PF_TRIGGERHAPPY) || one_in(3)) &&
-              (p.skillLevel("gun") >= 7 || one_in(7 - p.skillLevel("gun"))))
+              (p.skillLevel("gun") >= 7 || one_in(7 - p.skillLevel("gun")))) {
+    fx.finish(this, p);
     return; // No targets, so return
+   }
   }
 
   // Drop a shell casing if appropriate.
@@ -217,15 +236,20 @@ void game::fire(player &p, int tarx, int tary, std::vector<point> &trajectory,
   // Misfire chance is between 1/64 and 1/1024.
   if (one_in(2 << firing->durability)) {
    add_msg("Your weapon misfired!");
+   fx.finish(this, p);
    return;
   }
 
-  make_gun_sound_effect(this, p, burst, weapon);
+// One report for the whole burst
+  if (!made_sound) {
+   make_gun_sound_effect(this, p, burst, weapon);
+   made_sound = true;
+  }
   int trange = calculate_range(p, tarx, tary);
   double missed_by = calculate_missed_by(p, trange, weapon);
 // Calculate a penalty based on the monster's speed
   double monster_speed_penalty = 1.;
-  int target_index = mon_at(tarx, tary);
+  int target_index = area.mon_at(this, tarx, tary);
   if (target_index != -1) {
    monster_speed_penalty = double(z[target_index].speed) / 80.;
    if (monster_speed_penalty < 1.)
@@ -244,10 +268,7 @@ void game::fire(player &p, int tarx, int tary, std::vector<point> &trajectory,
 // Shoot a random nearby space?
    tarx += rng(0 - int(sqrt(double(missed_by))), int(sqrt(double(missed_by))));
    tary += rng(0 - int(sqrt(double(missed_by))), int(sqrt(double(missed_by))));
-   if (m.sees(p.posx, p.posy, x, y, -1, tart))
-    trajectory = line_to(p.posx, p.posy, tarx, tary, tart);
-   else
-    trajectory = line_to(p.posx, p.posy, tarx, tary, 0);
+   line_to(p.posx, p.posy, tarx, tary, 0, trajectory);
    missed = true;
    if (!burst) {
     if (&p == &u)
@@ -267,22 +288,12 @@ void game::fire(player &p, int tarx, int tary, std::vector<point> &trajectory,
   }
 
   int dam = weapon->gun_damage();
+  if (animate)
+   fx.paths.push_back(std::vector<point>());
   for (int i = 0; i < trajectory.size() &&
        (dam > 0 || (effects & AMMO_FLAME)); i++) {
-   if (i > 0)
-    m.drawsq(w_terrain, u, trajectory[i-1].x, trajectory[i-1].y, false, true);
-// Drawing the bullet uses player u, and not player p, because it's drawn
-// relative to YOUR position, which may not be the gunman's position.
-   if (u_see(trajectory[i].x, trajectory[i].y, junk)) {
-    char bullet = '*';
-    if (effects & mfb(AMMO_FLAME))
-     bullet = '#';
-    mvwputch(w_terrain, trajectory[i].y + VIEWY - u.posy,
-                        trajectory[i].x + VIEWX - u.posx, c_red, bullet);
-    wrefresh(w_terrain);
-    if (&p == &u)
-     nanosleep(&ts, NULL);
-   }
+   if (animate)
+    fx.paths.back().push_back(trajectory[i]);
 
    if (dam <= 0) { // Ran out of momentum.
     ammo_effects(this, trajectory[i].x, trajectory[i].y, effects);
@@ -292,13 +303,14 @@ void game::fire(player &p, int tarx, int tary, std::vector<point> &trajectory,
      m.add_item(trajectory[i].x, trajectory[i].y, ammotmp);
     if (weapon->num_charges() == 0)
      weapon->curammo = NULL;
+    fx.finish(this, p);
     return;
    }
 
    int tx = trajectory[i].x, ty = trajectory[i].y;
 // If there's a monster in the path of our bullet, and either our aim was true,
 //  OR it's not the monster we were aiming at and we were lucky enough to hit it
-   int mondex = mon_at(tx, ty);
+   int mondex = area.mon_at(this, tx, ty);
 // If we shot us a monster...
    if (mondex != -1 && (!z[mondex].has_flag(MF_DIGS) ||
        rl_dist(p.posx, p.posy, z[mondex].posx, z[mondex].posy) <= 1) &&
@@ -307,31 +319,27 @@ void game::fire(player &p, int tarx, int tary, std::vector<point> &trajectory,
 
     double goodhit = missed_by;
     if (i < trajectory.size() - 1) // Unintentional hit
-     goodhit = double(rand() / (RAND_MAX + 1.0)) / 2;
+     goodhit = double(rng(0, 499)) / 1000;
 
 // Penalize for the monster's speed
     if (z[mondex].speed > 80)
      goodhit *= double( double(z[mondex].speed) / 80.);
 
-    std::vector<point> blood_traj = trajectory;
-    blood_traj.insert(blood_traj.begin(), point(p.posx, p.posy));
-    splatter(this, blood_traj, dam, &z[mondex]);
+    splatter(fx, point(p.posx, p.posy), trajectory.back(), dam, &z[mondex]);
     shoot_monster(this, p, z[mondex], dam, goodhit, weapon);
 
    } else if ((!missed || one_in(3)) &&
-              (npc_at(tx, ty) != -1 || (u.posx == tx && u.posy == ty)))  {
+              (area.npc_at(this, tx, ty) != -1 || (u.posx == tx && u.posy == ty)))  {
     double goodhit = missed_by;
     if (i < trajectory.size() - 1) // Unintentional hit
-     goodhit = double(rand() / (RAND_MAX + 1.0)) / 2;
+     goodhit = double(rng(0, 499)) / 1000;
     player *h;
     if (u.posx == tx && u.posy == ty)
      h = &u;
     else
-     h = &(active_npc[npc_at(tx, ty)]);
+     h = &(active_npc[area.npc_at(this, tx, ty)]);
 
-    std::vector<point> blood_traj = trajectory;
-    blood_traj.insert(blood_traj.begin(), point(p.posx, p.posy));
-    splatter(this, blood_traj, dam);
+    splatter(fx, point(p.posx, p.posy), trajectory.back(), dam);
     shoot_player(this, p, h, dam, goodhit);
 
    } else
@@ -352,6 +360,7 @@ void game::fire(player &p, int tarx, int tary, std::vector<point> &trajectory,
     m.add_item(lastx, lasty, ammotmp);
  }
 
+ fx.finish(this, p);
  if (weapon->num_charges() == 0)
   weapon->curammo = NULL;
 }
@@ -401,9 +410,9 @@ void game::throw_item(player &p, int tarx, int tary, item &thrown,
   tarx += rng(0 - int(sqrt(double(missed_by))), int(sqrt(double(missed_by))));
   tary += rng(0 - int(sqrt(double(missed_by))), int(sqrt(double(missed_by))));
   if (m.sees(p.posx, p.posy, tarx, tary, -1, tart))
-   trajectory = line_to(p.posx, p.posy, tarx, tary, tart);
+   line_to(p.posx, p.posy, tarx, tary, tart, trajectory);
   else
-   trajectory = line_to(p.posx, p.posy, tarx, tary, 0);
+   line_to(p.posx, p.posy, tarx, tary, 0, trajectory);
   missed = true;
   if (!p.is_npc())
    add_msg("You miss!");
@@ -453,7 +462,7 @@ void game::throw_item(player &p, int tarx, int tary, item &thrown,
    } else
     m.add_item(tx, ty, thrown);
    if (i < trajectory.size() - 1)
-    goodhit = double(double(rand() / RAND_MAX) / 2);
+    goodhit = double(rng(0, 499)) / 1000;
    if (goodhit < .1 && !z[mon_at(tx, ty)].has_flag(MF_NOHEAD)) {
     message = "Headshot!";
     dam = rng(dam, dam * 3);
@@ -602,7 +611,7 @@ std::vector<point> game::target(int &x, int &y, int lowx, int lowy, int hix,
     mvwputch(w_terrain, aty, atx, u.color(), '@');
 
    if (m.sees(u.posx, u.posy, x, y, -1, tart)) {// Selects a valid line-of-sight
-    ret = line_to(u.posx, u.posy, x, y, tart); // Sets the vector to that LOS
+    line_to(u.posx, u.posy, x, y, tart, ret); // Sets the vector to that LOS
 // Draw the trajectory
     for (int i = 0; i < ret.size(); i++) {
      if (abs(ret[i].x - u.posx) <= sight_dist &&
@@ -998,7 +1007,22 @@ void shoot_player(game *g, player &p, player *h, int &dam, double goodhit)
  }
 }
 
-void splatter(game *g, std::vector<point> trajectory, int dam, monster* mon)
+// Used in splatter(); queues each square walk_line() visits for blood
+struct blood_spurt
+{
+ burst_effects &fx;
+ field_id blood;
+ blood_spurt(burst_effects &FX, field_id B) : fx (FX), blood (B) {}
+ bool operator()(int x, int y)
+ {
+  fx.blood.push_back(point(x, y));
+  fx.blood_type.push_back(blood);
+  return true;
+ }
+};
+
+void splatter(burst_effects &fx, const point &from, const point &to, int dam,
+              monster* mon)
 {
  field_id blood = fd_blood;
  if (mon != NULL) {
@@ -1016,16 +1040,45 @@ void splatter(game *g, std::vector<point> trajectory, int dam, monster* mon)
  else if (dam > 20)
   distance = 2;
 
- std::vector<point> spurt = continue_line(trajectory, distance);
+// The same squares continue_line() would give, without building the line
+ point end = continue_line_end(from, to, distance);
+ blood_spurt spurt(fx, blood);
+ walk_line(to.x, to.y, end.x, end.y, 0, spurt);
+}
+
+void burst_effects::finish(game *g, player &p)
+{
+ timespec ts;
+ ts.tv_sec = 0;
+ ts.tv_nsec = BULLET_SPEED;
+ int junk;
+ for (int s = 0; s < paths.size(); s++) {
+  for (int i = 0; i < paths[s].size(); i++) {
+   const point &pos = paths[s][i];
+   if (i > 0)
+    g->m.drawsq(g->w_terrain, g->u, paths[s][i-1].x, paths[s][i-1].y, false, true);
+// Drawing the bullet uses player u, and not player p, because it's drawn
+// relative to YOUR position, which may not be the gunman's position.
+   if (g->u_see(pos.x, pos.y, junk)) {
+    mvwputch(g->w_terrain, pos.y + VIEWY - g->u.posy, pos.x + VIEWX - g->u.posx,
+             c_red, bullet);
+    wrefresh(g->w_terrain);
+    if (&p == &g->u)
+     nanosleep(&ts, NULL);
+   }
+  }
+ }
+ paths.clear();
 
- for (int i = 0; i < spurt.size(); i++) {
-  int tarx = spurt[i].x, tary = spurt[i].y;
-  if (g->m.field_at(tarx, tary).type == blood &&
-      g->m.field_at(tarx, tary).density < 3)
-   g->m.field_at(tarx, tary).density++;
+ for (int i = 0; i < blood.size(); i++) {
+  field &fd = g->m.field_at(blood[i].x, blood[i].y);
+  if (fd.type == blood_type[i] && fd.density < 3)
+   fd.density++;
   else
-   g->m.add_field(g, tarx, tary, blood, 1);
+   g->m.add_field(g, blood[i].x, blood[i].y, blood_type[i], 1);
  }
+ blood.clear();
+ blood_type.clear();
 }
 
 void ammo_effects(game *g, int x, int y, long effects)
@@ -1,25 +1,85 @@
 #include "output.h"
 #include "rng.h"
 
-long rng(long low, long high)
+static uint32_t world_seed = 0;
+// Plain pointers, so they can be thread-local even without C++11
+static __thread rng_stream *current_stream = NULL;
+static __thread rng_stream *default_stream = NULL;
+static int num_default_streams = 0;
+
+// splitmix32, used to spread seeds over the whole state
+static uint32_t mix_seed(uint32_t &x)
 {
- return low + long((high - low + 1) * double(rand() / double(RAND_MAX + 1.0)));
+ uint32_t z = (x += 0x9E3779B9);
+ z = (z ^ (z >> 16)) * 0x85EBCA6B;
+ z = (z ^ (z >> 13)) * 0xC2B2AE35;
+ return z ^ (z >> 16);
 }
 
-bool one_in(int chance)
+static inline uint32_t rotl(const uint32_t x, int k)
+{
+ return (x << k) | (x >> (32 - k));
+}
+
+rng_stream::rng_stream()
+{
+ seed(0);
+}
+
+rng_stream::rng_stream(uint32_t seed_value)
+{
+ seed(seed_value);
+}
+
+void rng_stream::seed(uint32_t seed_value)
+{
+ uint32_t x = seed_value;
+ for (int i = 0; i < 4; i++)
+  s[i] = mix_seed(x);
+}
+
+void rng_stream::seed(uint32_t seed_value, int a, int b, int c, int d, int e)
+{
+ uint32_t x = seed_value;
+ const int extra[5] = { a, b, c, d, e };
+ for (int i = 0; i < 5; i++)
+  x = mix_seed(x) ^ uint32_t(extra[i]);
+ seed(x);
+}
+
+uint32_t rng_stream::next()
+{
+ const uint32_t result = rotl(s[1] * 5, 7) * 9;
+ const uint32_t t = s[1] << 9;
+ s[2] ^= s[0];
+ s[3] ^= s[1];
+ s[1] ^= s[2];
+ s[0] ^= s[3];
+ s[2] ^= t;
+ s[3] = rotl(s[3], 11);
+ return result;
+}
+
+long rng_stream::rng(long low, long high)
+{
+ return low + long((high - low + 1) * (next() * (1.0 / 4294967296.0)));
+}
+
+bool rng_stream::one_in(int chance)
 {
  if (chance <= 1 || rng(0, chance - 1) == 0)
   return true;
  return false;
 }
-bool x_in_y(double x, double y)
+
+bool rng_stream::x_in_y(double x, double y)
 {
- if( ((double)rand() / RAND_MAX) <= ((double)x/y) )
+ if( (next() * (1.0 / 4294967295.0)) <= ((double)x/y) )
   return true;
  return false;
 }
 
-int dice(int number, int sides)
+int rng_stream::dice(int number, int sides)
 {
  int ret = 0;
  for (int i = 0; i < number; i++)
@@ -27,6 +87,69 @@ int dice(int number, int sides)
  return ret;
 }
 
+rng_stream_scope::rng_stream_scope(rng_stream &stream)
+{
+ previous = current_stream;
+ current_stream = &stream;
+}
+
+rng_stream_scope::~rng_stream_scope()
+{
+ current_stream = previous;
+}
+
+rng_stream& rng_current_stream()
+{
+ return (current_stream ? *current_stream : rng_default_stream());
+}
+
+// Made the first time a thread asks, and kept for the life of the process.
+// The first thread, normally the main one, is seeded from the world seed
+//  alone; the rest also mix in the order they asked in.
+rng_stream& rng_default_stream()
+{
+ if (default_stream == NULL) {
+  const int index = __sync_fetch_and_add(&num_default_streams, 1);
+  default_stream = new rng_stream;
+  if (index == 0)
+   default_stream->seed(world_seed);
+  else
+   default_stream->seed(world_seed, index);
+ }
+ return *default_stream;
+}
+
+void rng_set_world_seed(uint32_t seed)
+{
+ world_seed = seed;
+ rng_default_stream().seed(seed);
+}
+
+uint32_t rng_world_seed()
+{
+ return world_seed;
+}
+
+long rng(long low, long high)
+{
+ return rng_current_stream().rng(low, high);
+}
+
+bool one_in(int chance)
+{
+ return rng_current_stream().one_in(chance);
+}
+
+bool x_in_y(double x, double y)
+{
+ return rng_current_stream().x_in_y(x, y);
+}
+
+int dice(int number, int sides)
+{
+ return rng_current_stream().dice(number, sides);
+}
+
 
 // http://www.cse.yorku.ca/~oz/hash.html
 // for world seeding.
@@ -39,4 +162,3 @@ int djb2_hash(unsigned char *str){
  }
  return hash;
 }
-
@@ -1,6 +1,54 @@
 #ifndef _RNG_H_
 #define _RNG_H_
 #include <stdlib.h>
+#include <stdint.h>
+
+/*
+ * A small, fast random number stream (xoshiro128**).  Each subsystem that
+ * wants reproducible or independent randomness owns one; mapgen seeds one per
+ * submap from the world seed and the submap's coordinates.
+ *
+ * The free functions below (rng(), one_in(), ...) draw from the calling
+ * thread's current stream.  That is the thread's own default stream unless an
+ * rng_stream_scope has installed another one.
+ */
+class rng_stream
+{
+ public:
+  rng_stream();
+  explicit rng_stream(uint32_t seed);
+
+  void seed(uint32_t seed);
+// Seeds from several values at once, e.g. world seed + coordinates
+  void seed(uint32_t seed, int a, int b = 0, int c = 0, int d = 0, int e = 0);
+
+  uint32_t next();
+  long rng(long low, long high);
+  bool one_in(int chance);
+  bool x_in_y(double x, double y);
+  int dice(int number, int sides);
+
+ private:
+  uint32_t s[4];
+};
+
+// Routes the free functions on this thread to a stream for its lifetime
+class rng_stream_scope
+{
+ public:
+  explicit rng_stream_scope(rng_stream &stream);
+  ~rng_stream_scope();
+
+ private:
+  rng_stream *previous;
+};
+
+rng_stream& rng_current_stream();
+rng_stream& rng_default_stream();
+
+void rng_set_world_seed(uint32_t seed); // Also reseeds this thread's default stream
+uint32_t rng_world_seed();
+
 long rng(long low, long high);
 bool one_in(int chance);
 bool x_in_y(double x, double y);
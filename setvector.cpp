@@ -88,13 +88,13 @@ void setvector(std::vector<pl_flag> &vec, ... )
  va_end(ap);
 }
 
-void setvector(std::vector<m_flag> &vec, ... )
+void setvector(std::bitset<MF_MAX> &bits, ... )
 {
  va_list ap;
- va_start(ap, vec);
+ va_start(ap, bits);
  m_flag tmp;
  while ((tmp = (m_flag)va_arg(ap, int)))
-  vec.push_back(tmp);
+  bits.set(tmp);
  va_end(ap);
 }
 
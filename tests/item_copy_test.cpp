@@ -0,0 +1,205 @@
+/* libtap doesn't extern C their headers, so we do it for them. */
+extern "C" {
+ #include "tap.h"
+}
+
+#include "game.h"
+#include "inventory.h"
+#include "item.h"
+#include "itype.h"
+#include "mapbuffer.h"
+#include <time.h>
+#include <vector>
+
+#define KINDS 40
+#define PER_KIND 5
+#define IDLE_TURNS 100
+
+// inventory::const_stack() as it was, returning a copy of the stack
+std::vector<item> old_const_stack(const inventory &inv, int i)
+{
+ return inv.const_stack(i);
+}
+
+// item::stacks_with() as it was, taking the other item by value
+bool old_stacks_with(item &lhs, item rhs)
+{
+ return lhs.stacks_with(rhs);
+}
+
+// A backpack's worth of kinds, each a few deep, each holding a few things, so
+//  that copying one means copying its contents and strings too.  kinds must
+//  already be KINDS long, so the items' pointers into it stay put.
+void fill_pack(std::vector<itype> &kinds, std::vector<item> &pack)
+{
+ for (int k = 0; k < KINDS; k++) {
+  itype *kind = &kinds[k];
+  kind->id = k + 1;
+  for (int n = 0; n < PER_KIND; n++) {
+   item it(kind, 0);
+   it.name = "an item with a name long enough to live on the heap";
+   for (int c = 0; c < 3; c++)
+    it.contents.push_back(item(kind, 0));
+   pack.push_back(it);
+  }
+ }
+}
+
+// A flat, empty world around the player, put straight into the mapbuffer so
+//  map::load() finds it there instead of generating anything
+void build_world(game *g)
+{
+ g->m = map(&g->itypes, &g->mapitems, &g->traps);
+ g->weather = WEATHER_CLEAR;
+ g->levx = 0;
+ g->levy = 0;
+ g->levz = 0;
+ const int omx = g->cur_om.pos().x * OMAPX * 2,
+           omy = g->cur_om.pos().y * OMAPY * 2;
+ for (int gx = 0; gx < MAPSIZE; gx++) {
+  for (int gy = 0; gy < MAPSIZE; gy++) {
+   submap *sm = new submap;
+   for (int x = 0; x < SEEX; x++) {
+    for (int y = 0; y < SEEY; y++) {
+     sm->ter[x][y] = t_dirt;
+     sm->trp[x][y] = tr_null;
+    }
+   }
+   MAPBUFFER.add_submap(omx + gx, omy + gy, 0, sm);
+  }
+ }
+ g->m.load(g, 0, 0, 0);
+ g->u.posx = SEEX * int(MAPSIZE / 2) + 5;
+ g->u.posy = SEEY * int(MAPSIZE / 2) + 5;
+}
+
+item make_item(game *g, itype_id type)
+{
+ return item(g->itypes[type], 0);
+}
+
+// Things to carry and things lying around, some in containers and one lit
+//  flashlight on the ground and one in the pack, so there are active items
+void stock_world(game *g)
+{
+ item bottle = make_item(g, itm_bottle_plastic);
+ bottle.contents.push_back(make_item(g, itm_water_clean));
+ item backpack = make_item(g, itm_backpack);
+ backpack.contents.push_back(make_item(g, itm_rock));
+ item light = make_item(g, itm_flashlight_on);
+ light.active = true;
+ light.charges = 100;
+
+ g->u.weapon = make_item(g, itm_2x4);
+ g->u.i_add(bottle);
+ g->u.i_add(backpack);
+ g->u.i_add(make_item(g, itm_9mm));
+ g->u.i_add(light);
+ for (int i = 0; i < 5; i++) {
+  const int x = g->u.posx - 2 + i, y = g->u.posy + 1;
+  g->m.add_item(x, y, bottle);
+  g->m.add_item(x, y, backpack);
+  g->m.add_item(x, y, make_item(g, itm_rock));
+ }
+ g->m.add_item(g->u.posx + 3, g->u.posy, light);
+}
+
+// What do_turn() and draw() do with items on a turn where the player waits
+void idle_turn(game *g)
+{
+ g->turn.increment();
+ g->u.process_active_items(g);
+ g->m.process_active_items(g);
+ g->m.process_fields(g);
+ g->lm.generate(g, g->u.posx, g->u.posy, g->natural_light_level(),
+                g->u.active_light());
+}
+
+double seconds_since(clock_t start)
+{
+ return double(clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char *argv[])
+{
+ plan_tests(6);
+
+ std::vector<itype> kinds(KINDS);
+ std::vector<item> pack;
+ fill_pack(kinds, pack);
+
+ inventory inv;
+ for (int i = 0; i < pack.size(); i++)
+  inv.add_item(pack[i]);
+ bool stacked = (inv.size() == KINDS);
+ for (int i = 0; stacked && i < inv.size(); i++)
+  stacked = (inv.const_stack(i).size() == PER_KIND);
+ ok(stacked, "add_item stacks the same kinds together");
+
+ ok(&inv.const_stack(0) == &inv.const_stack(0),
+    "const_stack hands out the stack itself, not a copy");
+
+ std::vector<item> flat(1);
+ inv.as_vector(flat);
+ ok(flat.size() == 1 + KINDS * PER_KIND, "as_vector appends every item");
+
+ int stacking = 0, old_stacking = 0;
+ for (int i = 0; i < pack.size(); i++) {
+  stacking += pack[0].stacks_with(pack[i]);
+  old_stacking += old_stacks_with(pack[0], pack[i]);
+ }
+ ok(stacking == PER_KIND && stacking == old_stacking,
+    "stacks_with gives the same answer without the copy");
+
+ game *g = new game;
+ g->u.name = "item_copy_test";
+ MAPBUFFER.set_game(g);
+ build_world(g);
+ stock_world(g);
+ idle_turn(g); // Let anything that happens once settle first
+ item_copy_counter::copies = 0;
+ item copy = pack[0];
+ ok(item_copy_counter::copies == 4, "copying an item counts it and its contents");
+ item_copy_counter::copies = 0;
+ for (int i = 0; i < IDLE_TURNS; i++)
+  idle_turn(g);
+ diag("%d item copies in %d idle turns", item_copy_counter::copies,
+      IDLE_TURNS);
+ ok(item_copy_counter::copies == 0, "idle turns copy no items");
+
+// Every NPC and the player look through their stacks many times a turn
+ const int rounds = 2000;
+ int seen = 0;
+ clock_t start = clock();
+ for (int r = 0; r < rounds; r++) {
+  for (int i = 0; i < inv.size(); i++)
+   seen += old_const_stack(inv, i).size();
+ }
+ diag("const_stack by value: %.3f s for %d looks", seconds_since(start),
+      seen);
+ seen = 0;
+ start = clock();
+ for (int r = 0; r < rounds; r++) {
+  for (int i = 0; i < inv.size(); i++)
+   seen += inv.const_stack(i).size();
+ }
+ diag("const_stack by reference: %.3f s for %d looks", seconds_since(start),
+      seen);
+
+ start = clock();
+ for (int r = 0; r < rounds; r++) {
+  for (int i = 0; i < pack.size(); i++)
+   seen += old_stacks_with(pack[0], pack[i]);
+ }
+ diag("stacks_with by value: %.3f s for %d checks", seconds_since(start),
+      rounds * int(pack.size()));
+ start = clock();
+ for (int r = 0; r < rounds; r++) {
+  for (int i = 0; i < pack.size(); i++)
+   seen += pack[0].stacks_with(pack[i]);
+ }
+ diag("stacks_with by reference: %.3f s for %d checks", seconds_since(start),
+      rounds * int(pack.size()));
+
+ return exit_status();
+}
@@ -4,12 +4,280 @@ extern "C" {
 }
 
 #include "line.h"
+#include <stdlib.h>
+#include <time.h>
+
+#define SGN(a) (((a)<0) ? -1 : 1)
+
+#define GRID 40
+
+// line_to() as it was before it was built on walk_line()
+std::vector <point> old_line_to(int x1, int y1, int x2, int y2, int t)
+{
+ std::vector<point> ret;
+ int dx = x2 - x1;
+ int dy = y2 - y1;
+ int ax = abs(dx)<<1;
+ int ay = abs(dy)<<1;
+ int sx = SGN(dx);
+ int sy = SGN(dy);
+ if (dy == 0) sy = 0;
+ if (dx == 0) sx = 0;
+ point cur;
+ cur.x = x1;
+ cur.y = y1;
+
+ int xmin = (x1 < x2 ? x1 : x2), ymin = (y1 < y2 ? y1 : y2),
+     xmax = (x1 > x2 ? x1 : x2), ymax = (y1 > y2 ? y1 : y2);
+
+ xmin -= abs(dx);
+ ymin -= abs(dy);
+ xmax += abs(dx);
+ ymax += abs(dy);
+
+ if (ax == ay) {
+  do {
+   cur.y += sy;
+   cur.x += sx;
+   ret.push_back(cur);
+  } while ((cur.x != x2 || cur.y != y2) &&
+           (cur.x >= xmin && cur.x <= xmax && cur.y >= ymin && cur.y <= ymax));
+ } else if (ax > ay) {
+  do {
+   if (t > 0) {
+    cur.y += sy;
+    t -= ax;
+   }
+   cur.x += sx;
+   t += ay;
+   ret.push_back(cur);
+  } while ((cur.x != x2 || cur.y != y2) &&
+           (cur.x >= xmin && cur.x <= xmax && cur.y >= ymin && cur.y <= ymax));
+ } else {
+  do {
+   if (t > 0) {
+    cur.x += sx;
+    t -= ay;
+   }
+   cur.y += sy;
+   t += ax;
+   ret.push_back(cur);
+  } while ((cur.x != x2 || cur.y != y2) &&
+           (cur.x >= xmin && cur.x <= xmax && cur.y >= ymin && cur.y <= ymax));
+ }
+ return ret;
+}
+
+// A random grid of walls; everything off the grid is a wall too
+struct grid_clear {
+ bool open[GRID][GRID];
+ bool operator()(int x, int y)
+ {
+  return x >= 0 && x < GRID && y >= 0 && y < GRID && open[x][y];
+ }
+};
+
+// map::sees() as it was, trying every tc in turn
+bool old_sees(int Fx, int Fy, int Tx, int Ty, grid_clear &clear, int &tc)
+{
+ const int dx = Tx - Fx;
+ const int dy = Ty - Fy;
+ const int ax = abs(dx) << 1;
+ const int ay = abs(dy) << 1;
+ const int sx = SGN(dx);
+ const int sy = SGN(dy);
+ int x, y, t, st;
+ if (ax > ay) {
+  st = SGN(ay - (ax >> 1));
+  for (tc = abs(ay - (ax >> 1)) * 2 + 1; tc >= -1; tc--) {
+   t = tc * st;
+   x = Fx;
+   y = Fy;
+   do {
+    if (t > 0) {
+     y += sy;
+     t -= ax;
+    }
+    x += sx;
+    t += ay;
+    if (x == Tx && y == Ty) {
+     tc *= st;
+     return true;
+    }
+   } while (clear(x, y));
+  }
+ } else {
+  st = SGN(ax - (ay >> 1));
+  for (tc = abs(ax - (ay >> 1)) * 2 + 1; tc >= -1; tc--) {
+   t = tc * st;
+   x = Fx;
+   y = Fy;
+   do {
+    if (t > 0) {
+     x += sx;
+     t -= ay;
+    }
+    y += sy;
+    t += ax;
+    if (x == Tx && y == Ty) {
+     tc *= st;
+     return true;
+    }
+   } while (clear(x, y));
+  }
+ }
+ return false;
+}
+
+// Counts the points walk_line() visits, giving up after limit of them
+struct point_counter {
+ int count, limit;
+ bool operator()(int x, int y)
+ {
+  return ++count < limit;
+ }
+};
+
+void fill_grid(grid_clear &grid, int walls_percent)
+{
+ for (int x = 0; x < GRID; x++) {
+  for (int y = 0; y < GRID; y++)
+   grid.open[x][y] = (rand() % 100 >= walls_percent);
+ }
+}
+
+double seconds_since(clock_t start)
+{
+ return double(clock() - start) / CLOCKS_PER_SEC;
+}
 
 int main(int argc, char *argv[])
 {
- plan_tests(1);
+ plan_tests(8);
 
  ok1(trig_dist(0, 0, 0, 0) == 0);
 
+// line_to() returns the same points the old implementation did
+ int line_mismatches = 0;
+ for (int x = -6; x <= 6; x++) {
+  for (int y = -6; y <= 6; y++) {
+   for (int t = -8; t <= 8; t++) {
+    std::vector<point> a = line_to(0, 0, x, y, t), b = old_line_to(0, 0, x, y, t);
+    bool same = (a.size() == b.size());
+    for (int i = 0; same && i < a.size(); i++)
+     same = (a[i].x == b[i].x && a[i].y == b[i].y);
+    if (!same)
+     line_mismatches++;
+   }
+  }
+ }
+ ok(line_mismatches == 0, "line_to matches the old implementation");
+
+// Refilling a kept vector gives the same points, whatever it held before
+ int refill_mismatches = 0;
+ std::vector<point> kept;
+ for (int x = -6; x <= 6; x++) {
+  for (int y = -6; y <= 6; y++) {
+   line_to(0, 0, x, y, 1, kept);
+   std::vector<point> fresh = line_to(0, 0, x, y, 1);
+   bool same = (kept.size() == fresh.size());
+   for (int i = 0; same && i < kept.size(); i++)
+    same = (kept[i].x == fresh[i].x && kept[i].y == fresh[i].y);
+   if (!same)
+    refill_mismatches++;
+  }
+ }
+ ok(refill_mismatches == 0, "line_to refills a kept vector with the same line");
+
+// continue_line_end() gives the end of the line continue_line() builds
+ int continue_mismatches = 0;
+ for (int x = -6; x <= 6; x++) {
+  for (int y = -6; y <= 6; y++) {
+   if (x == 0 && y == 0)
+    continue;
+   std::vector<point> line(2);
+   line[0] = point(0, 0);
+   line[1] = point(x, y);
+   std::vector<point> cont = continue_line(line, 3);
+   point end = continue_line_end(line[0], line[1], 3);
+   std::vector<point> walked = line_to(x, y, end.x, end.y, 0);
+   if (cont.size() != walked.size() || cont.back().x != end.x ||
+       cont.back().y != end.y)
+    continue_mismatches++;
+  }
+ }
+ ok(continue_mismatches == 0, "continue_line ends at continue_line_end");
+
+// walk_line() stops as soon as the visitor says so
+ point_counter counter;
+ counter.count = 0;
+ counter.limit = 3;
+ ok(!walk_line(0, 0, 10, 4, 0, counter) && counter.count == 3,
+    "walk_line stops early");
+ counter.count = 0;
+ counter.limit = 100;
+ ok(walk_line(0, 0, 10, 4, 0, counter) && counter.count == 10,
+    "walk_line visits every point");
+
+// find_clear_line() picks the same line, or none, that sees() always has
+ srand(1234);
+ grid_clear grid;
+ int sees_mismatches = 0;
+ for (int round = 0; round < 200; round++) {
+  fill_grid(grid, round % 50);
+  const int Fx = rand() % GRID, Fy = rand() % GRID;
+  for (int Tx = 0; Tx < GRID; Tx++) {
+   for (int Ty = 0; Ty < GRID; Ty++) {
+    int tc_old = 0, tc_new = 0;
+    const bool seen_old = old_sees(Fx, Fy, Tx, Ty, grid, tc_old);
+    const bool seen_new = find_clear_line(Fx, Fy, Tx, Ty, grid, tc_new);
+    if (seen_old != seen_new || (seen_old && tc_old != tc_new))
+     sees_mismatches++;
+   }
+  }
+ }
+ ok(sees_mismatches == 0, "find_clear_line matches the old sees");
+
+// Failed sight checks through a wall; the old loop tries every tc
+ for (int x = 0; x < GRID; x++) {
+  for (int y = 0; y < GRID; y++)
+   grid.open[x][y] = (x != GRID / 2);
+ }
+ int tc, seen_old = 0, seen_new = 0;
+ clock_t start = clock();
+ for (int i = 0; i < 2000; i++) {
+  for (int y = 0; y < GRID; y++)
+   seen_old += old_sees(0, GRID / 3, GRID - 1, y, grid, tc);
+ }
+ const double old_time = seconds_since(start);
+ start = clock();
+ for (int i = 0; i < 2000; i++) {
+  for (int y = 0; y < GRID; y++)
+   seen_new += find_clear_line(0, GRID / 3, GRID - 1, y, grid, tc);
+ }
+ const double new_time = seconds_since(start);
+ diag("blocked sight checks: old %.3f s, new %.3f s", old_time, new_time);
+ ok(seen_old == 0 && seen_new == 0, "blocked lines are never seen");
+
+// Building vectors against walking in place
+ start = clock();
+ int points = 0;
+ for (int i = 0; i < 20000; i++) {
+  for (int y = -20; y <= 20; y++)
+   points += old_line_to(0, 0, 60, y, 0).size();
+ }
+ diag("old_line_to: %.3f s for %d points", seconds_since(start), points);
+ start = clock();
+ points = 0;
+ for (int i = 0; i < 20000; i++) {
+  for (int y = -20; y <= 20; y++) {
+   counter.count = 0;
+   counter.limit = 1000;
+   walk_line(0, 0, 60, y, 0, counter);
+   points += counter.count;
+  }
+ }
+ diag("walk_line: %.3f s for %d points", seconds_since(start), points);
+
  return exit_status();
 }
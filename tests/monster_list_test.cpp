@@ -0,0 +1,141 @@
+/* libtap doesn't extern C their headers, so we do it for them. */
+extern "C" {
+ #include "tap.h"
+}
+
+#include "monster.h"
+#include <stdlib.h>
+#include <time.h>
+#include <vector>
+
+#define HORDE 500
+
+// A horde standing in a line, so posx tells us which monster we have
+void fill_horde(monster_list &horde)
+{
+ horde.clear();
+ horde.reserve(HORDE);
+ for (int i = 0; i < HORDE; i++) {
+  monster zed;
+  zed.posx = i;
+  horde.push_back(zed);
+ }
+}
+
+// The order the horde goes down in, the same for every run
+void shuffled_order(std::vector<int> &order)
+{
+ order.clear();
+ for (int i = 0; i < HORDE; i++)
+  order.push_back(i);
+ for (int i = HORDE - 1; i > 0; i--) {
+  const int j = rand() % (i + 1);
+  const int tmp = order[i];
+  order[i] = order[j];
+  order[j] = tmp;
+ }
+}
+
+double seconds_since(clock_t start)
+{
+ return double(clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char *argv[])
+{
+ plan_tests(7);
+
+ srand(1234);
+ monster_list horde;
+ fill_horde(horde);
+ std::vector<int> handles;
+ for (int i = 0; i < horde.size(); i++)
+  handles.push_back(horde.handle_at(i));
+ ok1(horde.handle_at(-1) == -1 && horde.handle_at(HORDE) == -1);
+
+// Gun the horde down in a random order, looking each one up by its handle
+//  the way last_target is, and check everyone still standing after each kill
+ std::vector<int> order;
+ shuffled_order(order);
+ int lost = 0, revived = 0;
+ for (int k = 0; k < HORDE; k++) {
+  const int target = order[k];
+  const int i = horde.index_of(handles[target]);
+  if (i == -1 || horde[i].posx != target) {
+   lost++;
+   continue;
+  }
+  horde.remove(i);
+  if (horde.index_of(handles[target]) != -1)
+   revived++;
+  if (k % 50 == 0) {
+   for (int n = k + 1; n < HORDE; n++) {
+    const int j = horde.index_of(handles[order[n]]);
+    if (j == -1 || horde[j].posx != order[n])
+     lost++;
+   }
+  }
+ }
+ ok(lost == 0, "every handle finds its monster until it is removed");
+ ok(revived == 0, "a removed monster's handle stays dead");
+ ok1(horde.empty());
+
+// Refilling reuses the slots, but never the old handles
+ fill_horde(horde);
+ int reused = 0;
+ for (int i = 0; i < HORDE; i++) {
+  if (horde.index_of(handles[i]) != -1)
+   reused++;
+ }
+ ok(reused == 0, "old handles don't name new monsters");
+ ok1(horde.index_of(horde.handle_at(HORDE - 1)) == HORDE - 1);
+
+// One monster killed and replaced more times than a generation can count
+ monster_list lone;
+ monster zed;
+ lone.push_back(zed);
+ const int first = lone.handle_at(0);
+ int repeats = 0;
+ for (int k = 0; k < 70000; k++) {
+  lone.remove(0);
+  lone.push_back(zed);
+  if (lone.handle_at(0) == first || lone.index_of(first) != -1)
+   repeats++;
+ }
+ ok(repeats == 0, "a handle never comes back, however often its slot is reused");
+
+// The same massacre against a plain vector, where every erase shifts the
+//  rest down and the target has to be searched for
+ const int rounds = 200;
+ clock_t start = clock();
+ for (int r = 0; r < rounds; r++) {
+  std::vector<monster> old_horde;
+  old_horde.reserve(HORDE);
+  for (int i = 0; i < HORDE; i++) {
+   monster zed;
+   zed.posx = i;
+   old_horde.push_back(zed);
+  }
+  for (int k = 0; k < HORDE; k++) {
+   for (int i = 0; i < old_horde.size(); i++) {
+    if (old_horde[i].posx == order[k]) {
+     old_horde.erase(old_horde.begin() + i);
+     break;
+    }
+   }
+  }
+ }
+ diag("vector erase: %.3f s for %d hordes of %d", seconds_since(start), rounds, HORDE);
+ start = clock();
+ for (int r = 0; r < rounds; r++) {
+  fill_horde(horde);
+  handles.clear();
+  for (int i = 0; i < horde.size(); i++)
+   handles.push_back(horde.handle_at(i));
+  for (int k = 0; k < HORDE; k++)
+   horde.remove(horde.index_of(handles[order[k]]));
+ }
+ diag("monster_list remove: %.3f s for %d hordes of %d", seconds_since(start), rounds, HORDE);
+
+ return exit_status();
+}
@@ -0,0 +1,196 @@
+/* Offline world pre-generation for cataclysm
+ * Generates the overmaps and every submap in a rectangle of the world, saves
+ * them the same way the game does, and exits.  Run it from the game's
+ * directory so data/ and save/ are where the game expects them.
+ * Linux only; it uses pthreads.
+ */
+
+#include "game.h"
+#include "map.h"
+#include "mapbuffer.h"
+#include "options.h"
+#include "rng.h"
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <vector>
+
+// How many jobs are set up, generated and saved at once
+#define PREGEN_BATCH 256
+
+struct pregen_job
+{
+ overmap *om;
+ mapgen_context ctx;
+ tinymap *m;
+
+ pregen_job(game *g, overmap *om, int x, int y, int z) :
+  om(om), ctx(g, om, x, y, z, int(g->turn)),
+  m(new tinymap(&g->itypes, &g->mapitems, &g->traps)) {};
+};
+
+struct pregen_batch
+{
+ std::vector<pregen_job*> jobs;
+ int next;
+ pthread_mutex_t lock;
+};
+
+static void usage()
+{
+ printf("Usage: cataclysm-pregen [options] x1 y1 x2 y2\n"
+"Generates every submap from (x1, y1) to (x2, y2), in absolute submap\n"
+"coordinates, and saves it to save/.  The game's starting overmap covers\n"
+"0 to %d on both axes.\n"
+"  --seed <string>   World seed; pass the game the same --seed\n"
+"  --name <name>     Character name used for the overmap save files\n"
+"  --z <z1> <z2>     Z-levels to generate (default 0 0, range %d to %d)\n"
+"  --threads <n>     Worker threads (default: one per core)\n",
+        OMAPX * 2 - 1, -OVERMAP_DEPTH, OVERMAP_HEIGHT);
+}
+
+// Overmaps are 2 * OMAP submaps wide; round towards negative infinity
+static int om_index(int submap, int size)
+{
+ return (submap >= 0 ? submap / size : (submap + 1) / size - 1);
+}
+
+static double seconds_now()
+{
+ timeval tv;
+ gettimeofday(&tv, NULL);
+ return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static void *pregen_worker(void *arg)
+{
+ pregen_batch *batch = static_cast<pregen_batch*>(arg);
+ while (true) {
+  pthread_mutex_lock(&batch->lock);
+  int i = batch->next++;
+  pthread_mutex_unlock(&batch->lock);
+  if (i >= batch->jobs.size())
+   return NULL;
+  batch->jobs[i]->m->generate(batch->jobs[i]->ctx);
+ }
+}
+
+// Generates the jobs on num_threads workers, then saves them here, since the
+//  mapbuffer and new artifacts belong to the main thread.
+static void run_batch(game *g, std::vector<pregen_job*> &jobs, int num_threads)
+{
+ pregen_batch batch;
+ batch.jobs = jobs;
+ batch.next = 0;
+ pthread_mutex_init(&batch.lock, NULL);
+
+ std::vector<pthread_t> threads(num_threads);
+ for (int i = 0; i < num_threads; i++)
+  pthread_create(&threads[i], NULL, pregen_worker, &batch);
+ for (int i = 0; i < num_threads; i++)
+  pthread_join(threads[i], NULL);
+ pthread_mutex_destroy(&batch.lock);
+
+ for (int i = 0; i < jobs.size(); i++) {
+  jobs[i]->m->finish_generate(g, jobs[i]->om, jobs[i]->ctx);
+  delete jobs[i]->m;
+  delete jobs[i];
+ }
+ jobs.clear();
+}
+
+int main(int argc, char *argv[])
+{
+ int seed = time(NULL);
+ std::string name = "pregen";
+ int z1 = 0, z2 = 0;
+ int num_threads = sysconf(_SC_NPROCESSORS_ONLN);
+ std::vector<int> coords;
+
+ for (int i = 1; i < argc; i++) {
+  std::string arg = argv[i];
+  if (arg == "--seed" && i + 1 < argc)
+   seed = djb2_hash((unsigned char*)argv[++i]);
+  else if (arg == "--name" && i + 1 < argc)
+   name = argv[++i];
+  else if (arg == "--z" && i + 2 < argc) {
+   z1 = atoi(argv[++i]);
+   z2 = atoi(argv[++i]);
+  } else if (arg == "--threads" && i + 1 < argc)
+   num_threads = atoi(argv[++i]);
+  else if (arg.size() > 0 && (arg[0] != '-' || (arg.size() > 1 && isdigit(arg[1]))))
+   coords.push_back(atoi(argv[i]));
+  else {
+   usage();
+   return 1;
+  }
+ }
+ if (coords.size() != 4 || z1 > z2 || z1 < -OVERMAP_DEPTH || z2 > OVERMAP_HEIGHT) {
+  usage();
+  return 1;
+ }
+ if (num_threads < 1)
+  num_threads = 1;
+// Generation works on whole overmap squares, which are two submaps wide
+ int x1 = std::min(coords[0], coords[2]), x2 = std::max(coords[0], coords[2]);
+ int y1 = std::min(coords[1], coords[3]), y2 = std::max(coords[1], coords[3]);
+ x1 -= (x1 % 2 + 2) % 2;
+ y1 -= (y1 % 2 + 2) % 2;
+
+ load_options();
+ std::srand(seed);
+ rng_set_world_seed(seed);
+ mkdir("save", 0777);
+
+ game *g = new game;
+ g->u.name = name;
+ MAPBUFFER.set_game(g);
+ MAPBUFFER.load();
+
+ printf("Generating submaps (%d, %d) to (%d, %d), z %d to %d, on %d threads\n",
+        x1, y1, x2, y2, z1, z2, num_threads);
+ const double start = seconds_now();
+ int generated = 0, skipped = 0;
+ std::vector<pregen_job*> jobs;
+
+ const int omw = OMAPX * 2, omh = OMAPY * 2;
+ for (int omy = om_index(y1, omh); omy <= om_index(y2, omh); omy++) {
+  for (int omx = om_index(x1, omw); omx <= om_index(x2, omw); omx++) {
+   overmap om(g, omx, omy);
+   const int sx1 = std::max(x1, omx * omw), sx2 = std::min(x2, omx * omw + omw - 1);
+   const int sy1 = std::max(y1, omy * omh), sy2 = std::min(y2, omy * omh + omh - 1);
+   for (int z = z1; z <= z2; z++) {
+    for (int y = sy1; y <= sy2; y += 2) {
+     for (int x = sx1; x <= sx2; x += 2) {
+      if (MAPBUFFER.lookup_submap(x, y, z) != NULL) {
+       skipped++;
+       continue;
+      }
+      jobs.push_back(new pregen_job(g, &om, x - omx * omw, y - omy * omh, z));
+      generated += 4;
+      if (jobs.size() >= PREGEN_BATCH)
+       run_batch(g, jobs, num_threads);
+     }
+    }
+   }
+// Jobs hold a pointer to om, so finish them before it goes away
+   run_batch(g, jobs, num_threads);
+   printf("Overmap (%d, %d) done, %d submaps so far\n", omx, omy, generated);
+  }
+ }
+ const double elapsed = seconds_now() - start;
+
+ g->save_artifacts();
+ MAPBUFFER.save();
+
+ printf("Generated %d submaps (%d squares already existed) in %.2f s, %.1f submaps/sec\n",
+        generated, skipped, elapsed, (elapsed > 0 ? generated / elapsed : 0.0));
+ return 0;
+}
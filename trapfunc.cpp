@@ -530,7 +530,7 @@ void trapfunc::pit_spikes(game *g, int x, int y)
   g->u.hit(g, hit, side, 0, damage);
   if (one_in(4)) {
    g->add_msg("The spears break!");
-   g->m.ter(x, y) = t_pit;
+   g->m.ter_set(x, y, t_pit);
    g->m.tr_at(x, y) = tr_pit;
    for (int i = 0; i < 4; i++) { // 4 spears to a pit
     if (one_in(3))
@@ -555,7 +555,7 @@ void trapfuncm::pit_spikes(game *g, monster *z, int x, int y)
  if (one_in(4)) {
   if (sees)
    g->add_msg("The spears break!");
-  g->m.ter(x, y) = t_pit;
+  g->m.ter_set(x, y, t_pit);
   g->m.tr_at(x, y) = tr_pit;
   for (int i = 0; i < 4; i++) { // 4 spears to a pit
    if (one_in(3))
@@ -689,23 +689,23 @@ void trapfunc::temple_toggle(game *g, int x, int y)
    switch (type) {
     case t_floor_red:
      if (g->m.ter(i, j) == t_rock_green)
-      g->m.ter(i, j) = t_floor_green;
+      g->m.ter_set(i, j, t_floor_green);
      else if (g->m.ter(i, j) == t_floor_green)
-      g->m.ter(i, j) = t_rock_green;
+      g->m.ter_set(i, j, t_rock_green);
      break;
 
     case t_floor_green:
      if (g->m.ter(i, j) == t_rock_blue)
-      g->m.ter(i, j) = t_floor_blue;
+      g->m.ter_set(i, j, t_floor_blue);
      else if (g->m.ter(i, j) == t_floor_blue)
-      g->m.ter(i, j) = t_rock_blue;
+      g->m.ter_set(i, j, t_rock_blue);
      break;
 
     case t_floor_blue:
      if (g->m.ter(i, j) == t_rock_red)
-      g->m.ter(i, j) = t_floor_red;
+      g->m.ter_set(i, j, t_floor_red);
      else if (g->m.ter(i, j) == t_floor_red)
-      g->m.ter(i, j) = t_rock_red;
+      g->m.ter_set(i, j, t_rock_red);
      break;
 
    }
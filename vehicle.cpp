@@ -1546,7 +1546,7 @@ void vehicle::handle_trap (int x, int y, int part)
         g->explosion(x, y, expl, shrap, false);
 }
 
-bool vehicle::add_item (int part, item itm)
+bool vehicle::add_item (int part, const item &itm)
 {
     if (!part_flag(part, vpf_cargo) || parts[part].items.size() >= 26)
         return false;
@@ -319,7 +319,7 @@ public:
     void handle_trap (int x, int y, int part);
 
 // add item to part's cargo. if false, then there's no cargo at this part or cargo is full
-    bool add_item (int part, item itm);
+    bool add_item (int part, const item &itm);
 
 // remove item from part's cargo
     void remove_item (int part, int itemdex);
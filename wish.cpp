@@ -159,6 +159,7 @@ void game::wish()
  mvprintw(0, 0, "\nWish granted - %d (%d).", tmp.type->id, itm_antibiotics);
  tmp.invlet = nextinv;
  u.i_add(tmp);
+ invalidate_crafting_view();
  advance_nextinv();
  getch();
  delwin(w_info);